@@ -0,0 +1,330 @@
+#include "async-logger.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+static int64_t now()
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+static const char* getLevelName(uint8_t level)
+{
+	switch (level)
+	{
+	case LogLevel_Debug:
+		return "debug";
+	case LogLevel_Warning:
+		return "warning";
+	case LogLevel_Error:
+		return "error";
+	default:
+		return "info";
+	}
+}
+
+/// returns the largest length not greater than max which does not split a UTF-8 sequence
+static size_t truncateUtf8(const char* text, size_t max)
+{
+	size_t length = max;
+	while (length > 0 && (static_cast<uint8_t>(text[length]) & 0xC0) == 0x80)
+	{
+		length--;
+	}
+	return length;
+}
+
+AsyncLogger::AsyncLogger(size_t capacity)
+{
+	size_t size = 2;
+	while (size < capacity)
+	{
+		size <<= 1;
+	}
+
+	cells_ = std::make_unique<Cell[]>(size);
+	mask_ = size - 1;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		cells_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+AsyncLogger::~AsyncLogger()
+{
+	stop();
+}
+
+bool AsyncLogger::start(ICore* core, StringView path, size_t max_file_size, uint32_t max_files)
+{
+	if (isRunning())
+	{
+		return false;
+	}
+
+	core_ = core;
+	path_ = path.to_string();
+	maxFileSize_ = max_file_size;
+	maxFiles_ = max_files;
+
+	if (!path_.empty() && !openFile())
+	{
+		return false;
+	}
+
+	running_.store(true, std::memory_order_release);
+	worker_ = std::thread(&AsyncLogger::run, this);
+	return true;
+}
+
+void AsyncLogger::stop()
+{
+	if (!worker_.joinable())
+	{
+		return;
+	}
+
+	running_.store(false, std::memory_order_release);
+	worker_.join();
+
+	if (file_ != nullptr)
+	{
+		fclose(file_);
+		file_ = nullptr;
+	}
+}
+
+bool AsyncLogger::isRunning() const
+{
+	return running_.load(std::memory_order_acquire);
+}
+
+bool AsyncLogger::log(LogLevel level, StringView text)
+{
+	if (!isEnabled(level))
+	{
+		filtered_.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	Cell* cell;
+	size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+
+	for (;;)
+	{
+		cell = &cells_[pos & mask_];
+		const size_t seq = cell->sequence.load(std::memory_order_acquire);
+		const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+		if (diff == 0)
+		{
+			if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			// the logging thread has not yet written this cell; the ring is full
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			pos = enqueuePos_.load(std::memory_order_relaxed);
+		}
+	}
+
+	size_t length = text.size();
+	if (length > MAX_RECORD_SIZE)
+	{
+		length = truncateUtf8(text.data(), MAX_RECORD_SIZE);
+		truncated_.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	memcpy(cell->text, text.data(), length);
+	cell->length = static_cast<uint16_t>(length);
+	cell->level = static_cast<uint8_t>(level);
+	cell->time = now();
+	cell->sequence.store(pos + 1, std::memory_order_release);
+
+	return true;
+}
+
+bool AsyncLogger::isEnabled(LogLevel level) const
+{
+	return level >= minLevel_.load(std::memory_order_relaxed);
+}
+
+void AsyncLogger::setMinLevel(LogLevel level)
+{
+	minLevel_.store(level, std::memory_order_relaxed);
+}
+
+LogLevel AsyncLogger::getMinLevel() const
+{
+	return static_cast<LogLevel>(minLevel_.load(std::memory_order_relaxed));
+}
+
+size_t AsyncLogger::depth() const
+{
+	return enqueuePos_.load(std::memory_order_relaxed) - written_.load(std::memory_order_relaxed);
+}
+
+size_t AsyncLogger::capacity() const
+{
+	return mask_ + 1;
+}
+
+void AsyncLogger::getStats(AsyncLoggerStats& stats) const
+{
+	stats.accepted = enqueuePos_.load(std::memory_order_relaxed);
+	stats.filtered = filtered_.load(std::memory_order_relaxed);
+	stats.dropped = dropped_.load(std::memory_order_relaxed);
+	stats.truncated = truncated_.load(std::memory_order_relaxed);
+	stats.written = written_.load(std::memory_order_relaxed);
+	stats.depth = depth();
+	stats.peakDepth = peakDepth_.load(std::memory_order_relaxed);
+	stats.rotations = rotations_.load(std::memory_order_relaxed);
+}
+
+void AsyncLogger::resetStats()
+{
+	filtered_.store(0, std::memory_order_relaxed);
+	dropped_.store(0, std::memory_order_relaxed);
+	truncated_.store(0, std::memory_order_relaxed);
+	peakDepth_.store(0, std::memory_order_relaxed);
+	rotations_.store(0, std::memory_order_relaxed);
+}
+
+void AsyncLogger::run()
+{
+	while (running_.load(std::memory_order_acquire))
+	{
+		if (drain() == 0)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+	}
+
+	// records logged before the stop are written before the thread exits
+	drain();
+}
+
+size_t AsyncLogger::drain()
+{
+	const size_t end = enqueuePos_.load(std::memory_order_acquire);
+
+	const uint64_t depth = end - dequeuePos_;
+	if (depth > peakDepth_.load(std::memory_order_relaxed))
+	{
+		peakDepth_.store(depth, std::memory_order_relaxed);
+	}
+
+	size_t count = 0;
+	while (dequeuePos_ != end)
+	{
+		Cell& cell = cells_[dequeuePos_ & mask_];
+		const size_t seq = cell.sequence.load(std::memory_order_acquire);
+
+		if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeuePos_ + 1) < 0)
+		{
+			// a producer claimed this cell but has not yet published its record
+			break;
+		}
+
+		write(cell);
+
+		cell.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+		dequeuePos_++;
+		count++;
+	}
+
+	if (count != 0)
+	{
+		written_.fetch_add(count, std::memory_order_relaxed);
+		if (file_ != nullptr)
+		{
+			fflush(file_);
+		}
+	}
+
+	return count;
+}
+
+void AsyncLogger::write(const Cell& cell)
+{
+	if (file_ == nullptr)
+	{
+		if (core_ != nullptr)
+		{
+			core_->logLnU8(static_cast<LogLevel>(cell.level), "%.*s", static_cast<int>(cell.length), cell.text);
+		}
+		return;
+	}
+
+	const std::time_t seconds = static_cast<std::time_t>(cell.time / 1000);
+	std::tm time;
+#ifdef WIN32
+	localtime_s(&time, &seconds);
+#else
+	localtime_r(&seconds, &time);
+#endif
+
+	char prefix[64];
+	const size_t length = strftime(prefix, sizeof(prefix), "[%Y-%m-%d %H:%M:%S", &time);
+	const int written = fprintf(file_, "%.*s.%03d] [%s] %.*s\n", static_cast<int>(length), prefix, static_cast<int>(cell.time % 1000),
+		getLevelName(cell.level), static_cast<int>(cell.length), cell.text);
+
+	if (written > 0)
+	{
+		fileSize_ += static_cast<size_t>(written);
+	}
+
+	if (maxFileSize_ != 0 && fileSize_ >= maxFileSize_)
+	{
+		rotate();
+	}
+}
+
+bool AsyncLogger::openFile()
+{
+	file_ = fopen(path_.c_str(), "ab");
+	if (file_ == nullptr)
+	{
+		return false;
+	}
+
+	fseek(file_, 0, SEEK_END);
+	const long size = ftell(file_);
+	fileSize_ = size > 0 ? static_cast<size_t>(size) : 0;
+	return true;
+}
+
+void AsyncLogger::rotate()
+{
+	fclose(file_);
+	file_ = nullptr;
+
+	// path.n-1 -> path.n, ..., path -> path.1; the oldest file is removed. without older files the log is truncated
+	if (maxFiles_ == 0)
+	{
+		remove(path_.c_str());
+	}
+	else
+	{
+		remove((path_ + "." + std::to_string(maxFiles_)).c_str());
+		for (uint32_t i = maxFiles_ - 1; i > 0; i--)
+		{
+			rename((path_ + "." + std::to_string(i)).c_str(), (path_ + "." + std::to_string(i + 1)).c_str());
+		}
+		rename(path_.c_str(), (path_ + ".1").c_str());
+	}
+
+	rotations_.fetch_add(1, std::memory_order_relaxed);
+
+	// records are written to the server log if the file cannot be reopened
+	openFile();
+}
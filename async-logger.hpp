@@ -0,0 +1,122 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace Impl;
+
+/// statistics of the async logger. layout is shared with the managed AsyncLoggerStats struct
+struct AsyncLoggerStats
+{
+	/// records accepted into the ring
+	uint64_t accepted;
+	/// records below the minimum level
+	uint64_t filtered;
+	/// records rejected because the ring was full
+	uint64_t dropped;
+	/// records cut off at the maximum record size
+	uint64_t truncated;
+	/// records written to the sink
+	uint64_t written;
+	uint64_t depth;
+	uint64_t peakDepth;
+	uint64_t rotations;
+};
+
+/// logging sink for preformatted UTF-8 records. any thread may log a record; records are copied into a bounded lock-free
+/// multi-producer single-consumer ring and written by a background thread to the server log or to a set of rotated
+/// files. records below the minimum level are rejected before they are copied and records which do not fit in the ring
+/// are dropped, so logging never blocks the caller.
+class AsyncLogger final
+{
+public:
+	/// maximum number of bytes of a record; longer records are truncated
+	static constexpr size_t MAX_RECORD_SIZE = 480;
+
+private:
+	struct alignas(64) Cell
+	{
+		std::atomic<size_t> sequence;
+		int64_t time;
+		uint16_t length;
+		uint8_t level;
+		char text[MAX_RECORD_SIZE];
+	};
+
+	std::unique_ptr<Cell[]> cells_;
+	size_t mask_ = 0;
+
+	alignas(64) std::atomic<size_t> enqueuePos_ { 0 };
+	alignas(64) size_t dequeuePos_ = 0;
+
+	std::atomic<int> minLevel_ { LogLevel_Message };
+	std::atomic<uint64_t> filtered_ { 0 };
+	std::atomic<uint64_t> dropped_ { 0 };
+	std::atomic<uint64_t> truncated_ { 0 };
+	std::atomic<uint64_t> written_ { 0 };
+	std::atomic<uint64_t> peakDepth_ { 0 };
+	std::atomic<uint64_t> rotations_ { 0 };
+
+	ICore* core_ = nullptr;
+	std::string path_;
+	size_t maxFileSize_ = 0;
+	uint32_t maxFiles_ = 0;
+	FILE* file_ = nullptr;
+	size_t fileSize_ = 0;
+
+	std::thread worker_;
+	std::atomic<bool> running_ { false };
+
+	void run();
+
+	/// writes the published records to the sink. returns the number of written records
+	size_t drain();
+
+	void write(const Cell& cell);
+
+	bool openFile();
+
+	void rotate();
+
+public:
+	/// capacity is the number of records and is rounded up to the next power of two
+	explicit AsyncLogger(size_t capacity);
+
+	AsyncLogger(const AsyncLogger&) = delete;
+	AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+	~AsyncLogger();
+
+	/// starts the background thread. records are written to the server log if path is empty, otherwise to the file at
+	/// path, which is rotated to path.1 through path.max_files when it exceeds max_file_size bytes. returns false if the
+	/// logger is running or the file cannot be opened
+	bool start(ICore* core, StringView path, size_t max_file_size, uint32_t max_files);
+
+	/// stops the background thread after writing the remaining records
+	void stop();
+
+	bool isRunning() const;
+
+	/// copies the record into the ring; safe to call from any thread. returns false if the record is filtered or dropped
+	bool log(LogLevel level, StringView text);
+
+	bool isEnabled(LogLevel level) const;
+
+	void setMinLevel(LogLevel level);
+
+	LogLevel getMinLevel() const;
+
+	size_t depth() const;
+
+	size_t capacity() const;
+
+	void getStats(AsyncLoggerStats& stats) const;
+
+	void resetStats();
+};
@@ -0,0 +1,476 @@
+#include "ban-index.hpp"
+
+#include <chrono>
+
+static char toLower(char c)
+{
+	return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+static std::string lowercase(StringView text)
+{
+	std::string result(text.data(), text.size());
+	for (char& c : result)
+	{
+		c = toLower(c);
+	}
+	return result;
+}
+
+static int hexValue(char c)
+{
+	if (c >= '0' && c <= '9')
+	{
+		return c - '0';
+	}
+	c = toLower(c);
+	if (c >= 'a' && c <= 'f')
+	{
+		return c - 'a' + 10;
+	}
+	return -1;
+}
+
+static bool getBit(const BanIndex::Address& address, uint32_t bit)
+{
+	return bit < 64 ? (address.high >> (63 - bit)) & 1 : (address.low >> (127 - bit)) & 1;
+}
+
+/// clears the bits following the prefix so every address of a range has the same key
+static BanIndex::Address mask(const BanIndex::Address& address, uint32_t prefix)
+{
+	BanIndex::Address result = address;
+	if (prefix < 64)
+	{
+		result.high = prefix == 0 ? 0 : result.high & (~0ull << (64 - prefix));
+		result.low = 0;
+	}
+	else if (prefix < 128)
+	{
+		result.low = prefix == 64 ? 0 : result.low & (~0ull << (128 - prefix));
+	}
+	return result;
+}
+
+static bool parseIPv4(StringView text, BanIndex::Address& address, uint32_t& prefix)
+{
+	uint32_t value = 0;
+	uint32_t octets = 0;
+	uint32_t bits = 32;
+	size_t i = 0;
+
+	while (octets < 4)
+	{
+		if (i < text.size() && text[i] == '*')
+		{
+			// wildcards are only allowed at the end: 1.2.*.* or 1.2.*
+			if (bits == 32)
+			{
+				bits = octets * 8;
+			}
+			i++;
+		}
+		else
+		{
+			if (bits != 32)
+			{
+				return false;
+			}
+
+			uint32_t octet = 0;
+			const size_t start = i;
+			while (i < text.size() && text[i] >= '0' && text[i] <= '9' && i - start < 3)
+			{
+				octet = octet * 10 + (text[i] - '0');
+				i++;
+			}
+			if (i == start || octet > 255)
+			{
+				return false;
+			}
+			value |= octet << (24 - octets * 8);
+		}
+
+		octets++;
+		if (i == text.size() || text[i] != '.')
+		{
+			break;
+		}
+		i++;
+	}
+
+	if (i != text.size() || (octets != 4 && bits == 32))
+	{
+		return false;
+	}
+
+	address.high = 0;
+	address.low = 0x0000FFFF00000000ull | value;
+	prefix = 96 + bits;
+	return true;
+}
+
+static bool parseIPv6(StringView text, BanIndex::Address& address)
+{
+	uint16_t groups[8] = {};
+	int count = 0;
+	int gap = -1;
+	size_t i = 0;
+
+	if (text.size() >= 2 && text[0] == ':' && text[1] == ':')
+	{
+		gap = 0;
+		i = 2;
+	}
+
+	while (i < text.size())
+	{
+		if (count == 8)
+		{
+			return false;
+		}
+
+		uint32_t group = 0;
+		const size_t start = i;
+		int digit;
+		while (i < text.size() && i - start < 4 && (digit = hexValue(text[i])) >= 0)
+		{
+			group = (group << 4) | static_cast<uint32_t>(digit);
+			i++;
+		}
+		if (i == start)
+		{
+			return false;
+		}
+		groups[count++] = static_cast<uint16_t>(group);
+
+		if (i == text.size())
+		{
+			break;
+		}
+		if (text[i] != ':')
+		{
+			return false;
+		}
+		i++;
+
+		if (i < text.size() && text[i] == ':')
+		{
+			if (gap >= 0)
+			{
+				return false;
+			}
+			gap = count;
+			i++;
+		}
+		else if (i == text.size())
+		{
+			return false;
+		}
+	}
+
+	if (gap < 0 ? count != 8 : count == 8)
+	{
+		return false;
+	}
+
+	// the groups following the gap are moved to the end
+	uint16_t expanded[8] = {};
+	const int tail = gap < 0 ? 0 : count - gap;
+	for (int k = 0; k < count - tail; k++)
+	{
+		expanded[k] = groups[k];
+	}
+	for (int k = 0; k < tail; k++)
+	{
+		expanded[8 - tail + k] = groups[gap + k];
+	}
+
+	address.high = 0;
+	address.low = 0;
+	for (int k = 0; k < 4; k++)
+	{
+		address.high = (address.high << 16) | expanded[k];
+		address.low = (address.low << 16) | expanded[k + 4];
+	}
+	return true;
+}
+
+bool BanIndex::parse(StringView text, Address& address, uint32_t& prefix)
+{
+	size_t length = text.size();
+	uint32_t bits = 0;
+	bool ranged = false;
+
+	for (size_t i = 0; i < text.size(); i++)
+	{
+		if (text[i] == '/')
+		{
+			length = i;
+			ranged = true;
+			if (i + 1 == text.size() || text.size() - i > 4)
+			{
+				return false;
+			}
+			for (size_t k = i + 1; k < text.size(); k++)
+			{
+				if (text[k] < '0' || text[k] > '9')
+				{
+					return false;
+				}
+				bits = bits * 10 + (text[k] - '0');
+			}
+			break;
+		}
+	}
+
+	const StringView host(text.data(), length);
+	const bool ipv6 = host.find(':') != StringView::npos;
+
+	if (ipv6)
+	{
+		if (!parseIPv6(host, address) || (ranged && bits > 128))
+		{
+			return false;
+		}
+		prefix = ranged ? bits : 128;
+	}
+	else
+	{
+		if (!parseIPv4(host, address, prefix))
+		{
+			return false;
+		}
+		if (ranged)
+		{
+			if (prefix != 128 || bits > 32)
+			{
+				return false;
+			}
+			prefix = 96 + bits;
+		}
+	}
+
+	address = mask(address, prefix);
+	return true;
+}
+
+BanIndex::BanIndex()
+	: nodes_(1)
+{
+}
+
+void BanIndex::attach(ICore* core)
+{
+	core_ = core;
+	rebuild();
+}
+
+void BanIndex::detach()
+{
+	core_ = nullptr;
+}
+
+void BanIndex::insertRange(const Address& address, uint32_t prefix, int32_t ban)
+{
+	uint32_t node = 0;
+	for (uint32_t bit = 0; bit < prefix; bit++)
+	{
+		const bool side = getBit(address, bit);
+		if (nodes_[node].children[side] == NO_NODE)
+		{
+			nodes_[node].children[side] = static_cast<uint32_t>(nodes_.size());
+			nodes_.emplace_back();
+		}
+		node = nodes_[node].children[side];
+	}
+
+	// the first ban of a range is reported
+	if (nodes_[node].ban < 0)
+	{
+		nodes_[node].ban = ban;
+		stats_.ranges++;
+	}
+}
+
+int32_t BanIndex::findRange(const Address& address) const
+{
+	int32_t found = nodes_[0].ban;
+	uint32_t node = 0;
+	for (uint32_t bit = 0; bit < 128; bit++)
+	{
+		node = nodes_[node].children[getBit(address, bit)];
+		if (node == NO_NODE)
+		{
+			break;
+		}
+		if (nodes_[node].ban >= 0)
+		{
+			found = nodes_[node].ban;
+		}
+	}
+	return found;
+}
+
+void BanIndex::index(const BanEntry& ban, int32_t id)
+{
+	// the name of an address ban only records who was banned; like IConfig::isBanned, only bans without an address
+	// ban a name
+	if (ban.address.length() == 0)
+	{
+		if (ban.name.length() != 0)
+		{
+			names_.emplace(lowercase(StringView(ban.name.data(), ban.name.length())), id);
+		}
+		return;
+	}
+
+	Address address;
+	uint32_t prefix;
+	if (!parse(StringView(ban.address.data(), ban.address.length()), address, prefix))
+	{
+		stats_.invalid++;
+	}
+	else if (prefix == 128)
+	{
+		addresses_.emplace(address, id);
+	}
+	else
+	{
+		insertRange(address, prefix, id);
+	}
+}
+
+void BanIndex::rebuild()
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	addresses_.clear();
+	names_.clear();
+	nodes_.assign(1, TrieNode());
+	stats_.ranges = 0;
+	stats_.invalid = 0;
+	indexed_ = 0;
+
+	if (core_ != nullptr)
+	{
+		IConfig& config = core_->getConfig();
+		indexed_ = config.getBansCount();
+		addresses_.reserve(indexed_);
+		for (size_t i = 0; i < indexed_; i++)
+		{
+			index(config.getBan(i), static_cast<int32_t>(i));
+		}
+	}
+
+	stats_.rebuilds++;
+	stats_.rebuildNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void BanIndex::added()
+{
+	if (core_ == nullptr)
+	{
+		return;
+	}
+
+	IConfig& config = core_->getConfig();
+	const size_t count = config.getBansCount();
+	if (count < indexed_)
+	{
+		rebuild();
+		return;
+	}
+
+	// bans are appended, so only the tail is new
+	for (; indexed_ < count; indexed_++)
+	{
+		index(config.getBan(indexed_), static_cast<int32_t>(indexed_));
+	}
+}
+
+bool BanIndex::addSerial(StringView serial)
+{
+	return !serial.empty() && serials_.insert(lowercase(serial)).second;
+}
+
+bool BanIndex::removeSerial(StringView serial)
+{
+	return serials_.erase(lowercase(serial)) != 0;
+}
+
+void BanIndex::clearSerials()
+{
+	serials_.clear();
+}
+
+bool BanIndex::check(StringView address, StringView name, StringView serial, BanVerdict& verdict)
+{
+	verdict = {};
+	verdict.index = -1;
+	stats_.checks++;
+
+	// bans changed by other components, IPlayer::ban or the console are not seen by the proxies
+	if (core_ != nullptr && core_->getConfig().getBansCount() != indexed_)
+	{
+		added();
+	}
+
+	if (!address.empty())
+	{
+		Address key;
+		uint32_t prefix;
+		if (parse(address, key, prefix) && prefix == 128)
+		{
+			auto it = addresses_.find(key);
+			if (it != addresses_.end())
+			{
+				verdict.match = BanMatch_Address;
+				verdict.index = it->second;
+			}
+			else if ((verdict.index = findRange(key)) >= 0)
+			{
+				verdict.match = BanMatch_Range;
+			}
+		}
+	}
+
+	if (verdict.match == BanMatch_None && !name.empty())
+	{
+		auto it = names_.find(lowercase(name));
+		if (it != names_.end())
+		{
+			verdict.match = BanMatch_Name;
+			verdict.index = it->second;
+		}
+	}
+
+	if (verdict.match == BanMatch_None && !serial.empty() && serials_.count(lowercase(serial)) != 0)
+	{
+		verdict.match = BanMatch_Serial;
+	}
+
+	if (verdict.match == BanMatch_None)
+	{
+		return false;
+	}
+
+	stats_.hits++;
+	return true;
+}
+
+bool BanIndex::checkPlayer(IPlayer& player, BanVerdict& verdict)
+{
+	PeerAddress::AddressString address;
+	PeerAddress::ToString(player.getNetworkData().networkID.address, address);
+	return check(StringView(address.data(), address.length()), player.getName(), player.getSerial(), verdict);
+}
+
+void BanIndex::getStats(BanIndexStats& stats) const
+{
+	stats = stats_;
+	stats.bans = static_cast<uint32_t>(indexed_);
+	stats.addresses = static_cast<uint32_t>(addresses_.size());
+	stats.names = static_cast<uint32_t>(names_.size());
+	stats.serials = static_cast<uint32_t>(serials_.size());
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace Impl;
+
+enum BanMatch : uint8_t
+{
+	BanMatch_None,
+	/// the address of a ban
+	BanMatch_Address,
+	/// a range of a ban, written as a prefix length (1.2.3.0/24) or with wildcards (1.2.*.*)
+	BanMatch_Range,
+	/// the name of a ban without an address, which is matched case-insensitively
+	BanMatch_Name,
+	/// a serial added to the index
+	BanMatch_Serial,
+};
+
+/// result of a ban lookup. layout is shared with the managed BanVerdict struct
+struct BanVerdict
+{
+	BanMatch match;
+	uint8_t reserved[3];
+	/// index of the matching ban in the bans of the config, or -1 for serials
+	int32_t index;
+};
+
+/// statistics of the ban index. layout is shared with the managed BanIndexStats struct
+struct BanIndexStats
+{
+	uint64_t checks;
+	uint64_t hits;
+	uint64_t rebuilds;
+	/// time spent on the last rebuild
+	uint64_t rebuildNanoseconds;
+	uint32_t bans;
+	uint32_t addresses;
+	uint32_t ranges;
+	uint32_t names;
+	uint32_t serials;
+	/// bans with an address which is neither an address nor a range
+	uint32_t invalid;
+};
+
+/// index of the bans of the config for lookups during connection storms. addresses and names are kept in hash maps and
+/// ranges in a binary prefix trie; IPv4 addresses are stored as IPv4-mapped IPv6 addresses, so both share the trie. a
+/// lookup costs a hash and at most 128 steps in the trie, independent of the number of bans. bans added through the
+/// proxies of the config are indexed as they are added, and bans added elsewhere (IPlayer::ban, the console) before the
+/// next lookup; the index is only rebuilt when bans are removed or reloaded. a removal and an addition made elsewhere
+/// leave the number of bans unchanged and are not detected until the next rebuild. the bans of the config have no
+/// serial, so serials are banned in the index itself and are not persisted.
+class BanIndex final
+{
+public:
+	struct Address
+	{
+		uint64_t high = 0;
+		uint64_t low = 0;
+
+		bool operator==(const Address& other) const
+		{
+			return high == other.high && low == other.low;
+		}
+	};
+
+	/// parses an IPv4 or IPv6 address, range or wildcard into an address and a prefix length. returns false if the
+	/// text is neither
+	static bool parse(StringView text, Address& address, uint32_t& prefix);
+
+private:
+	static constexpr uint32_t NO_NODE = 0;
+
+	struct AddressHash
+	{
+		size_t operator()(const Address& address) const
+		{
+			return std::hash<uint64_t>()(address.high * 0x9E3779B97F4A7C15ull ^ address.low);
+		}
+	};
+
+	struct TrieNode
+	{
+		/// children by the next bit; the root is never a child
+		uint32_t children[2] = { NO_NODE, NO_NODE };
+		int32_t ban = -1;
+	};
+
+	ICore* core_ = nullptr;
+	std::unordered_map<Address, int32_t, AddressHash> addresses_;
+	std::unordered_map<std::string, int32_t> names_;
+	std::unordered_set<std::string> serials_;
+	std::vector<TrieNode> nodes_;
+	size_t indexed_ = 0;
+	BanIndexStats stats_ {};
+
+	void insertRange(const Address& address, uint32_t prefix, int32_t ban);
+
+	/// index of the ban with the longest range containing the address or -1
+	int32_t findRange(const Address& address) const;
+
+	void index(const BanEntry& ban, int32_t id);
+
+public:
+	BanIndex();
+
+	BanIndex(const BanIndex&) = delete;
+	BanIndex& operator=(const BanIndex&) = delete;
+
+	void attach(ICore* core);
+
+	void detach();
+
+	/// rebuilds the index from the bans of the config
+	void rebuild();
+
+	/// indexes the bans appended to the config since the last call, or rebuilds the index if bans were removed
+	void added();
+
+	bool addSerial(StringView serial);
+
+	bool removeSerial(StringView serial);
+
+	void clearSerials();
+
+	/// looks up the address, name and serial; empty values are not looked up. returns true if any is banned
+	bool check(StringView address, StringView name, StringView serial, BanVerdict& verdict);
+
+	/// looks up the address, name and serial of the player
+	bool checkPlayer(IPlayer& player, BanVerdict& verdict);
+
+	void getStats(BanIndexStats& stats) const;
+};
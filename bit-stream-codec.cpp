@@ -0,0 +1,576 @@
+#include "bit-stream-codec.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+/// reads bits most significant first like NetworkBitStream. values of multiple bytes are read in the byte order of the
+/// host with the bits of a partial last byte aligned to the right
+class BitReader
+{
+private:
+	const uint8_t* data_;
+	size_t bits_;
+	size_t offset_;
+
+	/// reads 1 to 8 bits
+	uint8_t take(size_t count)
+	{
+		const size_t byte = offset_ >> 3;
+		const size_t shift = offset_ & 7;
+
+		uint32_t window = static_cast<uint32_t>(data_[byte]) << 8;
+		if (shift + count > 8)
+		{
+			window |= data_[byte + 1];
+		}
+
+		offset_ += count;
+		return static_cast<uint8_t>((window >> (16 - shift - count)) & ((1u << count) - 1));
+	}
+
+public:
+	BitReader(const uint8_t* data, size_t bits, size_t offset)
+		: data_(data)
+		, bits_(bits)
+		, offset_(offset)
+	{
+	}
+
+	size_t getOffset() const
+	{
+		return offset_;
+	}
+
+	size_t getRemaining() const
+	{
+		return bits_ - offset_;
+	}
+
+	bool readBits(uint8_t* output, size_t count)
+	{
+		if (count > getRemaining())
+		{
+			return false;
+		}
+
+		for (; count >= 8; count -= 8)
+		{
+			*output++ = take(8);
+		}
+		if (count > 0)
+		{
+			*output = take(count);
+		}
+		return true;
+	}
+
+	bool readBool(bool& value)
+	{
+		if (getRemaining() < 1)
+		{
+			return false;
+		}
+		value = take(1) != 0;
+		return true;
+	}
+
+	template <typename T>
+	bool read(T& value)
+	{
+		uint8_t bytes[sizeof(T)];
+		if (!readBits(bytes, sizeof(T) * 8))
+		{
+			return false;
+		}
+		memcpy(&value, bytes, sizeof(T));
+		return true;
+	}
+
+	bool align()
+	{
+		return skip((8 - (offset_ & 7)) & 7);
+	}
+
+	bool skip(size_t count)
+	{
+		if (count > getRemaining())
+		{
+			return false;
+		}
+		offset_ += count;
+		return true;
+	}
+};
+
+/// counterpart of BitReader which appends to a buffer
+class BitWriter
+{
+private:
+	std::vector<uint8_t>& buffer_;
+	size_t offset_ = 0;
+
+	/// writes the low 1 to 8 bits of the value
+	void put(uint8_t value, size_t count)
+	{
+		const size_t end = offset_ + count;
+		if (buffer_.size() * 8 < end)
+		{
+			buffer_.resize((end + 7) / 8, 0);
+		}
+
+		const size_t byte = offset_ >> 3;
+		const size_t shift = offset_ & 7;
+		const uint32_t window = (value & ((1u << count) - 1)) << (16 - shift - count);
+
+		buffer_[byte] |= static_cast<uint8_t>(window >> 8);
+		if (shift + count > 8)
+		{
+			buffer_[byte + 1] |= static_cast<uint8_t>(window);
+		}
+		offset_ = end;
+	}
+
+public:
+	explicit BitWriter(std::vector<uint8_t>& buffer)
+		: buffer_(buffer)
+	{
+		buffer_.clear();
+	}
+
+	size_t getOffset() const
+	{
+		return offset_;
+	}
+
+	void writeBits(const uint8_t* input, size_t count)
+	{
+		for (; count >= 8; count -= 8)
+		{
+			put(*input++, 8);
+		}
+		if (count > 0)
+		{
+			put(*input, count);
+		}
+	}
+
+	void writeBool(bool value)
+	{
+		put(value ? 1 : 0, 1);
+	}
+
+	template <typename T>
+	void write(const T& value)
+	{
+		uint8_t bytes[sizeof(T)];
+		memcpy(bytes, &value, sizeof(T));
+		writeBits(bytes, sizeof(T) * 8);
+	}
+
+	void align()
+	{
+		skip((8 - (offset_ & 7)) & 7);
+	}
+
+	void skip(size_t count)
+	{
+		for (; count >= 8; count -= 8)
+		{
+			put(0, 8);
+		}
+		if (count > 0)
+		{
+			put(0, count);
+		}
+	}
+};
+}
+
+/// size of the value of the field in the struct
+static size_t getValueSize(BitStreamFieldType type)
+{
+	switch (type)
+	{
+	case BitStreamFieldType_Bool:
+	case BitStreamFieldType_UInt8:
+	case BitStreamFieldType_Int8:
+		return 1;
+	case BitStreamFieldType_UInt16:
+	case BitStreamFieldType_Int16:
+		return 2;
+	case BitStreamFieldType_UInt32:
+	case BitStreamFieldType_Int32:
+	case BitStreamFieldType_Float:
+	case BitStreamFieldType_CompressedFloat:
+		return 4;
+	case BitStreamFieldType_UInt64:
+	case BitStreamFieldType_Int64:
+	case BitStreamFieldType_Double:
+	case BitStreamFieldType_Vector2:
+		return 8;
+	case BitStreamFieldType_Vector3:
+		return 12;
+	case BitStreamFieldType_Vector4:
+	case BitStreamFieldType_Quat:
+	case BitStreamFieldType_CompressedQuat:
+		return 16;
+	case BitStreamFieldType_String8:
+	case BitStreamFieldType_String16:
+	case BitStreamFieldType_String32:
+		return sizeof(StringView);
+	default:
+		return 0;
+	}
+}
+
+static bool isInteger(BitStreamFieldType type)
+{
+	return type >= BitStreamFieldType_UInt8 && type <= BitStreamFieldType_Int64;
+}
+
+static bool isSigned(BitStreamFieldType type)
+{
+	return type >= BitStreamFieldType_Int8 && type <= BitStreamFieldType_Int64;
+}
+
+/// number of bits of an integer field on the wire
+static size_t getWireBits(const BitStreamField& field)
+{
+	return field.bits == 0 ? getValueSize(field.type) * 8 : field.bits;
+}
+
+int BitStreamCodec::addSchema(const BitStreamField* fields, size_t count, size_t size)
+{
+	Schema schema { std::vector<BitStreamField>(fields, fields + count), size };
+
+	for (const BitStreamField& field : schema.fields)
+	{
+		if (field.type > BitStreamFieldType_Align)
+		{
+			return -1;
+		}
+
+		if (isInteger(field.type) && field.bits > getValueSize(field.type) * 8)
+		{
+			return -1;
+		}
+
+		if (static_cast<size_t>(field.offset) + getValueSize(field.type) > size)
+		{
+			return -1;
+		}
+	}
+
+	schemas_.push_back(std::move(schema));
+	return static_cast<int>(schemas_.size() - 1);
+}
+
+size_t BitStreamCodec::getSchemaCount() const
+{
+	return schemas_.size();
+}
+
+const BitStreamCodec::Schema* BitStreamCodec::getSchema(int schema, size_t size) const
+{
+	if (schema < 0 || static_cast<size_t>(schema) >= schemas_.size() || schemas_[schema].size != size)
+	{
+		return nullptr;
+	}
+	return &schemas_[schema];
+}
+
+bool BitStreamCodec::decode(int schema, NetworkBitStream& bs, void* output, size_t size)
+{
+	size_t offset = static_cast<size_t>(bs.getReadOffset());
+	if (!decodeBytes(schema, bs.getData(), static_cast<size_t>(bs.getNumberOfBitsUsed()), offset, output, size))
+	{
+		return false;
+	}
+
+	bs.setReadOffset(static_cast<int>(offset));
+	return true;
+}
+
+bool BitStreamCodec::decodeBytes(int schema, const uint8_t* data, size_t bits, size_t& offset, void* output, size_t size)
+{
+	const Schema* entry = getSchema(schema, size);
+	if (entry == nullptr || offset > bits)
+	{
+		return false;
+	}
+
+	return decodeFields(*entry, data, bits, offset, static_cast<uint8_t*>(output));
+}
+
+bool BitStreamCodec::decodeFields(const Schema& schema, const uint8_t* data, size_t bits, size_t& offset, uint8_t* output)
+{
+	BitReader reader(data, bits, offset);
+
+	// strings cannot be longer than the remaining data, so reserving it up front keeps the decoded views stable
+	strings_.clear();
+	strings_.reserve(reader.getRemaining() / 8);
+
+	for (const BitStreamField& field : schema.fields)
+	{
+		uint8_t* value = output + field.offset;
+
+		switch (field.type)
+		{
+		case BitStreamFieldType_Bool:
+		{
+			bool bit;
+			if (!reader.readBool(bit))
+			{
+				return false;
+			}
+			*value = bit ? 1 : 0;
+			break;
+		}
+		case BitStreamFieldType_UInt8:
+		case BitStreamFieldType_UInt16:
+		case BitStreamFieldType_UInt32:
+		case BitStreamFieldType_UInt64:
+		case BitStreamFieldType_Int8:
+		case BitStreamFieldType_Int16:
+		case BitStreamFieldType_Int32:
+		case BitStreamFieldType_Int64:
+		{
+			const size_t wire = getWireBits(field);
+			uint8_t bytes[8] {};
+			if (!reader.readBits(bytes, wire))
+			{
+				return false;
+			}
+
+			uint64_t integer;
+			memcpy(&integer, bytes, sizeof(integer));
+			if (isSigned(field.type) && wire < 64 && (integer >> (wire - 1)) & 1)
+			{
+				integer |= ~0ull << wire;
+			}
+			memcpy(value, &integer, getValueSize(field.type));
+			break;
+		}
+		case BitStreamFieldType_Float:
+		case BitStreamFieldType_Double:
+		case BitStreamFieldType_Vector2:
+		case BitStreamFieldType_Vector3:
+		case BitStreamFieldType_Vector4:
+		case BitStreamFieldType_Quat:
+			if (!reader.readBits(value, getValueSize(field.type) * 8))
+			{
+				return false;
+			}
+			break;
+		case BitStreamFieldType_CompressedFloat:
+		{
+			uint16_t compressed;
+			if (!reader.read(compressed))
+			{
+				return false;
+			}
+			const float real = compressed / 32767.5f - 1.0f;
+			memcpy(value, &real, sizeof(real));
+			break;
+		}
+		case BitStreamFieldType_CompressedQuat:
+		{
+			bool negative[4];
+			uint16_t compressed[3];
+			for (bool& sign : negative)
+			{
+				if (!reader.readBool(sign))
+				{
+					return false;
+				}
+			}
+			for (uint16_t& component : compressed)
+			{
+				if (!reader.read(component))
+				{
+					return false;
+				}
+			}
+
+			// w is left out and restored from the unit length
+			float quat[4];
+			for (size_t i = 0; i < 3; i++)
+			{
+				quat[i + 1] = negative[i + 1] ? -(compressed[i] / 65535.0f) : compressed[i] / 65535.0f;
+			}
+			const float difference = 1.0f - quat[1] * quat[1] - quat[2] * quat[2] - quat[3] * quat[3];
+			quat[0] = std::sqrt(difference < 0.0f ? 0.0f : difference);
+			if (negative[0])
+			{
+				quat[0] = -quat[0];
+			}
+			memcpy(value, quat, sizeof(quat));
+			break;
+		}
+		case BitStreamFieldType_String8:
+		case BitStreamFieldType_String16:
+		case BitStreamFieldType_String32:
+		{
+			uint32_t length = 0;
+			const size_t prefix = field.type == BitStreamFieldType_String8 ? 8 : field.type == BitStreamFieldType_String16 ? 16 : 32;
+			if (!reader.readBits(reinterpret_cast<uint8_t*>(&length), prefix) || length > reader.getRemaining() / 8)
+			{
+				return false;
+			}
+
+			const size_t start = strings_.size();
+			strings_.resize(start + length);
+			reader.readBits(reinterpret_cast<uint8_t*>(strings_.data() + start), length * 8);
+
+			const StringView view(strings_.data() + start, length);
+			memcpy(value, &view, sizeof(view));
+			break;
+		}
+		case BitStreamFieldType_Skip:
+			if (!reader.skip(field.bits))
+			{
+				return false;
+			}
+			break;
+		case BitStreamFieldType_Align:
+			if (!reader.align())
+			{
+				return false;
+			}
+			break;
+		}
+	}
+
+	offset = reader.getOffset();
+	return true;
+}
+
+bool BitStreamCodec::encode(int schema, const void* input, size_t size)
+{
+	bufferBits_ = 0;
+
+	const Schema* entry = getSchema(schema, size);
+	if (entry == nullptr)
+	{
+		buffer_.clear();
+		return false;
+	}
+
+	BitWriter writer(buffer_);
+	auto data = static_cast<const uint8_t*>(input);
+
+	for (const BitStreamField& field : entry->fields)
+	{
+		const uint8_t* value = data + field.offset;
+
+		switch (field.type)
+		{
+		case BitStreamFieldType_Bool:
+			writer.writeBool(*value != 0);
+			break;
+		case BitStreamFieldType_UInt8:
+		case BitStreamFieldType_UInt16:
+		case BitStreamFieldType_UInt32:
+		case BitStreamFieldType_UInt64:
+		case BitStreamFieldType_Int8:
+		case BitStreamFieldType_Int16:
+		case BitStreamFieldType_Int32:
+		case BitStreamFieldType_Int64:
+			writer.writeBits(value, getWireBits(field));
+			break;
+		case BitStreamFieldType_Float:
+		case BitStreamFieldType_Double:
+		case BitStreamFieldType_Vector2:
+		case BitStreamFieldType_Vector3:
+		case BitStreamFieldType_Vector4:
+		case BitStreamFieldType_Quat:
+			writer.writeBits(value, getValueSize(field.type) * 8);
+			break;
+		case BitStreamFieldType_CompressedFloat:
+		{
+			float real;
+			memcpy(&real, value, sizeof(real));
+			real = real < -1.0f ? -1.0f : real > 1.0f ? 1.0f : real;
+			writer.write(static_cast<uint16_t>((real + 1.0f) * 32767.5f));
+			break;
+		}
+		case BitStreamFieldType_CompressedQuat:
+		{
+			float quat[4];
+			memcpy(quat, value, sizeof(quat));
+			for (float component : quat)
+			{
+				writer.writeBool(component < 0.0f);
+			}
+			for (size_t i = 1; i < 4; i++)
+			{
+				writer.write(static_cast<uint16_t>(std::fabs(quat[i]) * 65535.0f));
+			}
+			break;
+		}
+		case BitStreamFieldType_String8:
+		case BitStreamFieldType_String16:
+		case BitStreamFieldType_String32:
+		{
+			StringView view;
+			memcpy(&view, value, sizeof(view));
+
+			const size_t prefix = field.type == BitStreamFieldType_String8 ? 8 : field.type == BitStreamFieldType_String16 ? 16 : 32;
+			if (prefix < 32 && view.length() >= (1ull << prefix))
+			{
+				buffer_.clear();
+				return false;
+			}
+
+			const uint32_t length = static_cast<uint32_t>(view.length());
+			writer.writeBits(reinterpret_cast<const uint8_t*>(&length), prefix);
+			writer.writeBits(reinterpret_cast<const uint8_t*>(view.data()), view.length() * 8);
+			break;
+		}
+		case BitStreamFieldType_Skip:
+			writer.skip(field.bits);
+			break;
+		case BitStreamFieldType_Align:
+			writer.align();
+			break;
+		}
+	}
+
+	bufferBits_ = writer.getOffset();
+	return true;
+}
+
+const uint8_t* BitStreamCodec::getData() const
+{
+	return buffer_.data();
+}
+
+size_t BitStreamCodec::getLength() const
+{
+	return buffer_.size();
+}
+
+size_t BitStreamCodec::getBitLength() const
+{
+	return bufferBits_;
+}
+
+bool BitStreamCodec::sendRPC(IPlayer& player, int id, int schema, const void* input, size_t size, int channel)
+{
+	if (!encode(schema, input, size))
+	{
+		return false;
+	}
+	return player.sendRPC(id, Span<uint8_t>(buffer_.data(), buffer_.size()), channel, true);
+}
+
+bool BitStreamCodec::sendPacket(IPlayer& player, int schema, const void* input, size_t size, int channel)
+{
+	if (!encode(schema, input, size))
+	{
+		return false;
+	}
+	return player.sendPacket(Span<uint8_t>(buffer_.data(), buffer_.size()), channel, true);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Impl;
+
+enum BitStreamFieldType : uint8_t
+{
+	/// single bit stored as a byte
+	BitStreamFieldType_Bool,
+	/// integers of the field bits on the wire (all bits of the type if 0). signed values are sign extended
+	BitStreamFieldType_UInt8,
+	BitStreamFieldType_UInt16,
+	BitStreamFieldType_UInt32,
+	BitStreamFieldType_UInt64,
+	BitStreamFieldType_Int8,
+	BitStreamFieldType_Int16,
+	BitStreamFieldType_Int32,
+	BitStreamFieldType_Int64,
+	BitStreamFieldType_Float,
+	BitStreamFieldType_Double,
+	BitStreamFieldType_Vector2,
+	BitStreamFieldType_Vector3,
+	BitStreamFieldType_Vector4,
+	/// four floats in w, x, y, z order
+	BitStreamFieldType_Quat,
+	/// float in [-1, 1] compressed to 16 bits
+	BitStreamFieldType_CompressedFloat,
+	/// normalized quaternion compressed to 4 sign bits and 3 x 16 bits; stored as four floats in w, x, y, z order
+	BitStreamFieldType_CompressedQuat,
+	/// strings with an 8, 16 or 32 bit length prefix stored as a StringView
+	BitStreamFieldType_String8,
+	BitStreamFieldType_String16,
+	BitStreamFieldType_String32,
+	/// skips the field bits; nothing is stored
+	BitStreamFieldType_Skip,
+	/// skips to the next byte boundary; nothing is stored
+	BitStreamFieldType_Align,
+};
+
+/// field of a schema. layout is shared with the managed BitStreamField struct
+struct BitStreamField
+{
+	BitStreamFieldType type;
+	uint8_t bits;
+	uint16_t reserved;
+	/// offset of the value in the struct
+	uint32_t offset;
+};
+
+/// decodes bit streams into structs and encodes structs into bit streams following a schema which is registered once.
+/// the bit layout matches the reads and writes of NetworkBitStream, so a schema can describe any packet or RPC without
+/// a native call per field. must only be used from the server thread.
+class BitStreamCodec final
+{
+private:
+	struct Schema
+	{
+		std::vector<BitStreamField> fields;
+		size_t size;
+	};
+
+	std::vector<Schema> schemas_;
+	/// strings of the last decoded struct
+	std::vector<char> strings_;
+	/// data of the last encoded struct
+	std::vector<uint8_t> buffer_;
+	size_t bufferBits_ = 0;
+
+	const Schema* getSchema(int schema, size_t size) const;
+
+	bool decodeFields(const Schema& schema, const uint8_t* data, size_t bits, size_t& offset, uint8_t* output);
+
+public:
+	BitStreamCodec() = default;
+
+	BitStreamCodec(const BitStreamCodec&) = delete;
+	BitStreamCodec& operator=(const BitStreamCodec&) = delete;
+
+	/// registers a schema for structs of the specified size and returns its ID or -1 if a field is invalid or does not
+	/// fit in the struct
+	int addSchema(const BitStreamField* fields, size_t count, size_t size);
+
+	size_t getSchemaCount() const;
+
+	/// decodes the fields from the read offset of the bit stream into the struct and advances the read offset. returns
+	/// false and leaves the read offset unchanged if the stream ends before the last field. decoded strings are valid
+	/// until the next decode
+	bool decode(int schema, NetworkBitStream& bs, void* output, size_t size);
+
+	/// decodes the fields from the bit offset of data which is the specified number of bits long. the offset is advanced
+	/// past the decoded fields on success
+	bool decodeBytes(int schema, const uint8_t* data, size_t bits, size_t& offset, void* output, size_t size);
+
+	/// encodes the struct into the buffer of the codec. returns false if the schema does not exist or a string is too
+	/// long for its length prefix. the buffer is valid until the next encode
+	bool encode(int schema, const void* input, size_t size);
+
+	const uint8_t* getData() const;
+
+	/// length of the encoded data in bytes
+	size_t getLength() const;
+
+	size_t getBitLength() const;
+
+	/// encodes the struct and sends it to the player as an RPC
+	bool sendRPC(IPlayer& player, int id, int schema, const void* input, size_t size, int channel);
+
+	/// encodes the struct and sends it to the player as a packet. the schema includes the packet ID
+	bool sendPacket(IPlayer& player, int schema, const void* input, size_t size, int channel);
+};
@@ -0,0 +1,503 @@
+#include "bridge-recorder.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+BridgeRecorder* BridgeRecorder::active_ = nullptr;
+
+std::vector<const BridgeEvent*>& BridgeEvent::registry()
+{
+	static std::vector<const BridgeEvent*> events;
+	return events;
+}
+
+BridgeEvent::BridgeEvent(const char* handler, const char* name, bridge_replay_fn replay)
+	: handler_(handler)
+	, name_(std::string(handler) + "." + name)
+	, index_(static_cast<uint16_t>(registry().size()))
+	, replay_(replay)
+{
+	registry().push_back(this);
+}
+
+const char* BridgeEvent::getHandler() const
+{
+	return handler_;
+}
+
+const std::string& BridgeEvent::getName() const
+{
+	return name_;
+}
+
+uint16_t BridgeEvent::getIndex() const
+{
+	return index_;
+}
+
+bool BridgeEvent::replay(BridgeReader& reader, void* const* targets, size_t count) const
+{
+	return replay_(reader, targets, count);
+}
+
+size_t BridgeEvent::count()
+{
+	return registry().size();
+}
+
+const BridgeEvent* BridgeEvent::find(StringView name)
+{
+	for (const BridgeEvent* event : registry())
+	{
+		if (StringView(event->name_) == name)
+		{
+			return event;
+		}
+	}
+	return nullptr;
+}
+
+std::vector<BridgeTarget*>& BridgeTarget::registry()
+{
+	static std::vector<BridgeTarget*> targets;
+	return targets;
+}
+
+BridgeTarget::BridgeTarget(void* self, const char* handler)
+	: self_(self)
+	, handler_(handler)
+{
+	registry().push_back(this);
+}
+
+BridgeTarget::~BridgeTarget()
+{
+	auto& targets = registry();
+	targets.erase(std::remove(targets.begin(), targets.end(), this), targets.end());
+}
+
+void BridgeTarget::collect(const char* handler, std::vector<void*>& targets)
+{
+	for (const BridgeTarget* target : registry())
+	{
+		if (target->handler_ == handler)
+		{
+			targets.push_back(target->self_);
+		}
+	}
+}
+
+uint64_t BridgeSubjects::key(BridgeSubjectType type, int32_t id, int32_t owner)
+{
+	return (static_cast<uint64_t>(type) << 56) | (static_cast<uint64_t>(static_cast<uint16_t>(owner + 1)) << 32) | static_cast<uint32_t>(id);
+}
+
+void BridgeSubjects::attach(ICore* core, IComponentList* components)
+{
+	core_ = core;
+	npcs_ = components->queryComponent<INPCComponent>();
+	vehicles_ = components->queryComponent<IVehiclesComponent>();
+	actors_ = components->queryComponent<IActorsComponent>();
+	objects_ = components->queryComponent<IObjectsComponent>();
+	gangZones_ = components->queryComponent<IGangZonesComponent>();
+	pickups_ = components->queryComponent<IPickupsComponent>();
+	textDraws_ = components->queryComponent<ITextDrawsComponent>();
+
+	// stand-ins destroyed by a handler or the server are forgotten before any handler sees the disconnect
+	core_->getPlayers().getPlayerConnectDispatcher().addEventHandler(this, EventPriority_Highest);
+}
+
+void BridgeSubjects::onFree(IComponent* component)
+{
+	if (component == npcs_)
+	{
+		npcs_ = nullptr;
+	}
+	else if (component == vehicles_)
+	{
+		vehicles_ = nullptr;
+	}
+	else if (component == actors_)
+	{
+		actors_ = nullptr;
+	}
+	else if (component == objects_)
+	{
+		objects_ = nullptr;
+	}
+	else if (component == gangZones_)
+	{
+		gangZones_ = nullptr;
+	}
+	else if (component == pickups_)
+	{
+		pickups_ = nullptr;
+	}
+	else if (component == textDraws_)
+	{
+		textDraws_ = nullptr;
+	}
+}
+
+void BridgeSubjects::detach()
+{
+	clear();
+	if (core_ != nullptr)
+	{
+		core_->getPlayers().getPlayerConnectDispatcher().removeEventHandler(this);
+		core_ = nullptr;
+	}
+	npcs_ = nullptr;
+	vehicles_ = nullptr;
+	actors_ = nullptr;
+	objects_ = nullptr;
+	gangZones_ = nullptr;
+	pickups_ = nullptr;
+	textDraws_ = nullptr;
+}
+
+void BridgeSubjects::clear()
+{
+	std::unordered_map<uint64_t, StandIn> standIns;
+	standIns.swap(standIns_);
+	entities_.clear();
+	resetOwner();
+
+	// per-player stand-ins are released before their players are destroyed
+	for (const auto& entry : standIns)
+	{
+		const StandIn& standIn = entry.second;
+		switch (static_cast<BridgeSubjectType>(entry.first >> 56))
+		{
+		case BridgeSubjectType_Vehicle:
+			release(vehicles_, standIn);
+			break;
+		case BridgeSubjectType_Actor:
+			release(actors_, standIn);
+			break;
+		case BridgeSubjectType_Object:
+			release(objects_, standIn);
+			break;
+		case BridgeSubjectType_PlayerObject:
+			if (objects_ != nullptr)
+			{
+				release(queryExtension<IPlayerObjectData>(standIn.owner), standIn);
+			}
+			break;
+		case BridgeSubjectType_GangZone:
+			release(gangZones_, standIn);
+			break;
+		case BridgeSubjectType_Pickup:
+			release(pickups_, standIn);
+			break;
+		case BridgeSubjectType_TextDraw:
+			release(textDraws_, standIn);
+			break;
+		case BridgeSubjectType_PlayerTextDraw:
+			if (textDraws_ != nullptr)
+			{
+				release(queryExtension<IPlayerTextDrawData>(standIn.owner), standIn);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	// the stand-ins are no longer tracked, so the disconnects dispatched here are ignored
+	for (const auto& entry : standIns)
+	{
+		if (static_cast<BridgeSubjectType>(entry.first >> 56) == BridgeSubjectType_Player && npcs_ != nullptr)
+		{
+			npcs_->destroy(*entry.second.npc);
+		}
+	}
+}
+
+bool BridgeSubjects::connect(int32_t id)
+{
+	IPlayer* player;
+	return resolve(id, player);
+}
+
+bool BridgeSubjects::disconnect(int32_t id)
+{
+	auto it = standIns_.find(key(BridgeSubjectType_Player, id, -1));
+	if (it == standIns_.end() || npcs_ == nullptr)
+	{
+		return false;
+	}
+
+	INPC* npc = it->second.npc;
+	forget(*static_cast<IPlayer*>(it->second.entity));
+	npcs_->destroy(*npc);
+	return true;
+}
+
+bool BridgeSubjects::resolve(int id, IPlayer*& out)
+{
+	owner_ = id;
+	ownerPlayer_ = nullptr;
+
+	const uint64_t standInKey = key(BridgeSubjectType_Player, id, -1);
+	auto it = standIns_.find(standInKey);
+	if (it != standIns_.end())
+	{
+		out = ownerPlayer_ = static_cast<IPlayer*>(it->second.entity);
+		return true;
+	}
+
+	if (npcs_ == nullptr)
+	{
+		return false;
+	}
+
+	char name[MAX_PLAYER_NAME + 1];
+	snprintf(name, sizeof(name), "replay_%d", id);
+
+	// creating the NPC dispatches its connect to the handlers
+	INPC* npc = npcs_->create(name);
+	IPlayer* player = npc != nullptr ? npc->getPlayer() : nullptr;
+	if (player == nullptr)
+	{
+		return false;
+	}
+
+	standIns_.emplace(standInKey, StandIn { player, player->getID(), nullptr, npc });
+	entities_.insert(player);
+	out = ownerPlayer_ = player;
+	return true;
+}
+
+bool BridgeSubjects::resolve(int id, IVehicle*& out)
+{
+	// stand-ins are created at the origin; only their identity matters to the handlers
+	return resolve(BridgeSubjectType_Vehicle, id, nullptr, vehicles_, out,
+		[this] { return vehicles_->create(false, 400, Vector3(0.0f, 0.0f, 0.0f), 0.0f, -1, -1, Seconds(-1), false); });
+}
+
+bool BridgeSubjects::resolve(int id, IActor*& out)
+{
+	return resolve(BridgeSubjectType_Actor, id, nullptr, actors_, out,
+		[this] { return actors_->create(0, Vector3(0.0f, 0.0f, 0.0f), 0.0f); });
+}
+
+bool BridgeSubjects::resolve(int id, IObject*& out)
+{
+	return resolve(BridgeSubjectType_Object, id, nullptr, objects_, out,
+		[this] { return objects_->create(19300, Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f), 0.0f); });
+}
+
+bool BridgeSubjects::resolve(int id, IPlayerObject*& out)
+{
+	if (ownerPlayer_ == nullptr || objects_ == nullptr)
+	{
+		return false;
+	}
+
+	IPlayerObjectData* data = queryExtension<IPlayerObjectData>(ownerPlayer_);
+	return resolve(BridgeSubjectType_PlayerObject, id, ownerPlayer_, data, out,
+		[data] { return data->create(19300, Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f), 0.0f); });
+}
+
+bool BridgeSubjects::resolve(int id, IGangZone*& out)
+{
+	return resolve(BridgeSubjectType_GangZone, id, nullptr, gangZones_, out,
+		[this] { return gangZones_->create(GangZonePos {}); });
+}
+
+bool BridgeSubjects::resolve(int id, IPickup*& out)
+{
+	return resolve(BridgeSubjectType_Pickup, id, nullptr, pickups_, out,
+		[this] { return pickups_->create(1239, 1, Vector3(0.0f, 0.0f, 0.0f), 0, false); });
+}
+
+bool BridgeSubjects::resolve(int id, ITextDraw*& out)
+{
+	return resolve(BridgeSubjectType_TextDraw, id, nullptr, textDraws_, out,
+		[this] { return textDraws_->create(Vector2(0.0f, 0.0f), "_"); });
+}
+
+bool BridgeSubjects::resolve(int id, IPlayerTextDraw*& out)
+{
+	if (ownerPlayer_ == nullptr || textDraws_ == nullptr)
+	{
+		return false;
+	}
+
+	IPlayerTextDrawData* data = queryExtension<IPlayerTextDrawData>(ownerPlayer_);
+	return resolve(BridgeSubjectType_PlayerTextDraw, id, ownerPlayer_, data, out,
+		[data] { return data->create(Vector2(0.0f, 0.0f), "_"); });
+}
+
+void BridgeSubjects::forget(IPlayer& player)
+{
+	if (ownerPlayer_ == &player)
+	{
+		resetOwner();
+	}
+
+	// per-player stand-ins are destroyed with their player
+	for (auto it = standIns_.begin(); it != standIns_.end();)
+	{
+		if (it->second.entity == &player || it->second.owner == &player)
+		{
+			entities_.erase(it->second.entity);
+			it = standIns_.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+void BridgeSubjects::onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason)
+{
+	if (entities_.count(&player) != 0)
+	{
+		forget(player);
+	}
+}
+
+BridgeRecorder::BridgeRecorder(size_t segment_size)
+	: segmentSize_(std::max(segment_size, static_cast<size_t>(64 * 1024)))
+{
+}
+
+BridgeRecorder::~BridgeRecorder()
+{
+	stop();
+}
+
+std::string BridgeRecorder::getSegmentPath(const std::string& prefix, uint32_t segment)
+{
+	char suffix[16];
+	snprintf(suffix, sizeof(suffix), ".%04u.ssbr", segment);
+	return prefix + suffix;
+}
+
+bool BridgeRecorder::start(StringView prefix)
+{
+	if (isRecording())
+	{
+		return false;
+	}
+
+	prefix_ = prefix.to_string();
+	segmentIndex_ = 0;
+	records_ = 0;
+	bytes_ = 0;
+	dropped_ = 0;
+	segments_ = 0;
+	truncateFailures_ = 0;
+	origin_ = std::chrono::steady_clock::now();
+	started_ = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+	if (!openSegment())
+	{
+		return false;
+	}
+
+	active_ = this;
+	return true;
+}
+
+void BridgeRecorder::stop()
+{
+	if (active_ == this)
+	{
+		active_ = nullptr;
+	}
+	closeSegment();
+}
+
+bool BridgeRecorder::isRecording() const
+{
+	return segment_.isOpen();
+}
+
+void BridgeRecorder::getStats(BridgeRecorderStats& stats) const
+{
+	stats.records = records_;
+	stats.bytes = bytes_;
+	stats.dropped = dropped_;
+	stats.segments = segments_;
+	stats.truncateFailures = truncateFailures_;
+}
+
+bool BridgeRecorder::openSegment()
+{
+	if (!segment_.create(getSegmentPath(prefix_, segmentIndex_), segmentSize_))
+	{
+		return false;
+	}
+
+	const BridgeSegmentHeader header { BRIDGE_RECORDING_MAGIC, BRIDGE_RECORDING_VERSION, segmentIndex_, 0, started_ };
+	memcpy(segment_.data(), &header, sizeof(header));
+
+	offset_ = alignBridgeRecord(sizeof(header));
+	segmentIndex_++;
+	segments_++;
+	defined_.assign(BridgeEvent::count(), false);
+
+	return true;
+}
+
+void BridgeRecorder::closeSegment()
+{
+	if (segment_.isOpen() && !segment_.close(offset_))
+	{
+		truncateFailures_++;
+	}
+}
+
+uint8_t* BridgeRecorder::reserve(const BridgeEvent& event, size_t size)
+{
+	const uint16_t index = event.getIndex();
+	const size_t record = alignBridgeRecord(sizeof(BridgeRecordHeader) + size);
+	const size_t definition = alignBridgeRecord(sizeof(BridgeRecordHeader) + event.getName().size());
+
+	if (offset_ + record + (defined_[index] ? 0 : definition) > segment_.size())
+	{
+		closeSegment();
+
+		if (!openSegment())
+		{
+			// the recording cannot continue without a segment
+			stop();
+			dropped_++;
+			return nullptr;
+		}
+
+		if (offset_ + record + definition > segment_.size())
+		{
+			dropped_++;
+			return nullptr;
+		}
+	}
+
+	uint8_t* data = segment_.data();
+	const int64_t time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin_).count();
+
+	if (!defined_[index])
+	{
+		const BridgeRecordHeader header { static_cast<uint32_t>(event.getName().size()), BridgeRecordKind_Definition, index, time };
+		memcpy(data + offset_, &header, sizeof(header));
+		memcpy(data + offset_ + sizeof(header), event.getName().data(), event.getName().size());
+
+		offset_ += definition;
+		bytes_ += definition;
+		defined_[index] = true;
+	}
+
+	const BridgeRecordHeader header { static_cast<uint32_t>(size), BridgeRecordKind_Event, index, time };
+	memcpy(data + offset_, &header, sizeof(header));
+
+	uint8_t* payload = data + offset_ + sizeof(header);
+	offset_ += record;
+	bytes_ += record;
+	records_++;
+
+	return payload;
+}
@@ -0,0 +1,718 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/Actors/actors.hpp>
+#include <Server/Components/Console/console.hpp>
+#include <Server/Components/GangZones/gangzones.hpp>
+#include <Server/Components/NPCs/npcs.hpp>
+#include <Server/Components/Objects/objects.hpp>
+#include <Server/Components/Pickups/pickups.hpp>
+#include <Server/Components/TextDraws/textdraws.hpp>
+#include <Server/Components/Vehicles/vehicles.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "dotnet/coreclr_delegates.h"
+#include "mapped-file.hpp"
+
+using namespace Impl;
+
+//
+// recording format: a recording consists of one or more segment files (<prefix>.0000.ssbr, <prefix>.0001.ssbr, ...).
+// every segment starts with a BridgeSegmentHeader followed by 8-byte aligned records. a segment is self-contained:
+// events are defined (index -> "Handler.event" name) in every segment before their first use. the zero-filled
+// remainder of a segment which was not closed properly reads as an end record.
+//
+
+constexpr uint32_t BRIDGE_RECORDING_MAGIC = 0x52425353; // "SSBR"
+constexpr uint32_t BRIDGE_RECORDING_VERSION = 1;
+
+enum BridgeRecordKind : uint16_t
+{
+	BridgeRecordKind_End,
+	BridgeRecordKind_Definition,
+	BridgeRecordKind_Event,
+};
+
+struct BridgeSegmentHeader
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t segment;
+	uint32_t reserved;
+	/// system time at which the recording was started, in nanoseconds since the epoch
+	int64_t recordingStarted;
+};
+
+struct BridgeRecordHeader
+{
+	/// size of the payload following the header
+	uint32_t size;
+	BridgeRecordKind kind;
+	uint16_t event;
+	/// nanoseconds since the start of the recording
+	int64_t time;
+};
+
+inline size_t alignBridgeRecord(size_t size)
+{
+	return (size + 7) & ~static_cast<size_t>(7);
+}
+
+class BridgeReader;
+
+typedef bool (*bridge_replay_fn)(BridgeReader& reader, void* const* targets, size_t count);
+
+/// event of a proxied event handler. instances are static members of the event handler proxy classes and are
+/// registered when the component is loaded
+class BridgeEvent final
+{
+private:
+	const char* handler_;
+	std::string name_;
+	uint16_t index_;
+	bridge_replay_fn replay_;
+
+	static std::vector<const BridgeEvent*>& registry();
+
+public:
+	BridgeEvent(const char* handler, const char* name, bridge_replay_fn replay);
+
+	BridgeEvent(const BridgeEvent&) = delete;
+	BridgeEvent& operator=(const BridgeEvent&) = delete;
+
+	const char* getHandler() const;
+
+	/// "Handler.event"; stable between builds, unlike the index
+	const std::string& getName() const;
+
+	uint16_t getIndex() const;
+
+	/// decodes the arguments of a recorded event and invokes the managed handlers of the targets
+	bool replay(BridgeReader& reader, void* const* targets, size_t count) const;
+
+	static size_t count();
+
+	static const BridgeEvent* find(StringView name);
+};
+
+/// event handler proxy instance which receives replayed events. a member of every event handler proxy class
+class BridgeTarget final
+{
+private:
+	void* self_;
+	const char* handler_;
+
+	static std::vector<BridgeTarget*>& registry();
+
+public:
+	BridgeTarget(void* self, const char* handler);
+
+	BridgeTarget(const BridgeTarget&) = delete;
+	BridgeTarget& operator=(const BridgeTarget&) = delete;
+
+	~BridgeTarget();
+
+	static void collect(const char* handler, std::vector<void*>& targets);
+};
+
+enum BridgeSubjectType : uint8_t
+{
+	BridgeSubjectType_Player,
+	BridgeSubjectType_Vehicle,
+	BridgeSubjectType_Actor,
+	BridgeSubjectType_Object,
+	BridgeSubjectType_PlayerObject,
+	BridgeSubjectType_GangZone,
+	BridgeSubjectType_Pickup,
+	BridgeSubjectType_TextDraw,
+	BridgeSubjectType_PlayerTextDraw,
+};
+
+/// maps the entities of a recording to entities of the replaying server, so handlers receive open.mp entities which
+/// they can call into. recorded players are replayed as NPCs, which leaves the players on the server alone. other
+/// entities are replayed as the live entity with the recorded ID or, if there is none, as a stand-in created for the
+/// replay. a recorded entity is replayed as the same entity until it is destroyed, so handlers can key their state on
+/// the subject. an event of which an entity cannot be mapped, e.g. a player without the NPC component, is skipped.
+class BridgeSubjects final : public PlayerConnectEventHandler
+{
+private:
+	struct StandIn
+	{
+		void* entity;
+		/// ID of the stand-in on the replaying server
+		int id;
+		/// player of a per-player stand-in
+		IPlayer* owner;
+		/// NPC of a player stand-in
+		INPC* npc;
+	};
+
+	ICore* core_ = nullptr;
+	INPCComponent* npcs_ = nullptr;
+	IVehiclesComponent* vehicles_ = nullptr;
+	IActorsComponent* actors_ = nullptr;
+	IObjectsComponent* objects_ = nullptr;
+	IGangZonesComponent* gangZones_ = nullptr;
+	IPickupsComponent* pickups_ = nullptr;
+	ITextDrawsComponent* textDraws_ = nullptr;
+	/// stand-ins by type, recorded owner and recorded ID
+	std::unordered_map<uint64_t, StandIn> standIns_;
+	/// entities of the stand-ins; a live entity which has the recorded ID of another entity by chance is not used
+	std::unordered_set<const void*> entities_;
+	/// recorded ID and stand-in of the last resolved player; owner of per-player entities which always follow their
+	/// player in event arguments
+	int32_t owner_ = -1;
+	IPlayer* ownerPlayer_ = nullptr;
+
+	static uint64_t key(BridgeSubjectType type, int32_t id, int32_t owner);
+
+	template <class T>
+	static void release(IPool<T>* pool, const StandIn& standIn)
+	{
+		// the stand-in may have been destroyed by a handler
+		if (pool != nullptr && pool->get(standIn.id) == standIn.entity)
+		{
+			pool->release(standIn.id);
+		}
+	}
+
+	/// maps a recorded entity of a pool to its stand-in, the live entity with the recorded ID or a new stand-in made by
+	/// create, which returns null on failure. owner is the player of a per-player entity
+	template <class T, class Create>
+	bool resolve(BridgeSubjectType type, int32_t id, IPlayer* owner, IPool<T>* pool, T*& out, Create create)
+	{
+		if (pool == nullptr)
+		{
+			return false;
+		}
+
+		const uint64_t standInKey = key(type, id, owner != nullptr ? owner_ : -1);
+		auto it = standIns_.find(standInKey);
+		if (it != standIns_.end())
+		{
+			if (pool->get(it->second.id) == it->second.entity)
+			{
+				out = static_cast<T*>(it->second.entity);
+				return true;
+			}
+			// destroyed by a handler; replaced below
+			entities_.erase(it->second.entity);
+			standIns_.erase(it);
+		}
+
+		T* live = pool->get(id);
+		if (live != nullptr && entities_.count(live) == 0)
+		{
+			out = live;
+			return true;
+		}
+
+		T* created = create();
+		if (created == nullptr)
+		{
+			return false;
+		}
+		standIns_.emplace(standInKey, StandIn { created, created->getID(), owner, nullptr });
+		entities_.insert(created);
+		out = created;
+		return true;
+	}
+
+	/// forgets a player stand-in and its per-player stand-ins
+	void forget(IPlayer& player);
+
+public:
+	BridgeSubjects() = default;
+
+	BridgeSubjects(const BridgeSubjects&) = delete;
+	BridgeSubjects& operator=(const BridgeSubjects&) = delete;
+
+	void attach(ICore* core, IComponentList* components);
+
+	void onFree(IComponent* component);
+
+	void detach();
+
+	/// destroys all stand-ins
+	void clear();
+
+	/// forgets the owner of per-player entities before the arguments of the next event are read
+	void resetOwner()
+	{
+		owner_ = -1;
+		ownerPlayer_ = nullptr;
+	}
+
+	/// connects the stand-in of a recorded player. returns false if no NPC can be created for it
+	bool connect(int32_t id);
+
+	/// disconnects the stand-in of a recorded player. returns false if the player has no stand-in
+	bool disconnect(int32_t id);
+
+	bool resolve(int id, IPlayer*& out);
+	bool resolve(int id, IVehicle*& out);
+	bool resolve(int id, IActor*& out);
+	bool resolve(int id, IObject*& out);
+	bool resolve(int id, IPlayerObject*& out);
+	bool resolve(int id, IGangZone*& out);
+	bool resolve(int id, IPickup*& out);
+	bool resolve(int id, ITextDraw*& out);
+	bool resolve(int id, IPlayerTextDraw*& out);
+
+	void onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason) override;
+};
+
+class BridgeWriter final
+{
+private:
+	uint8_t* data_;
+	TimePoint origin_;
+
+public:
+	BridgeWriter(uint8_t* data, TimePoint origin)
+		: data_(data)
+		, origin_(origin)
+	{
+	}
+
+	void write(const void* source, size_t size)
+	{
+		memcpy(data_, source, size);
+		data_ += size;
+	}
+
+	TimePoint getOrigin() const
+	{
+		return origin_;
+	}
+};
+
+class BridgeReader final
+{
+private:
+	const uint8_t* data_;
+	const uint8_t* end_;
+	TimePoint origin_;
+	BridgeSubjects& subjects_;
+
+public:
+	BridgeReader(const uint8_t* data, size_t size, TimePoint origin, BridgeSubjects& subjects)
+		: data_(data)
+		, end_(data + size)
+		, origin_(origin)
+		, subjects_(subjects)
+	{
+	}
+
+	/// returns a pointer to the next size bytes of the payload or null if the payload is too short
+	const uint8_t* take(size_t size)
+	{
+		if (static_cast<size_t>(end_ - data_) < size)
+		{
+			return nullptr;
+		}
+		const uint8_t* result = data_;
+		data_ += size;
+		return result;
+	}
+
+	bool read(void* destination, size_t size)
+	{
+		const uint8_t* source = take(size);
+		if (source == nullptr)
+		{
+			return false;
+		}
+		memcpy(destination, source, size);
+		return true;
+	}
+
+	TimePoint getOrigin() const
+	{
+		return origin_;
+	}
+
+	BridgeSubjects& getSubjects()
+	{
+		return subjects_;
+	}
+};
+
+//
+// argument codecs. values are stored as raw bytes, entities as their ID, time points relative to the start of the
+// recording. a codec of which read returns false causes the event to be skipped during replay.
+//
+
+template <class T, class = void>
+struct BridgeCodec
+{
+	static_assert(std::is_trivially_copyable<T>::value, "event argument type has no bridge codec");
+
+	using Holder = T;
+
+	static size_t size(const T&)
+	{
+		return sizeof(T);
+	}
+
+	static void write(BridgeWriter& writer, const T& value)
+	{
+		writer.write(&value, sizeof(T));
+	}
+
+	static bool read(BridgeReader& reader, Holder& holder)
+	{
+		return reader.read(&holder, sizeof(T));
+	}
+
+	static T& get(Holder& holder)
+	{
+		return holder;
+	}
+};
+
+template <class T>
+struct BridgeCodec<T, std::enable_if_t<std::is_base_of<IIDProvider, T>::value>>
+{
+	using Holder = T*;
+
+	static size_t size(const T&)
+	{
+		return sizeof(int32_t);
+	}
+
+	static void write(BridgeWriter& writer, const T& value)
+	{
+		const int32_t id = value.getID();
+		writer.write(&id, sizeof(id));
+	}
+
+	static bool read(BridgeReader& reader, Holder& holder)
+	{
+		int32_t id;
+		return reader.read(&id, sizeof(id)) && reader.getSubjects().resolve(id, holder);
+	}
+
+	static T& get(Holder& holder)
+	{
+		return *holder;
+	}
+};
+
+template <class T>
+struct BridgeCodec<T*, std::enable_if_t<std::is_base_of<IIDProvider, T>::value>>
+{
+	using Holder = T*;
+
+	static size_t size(T* const&)
+	{
+		return sizeof(int32_t);
+	}
+
+	static void write(BridgeWriter& writer, T* const& value)
+	{
+		const int32_t id = value ? value->getID() : -1;
+		writer.write(&id, sizeof(id));
+	}
+
+	static bool read(BridgeReader& reader, Holder& holder)
+	{
+		int32_t id;
+		if (!reader.read(&id, sizeof(id)))
+		{
+			return false;
+		}
+		if (id < 0)
+		{
+			holder = nullptr;
+			return true;
+		}
+		return reader.getSubjects().resolve(id, holder);
+	}
+
+	static T* get(Holder& holder)
+	{
+		return holder;
+	}
+};
+
+template <>
+struct BridgeCodec<StringView>
+{
+	using Holder = StringView;
+
+	static size_t size(const StringView& value)
+	{
+		return sizeof(uint32_t) + value.length();
+	}
+
+	static void write(BridgeWriter& writer, const StringView& value)
+	{
+		const uint32_t length = static_cast<uint32_t>(value.length());
+		writer.write(&length, sizeof(length));
+		writer.write(value.data(), length);
+	}
+
+	static bool read(BridgeReader& reader, Holder& holder)
+	{
+		uint32_t length;
+		if (!reader.read(&length, sizeof(length)))
+		{
+			return false;
+		}
+		const uint8_t* data = reader.take(length);
+		if (data == nullptr)
+		{
+			return false;
+		}
+		holder = StringView(reinterpret_cast<const char*>(data), length);
+		return true;
+	}
+
+	static StringView& get(Holder& holder)
+	{
+		return holder;
+	}
+};
+
+template <>
+struct BridgeCodec<TimePoint>
+{
+	using Holder = TimePoint;
+
+	static size_t size(const TimePoint&)
+	{
+		return sizeof(int64_t);
+	}
+
+	static void write(BridgeWriter& writer, const TimePoint& value)
+	{
+		const int64_t offset = std::chrono::duration_cast<std::chrono::nanoseconds>(value - writer.getOrigin()).count();
+		writer.write(&offset, sizeof(offset));
+	}
+
+	static bool read(BridgeReader& reader, Holder& holder)
+	{
+		int64_t offset;
+		if (!reader.read(&offset, sizeof(offset)))
+		{
+			return false;
+		}
+		// time points are rebased onto the start of the replay
+		holder = reader.getOrigin() + std::chrono::duration_cast<TimePoint::duration>(std::chrono::nanoseconds(offset));
+		return true;
+	}
+
+	static TimePoint& get(Holder& holder)
+	{
+		return holder;
+	}
+};
+
+template <>
+struct BridgeCodec<NetworkBitStream>
+{
+	using Holder = std::unique_ptr<NetworkBitStream>;
+
+	static size_t size(NetworkBitStream& value)
+	{
+		return sizeof(uint32_t) + value.getNumberOfBytesUsed();
+	}
+
+	static void write(BridgeWriter& writer, NetworkBitStream& value)
+	{
+		const uint32_t length = static_cast<uint32_t>(value.getNumberOfBytesUsed());
+		writer.write(&length, sizeof(length));
+		writer.write(value.getData(), length);
+	}
+
+	static bool read(BridgeReader& reader, Holder& holder)
+	{
+		uint32_t length;
+		if (!reader.read(&length, sizeof(length)))
+		{
+			return false;
+		}
+		const uint8_t* data = reader.take(length);
+		if (data == nullptr)
+		{
+			return false;
+		}
+		holder = std::make_unique<NetworkBitStream>(const_cast<uint8_t*>(data), length, true);
+		return true;
+	}
+
+	static NetworkBitStream& get(Holder& holder)
+	{
+		return *holder;
+	}
+};
+
+/// codec of an argument which cannot be reproduced; the arguments are not recorded and the event is not replayed
+template <class T>
+struct BridgeCodecUnsupported
+{
+	using Holder = T*;
+
+	static size_t size(const T&)
+	{
+		return 0;
+	}
+
+	static void write(BridgeWriter&, const T&)
+	{
+	}
+
+	static bool read(BridgeReader&, Holder&)
+	{
+		return false;
+	}
+
+	static T& get(Holder& holder)
+	{
+		return *holder;
+	}
+};
+
+template <>
+struct BridgeCodec<FlatHashSet<StringView>> : BridgeCodecUnsupported<FlatHashSet<StringView>>
+{
+};
+
+template <>
+struct BridgeCodec<ConsoleCommandSenderData> : BridgeCodecUnsupported<ConsoleCommandSenderData>
+{
+};
+
+template <class T>
+using BridgeCodecOf = BridgeCodec<std::remove_cv_t<std::remove_reference_t<T>>>;
+
+/// decodes the arguments of a recorded event for a managed handler function type and invokes the handlers
+template <class Fn>
+struct BridgeInvoker;
+
+template <class R, class... Args>
+struct BridgeInvoker<R(CORECLR_DELEGATE_CALLTYPE*)(Args...)>
+{
+	using Fn = R(CORECLR_DELEGATE_CALLTYPE*)(Args...);
+
+	/// resolve maps a target to its managed handler function
+	template <class Resolve>
+	static bool replay(BridgeReader& reader, void* const* targets, size_t count, Resolve resolve)
+	{
+		return replay(reader, targets, count, resolve, std::index_sequence_for<Args...> {});
+	}
+
+private:
+	template <class Resolve, size_t... I>
+	static bool replay(BridgeReader& reader, void* const* targets, size_t count, Resolve resolve, std::index_sequence<I...>)
+	{
+		std::tuple<typename BridgeCodecOf<Args>::Holder...> holders;
+
+		// arguments are decoded in order so per-player entities resolve against the preceding player
+		if (!(BridgeCodecOf<Args>::read(reader, std::get<I>(holders)) && ...))
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const Fn fn = resolve(targets[i]);
+			fn(BridgeCodecOf<Args>::get(std::get<I>(holders))...);
+		}
+		return true;
+	}
+};
+
+/// statistics of the bridge recorder. layout is shared with the managed BridgeRecorderStats struct
+struct BridgeRecorderStats
+{
+	uint64_t records;
+	uint64_t bytes;
+	uint64_t dropped;
+	uint64_t segments;
+	/// segments which could not be truncated to their records when closed
+	uint64_t truncateFailures;
+};
+
+/// records every event passed to a managed event handler by the event handler proxies, with its arguments and
+/// timestamp, into append-only memory-mapped segment files. only the server thread may record events.
+class BridgeRecorder final
+{
+private:
+	static BridgeRecorder* active_;
+
+	MappedFile segment_;
+	std::string prefix_;
+	size_t segmentSize_;
+	size_t offset_ = 0;
+	uint32_t segmentIndex_ = 0;
+	TimePoint origin_;
+	int64_t started_ = 0;
+	std::vector<bool> defined_;
+	uint64_t records_ = 0;
+	uint64_t bytes_ = 0;
+	uint64_t dropped_ = 0;
+	uint64_t segments_ = 0;
+	uint64_t truncateFailures_ = 0;
+
+	bool openSegment();
+
+	void closeSegment();
+
+	/// reserves space for an event record with a payload of the specified size, starting a new segment if needed.
+	/// returns a pointer to the payload or null if the record was dropped
+	uint8_t* reserve(const BridgeEvent& event, size_t size);
+
+public:
+	explicit BridgeRecorder(size_t segment_size);
+
+	BridgeRecorder(const BridgeRecorder&) = delete;
+	BridgeRecorder& operator=(const BridgeRecorder&) = delete;
+
+	~BridgeRecorder();
+
+	/// the recorder which is currently recording or null
+	static BridgeRecorder* getActive()
+	{
+		return active_;
+	}
+
+	static std::string getSegmentPath(const std::string& prefix, uint32_t segment);
+
+	/// starts recording to segment files with the specified path prefix. returns false if a recording is in progress
+	/// or the first segment cannot be created
+	bool start(StringView prefix);
+
+	void stop();
+
+	bool isRecording() const;
+
+	void getStats(BridgeRecorderStats& stats) const;
+
+	template <class... Args>
+	void record(const BridgeEvent& event, Args&... args)
+	{
+		const size_t size = (static_cast<size_t>(0) + ... + BridgeCodecOf<Args>::size(args));
+
+		uint8_t* data = reserve(event, size);
+		if (data == nullptr)
+		{
+			return;
+		}
+
+		BridgeWriter writer(data, origin_);
+		(BridgeCodecOf<Args>::write(writer, args), ...);
+	}
+};
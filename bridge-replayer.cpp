@@ -0,0 +1,251 @@
+#include "bridge-replayer.hpp"
+
+#include <chrono>
+#include <limits>
+
+static int64_t nanosecondsBetween(TimePoint from, TimePoint to)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+}
+
+void BridgeReplayer::attach(ICore* core, IComponentList* components)
+{
+	core_ = core;
+	subjects_.attach(core, components);
+	connectEvent_ = BridgeEvent::find("PlayerConnectEventHandler.onPlayerConnect");
+	disconnectEvent_ = BridgeEvent::find("PlayerConnectEventHandler.onPlayerDisconnect");
+}
+
+void BridgeReplayer::onFree(IComponent* component)
+{
+	subjects_.onFree(component);
+}
+
+void BridgeReplayer::detach()
+{
+	stop();
+	subjects_.detach();
+	core_ = nullptr;
+}
+
+bool BridgeReplayer::start(StringView prefix, BridgeReplayMode mode)
+{
+	if (isReplaying() || core_ == nullptr)
+	{
+		return false;
+	}
+
+	prefix_ = prefix.to_string();
+	if (!openSegment(0))
+	{
+		return false;
+	}
+
+	mode_ = mode;
+	stats_ = BridgeReplayStats {};
+	origin_ = std::chrono::steady_clock::now();
+	return true;
+}
+
+void BridgeReplayer::stop()
+{
+	segment_.close();
+	events_.clear();
+
+	// a handler which stops the replay may still use its arguments; the tick destroys the stand-ins after it returns
+	if (!dispatching_)
+	{
+		subjects_.clear();
+	}
+}
+
+bool BridgeReplayer::isReplaying() const
+{
+	return segment_.isOpen();
+}
+
+void BridgeReplayer::getStats(BridgeReplayStats& stats) const
+{
+	stats = stats_;
+}
+
+bool BridgeReplayer::openSegment(uint32_t segment)
+{
+	segment_.close();
+	events_.clear();
+
+	if (!segment_.open(BridgeRecorder::getSegmentPath(prefix_, segment)))
+	{
+		return false;
+	}
+
+	BridgeSegmentHeader header;
+	if (segment_.size() < sizeof(header))
+	{
+		segment_.close();
+		return false;
+	}
+
+	memcpy(&header, segment_.data(), sizeof(header));
+	if (header.magic != BRIDGE_RECORDING_MAGIC || header.version != BRIDGE_RECORDING_VERSION)
+	{
+		segment_.close();
+		return false;
+	}
+
+	segmentIndex_ = segment;
+	offset_ = alignBridgeRecord(sizeof(header));
+	return true;
+}
+
+void BridgeReplayer::finish()
+{
+	stop();
+
+	core_->printLn("bridge replay of %s finished: %llu events, %llu replayed, %llu skipped, %llu handler invocations, "
+				   "%.3f ms in handlers, %.3f ms total, %.3f ms recorded",
+		prefix_.c_str(),
+		static_cast<unsigned long long>(stats_.records),
+		static_cast<unsigned long long>(stats_.replayed),
+		static_cast<unsigned long long>(stats_.skipped),
+		static_cast<unsigned long long>(stats_.invocations),
+		stats_.handlerNanoseconds / 1e6,
+		stats_.elapsedNanoseconds / 1e6,
+		stats_.recordedNanoseconds / 1e6);
+}
+
+void BridgeReplayer::tick()
+{
+	if (!isReplaying())
+	{
+		return;
+	}
+
+	const TimePoint start = std::chrono::steady_clock::now();
+	const int64_t due = mode_ == BridgeReplayMode_Maximum
+		? std::numeric_limits<int64_t>::max()
+		: nanosecondsBetween(origin_, start);
+
+	for (;;)
+	{
+		BridgeRecordHeader header;
+		if (offset_ + sizeof(header) <= segment_.size())
+		{
+			memcpy(&header, segment_.data() + offset_, sizeof(header));
+		}
+		else
+		{
+			header.kind = BridgeRecordKind_End;
+		}
+
+		if (header.kind == BridgeRecordKind_End)
+		{
+			if (!openSegment(segmentIndex_ + 1))
+			{
+				stats_.elapsedNanoseconds += nanosecondsBetween(start, std::chrono::steady_clock::now());
+				finish();
+				return;
+			}
+			continue;
+		}
+
+		if (header.kind == BridgeRecordKind_Event && header.time > due)
+		{
+			break;
+		}
+
+		const size_t payload = offset_ + sizeof(header);
+		if (payload + header.size > segment_.size())
+		{
+			// truncated record; treat as the end of the segment
+			offset_ = segment_.size();
+			continue;
+		}
+
+		dispatching_ = true;
+		dispatch(header, segment_.data() + payload);
+		dispatching_ = false;
+		if (!isReplaying())
+		{
+			// stopped by a handler
+			subjects_.clear();
+			return;
+		}
+		offset_ += alignBridgeRecord(sizeof(header) + header.size);
+	}
+
+	stats_.elapsedNanoseconds += nanosecondsBetween(start, std::chrono::steady_clock::now());
+}
+
+void BridgeReplayer::dispatch(const BridgeRecordHeader& header, const uint8_t* payload)
+{
+	if (header.kind == BridgeRecordKind_Definition)
+	{
+		// indices differ between builds; events are matched by name
+		if (events_.size() <= header.event)
+		{
+			events_.resize(header.event + 1);
+		}
+		events_[header.event] = BridgeEvent::find(StringView(reinterpret_cast<const char*>(payload), header.size));
+		return;
+	}
+
+	if (header.kind != BridgeRecordKind_Event)
+	{
+		return;
+	}
+
+	stats_.records++;
+	stats_.recordedNanoseconds = static_cast<uint64_t>(header.time);
+
+	const BridgeEvent* event = header.event < events_.size() ? events_[header.event] : nullptr;
+	if (event == nullptr)
+	{
+		stats_.skipped++;
+		return;
+	}
+
+	if (event == connectEvent_ || event == disconnectEvent_)
+	{
+		// stand-in players connect when they are created and disconnect when they are destroyed. the server dispatches
+		// both to the handlers, so the recorded event is replayed as the connect or disconnect of the stand-in. the
+		// player is the first argument of both events
+		int32_t id;
+		if (header.size < sizeof(id))
+		{
+			stats_.skipped++;
+			return;
+		}
+		memcpy(&id, payload, sizeof(id));
+
+		const TimePoint start = std::chrono::steady_clock::now();
+		if (event == connectEvent_ ? subjects_.connect(id) : subjects_.disconnect(id))
+		{
+			stats_.handlerNanoseconds += nanosecondsBetween(start, std::chrono::steady_clock::now());
+			stats_.replayed++;
+		}
+		else
+		{
+			stats_.skipped++;
+		}
+		return;
+	}
+
+	targets_.clear();
+	BridgeTarget::collect(event->getHandler(), targets_);
+
+	subjects_.resetOwner();
+	BridgeReader reader(payload, header.size, origin_, subjects_);
+
+	const TimePoint start = std::chrono::steady_clock::now();
+	if (event->replay(reader, targets_.data(), targets_.size()))
+	{
+		stats_.handlerNanoseconds += nanosecondsBetween(start, std::chrono::steady_clock::now());
+		stats_.replayed++;
+		stats_.invocations += targets_.size();
+	}
+	else
+	{
+		stats_.skipped++;
+	}
+}
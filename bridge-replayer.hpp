@@ -0,0 +1,91 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bridge-recorder.hpp"
+#include "mapped-file.hpp"
+
+using namespace Impl;
+
+enum BridgeReplayMode : uint8_t
+{
+	/// events are replayed with the timing at which they were recorded
+	BridgeReplayMode_Recorded,
+	/// all events are replayed during the next tick
+	BridgeReplayMode_Maximum,
+};
+
+/// statistics of the bridge replayer. layout is shared with the managed BridgeReplayStats struct
+struct BridgeReplayStats
+{
+	uint64_t records;
+	uint64_t replayed;
+	/// events which could not be replayed because an argument was not recorded or an entity could not be mapped
+	uint64_t skipped;
+	/// number of managed handler invocations. connects and disconnects of stand-in players are dispatched by the server
+	/// and not counted
+	uint64_t invocations;
+	/// time spent in managed handlers
+	uint64_t handlerNanoseconds;
+	/// time spent replaying, including decoding
+	uint64_t elapsedNanoseconds;
+	/// recorded time of the last replayed event
+	uint64_t recordedNanoseconds;
+};
+
+/// feeds a recording of the bridge recorder back into the managed event handlers. entity arguments are mapped to live
+/// entities and stand-ins by BridgeSubjects, so a recording can be replayed in a benchmark without the players and
+/// entities of the recording. the stand-ins are destroyed when the replay ends.
+class BridgeReplayer final
+{
+private:
+	ICore* core_ = nullptr;
+	BridgeSubjects subjects_;
+	const BridgeEvent* connectEvent_ = nullptr;
+	const BridgeEvent* disconnectEvent_ = nullptr;
+	bool dispatching_ = false;
+	MappedFile segment_;
+	std::string prefix_;
+	uint32_t segmentIndex_ = 0;
+	size_t offset_ = 0;
+	BridgeReplayMode mode_ = BridgeReplayMode_Recorded;
+	TimePoint origin_;
+	std::vector<const BridgeEvent*> events_;
+	std::vector<void*> targets_;
+	BridgeReplayStats stats_ {};
+
+	bool openSegment(uint32_t segment);
+
+	void finish();
+
+	void dispatch(const BridgeRecordHeader& header, const uint8_t* payload);
+
+public:
+	BridgeReplayer() = default;
+
+	BridgeReplayer(const BridgeReplayer&) = delete;
+	BridgeReplayer& operator=(const BridgeReplayer&) = delete;
+
+	void attach(ICore* core, IComponentList* components);
+
+	void onFree(IComponent* component);
+
+	void detach();
+
+	/// starts replaying the recording with the specified path prefix. returns false if a replay is in progress or the
+	/// first segment cannot be opened
+	bool start(StringView prefix, BridgeReplayMode mode);
+
+	void stop();
+
+	bool isReplaying() const;
+
+	void getStats(BridgeReplayStats& stats) const;
+
+	/// replays the events which are due. must be called from the tick of the component
+	void tick();
+};
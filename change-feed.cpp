@@ -0,0 +1,377 @@
+#include "change-feed.hpp"
+
+#include <initializer_list>
+
+static bool changed(const Vector3& a, const Vector3& b)
+{
+	return a.x != b.x || a.y != b.y || a.z != b.z;
+}
+
+ChangeFeed::ChangeFeed()
+{
+	playerChanges_.pending.resize(PLAYER_POOL_SIZE);
+	playerChanges_.published.resize(PLAYER_POOL_SIZE);
+	vehicleChanges_.pending.resize(VEHICLE_POOL_SIZE);
+	vehicleChanges_.published.resize(VEHICLE_POOL_SIZE);
+}
+
+ChangeFeed::~ChangeFeed()
+{
+	detach();
+}
+
+void ChangeFeed::attach(ICore* core, IComponentList* components)
+{
+	core_ = core;
+
+	IPlayerPool& players = core_->getPlayers();
+	players.getPlayerConnectDispatcher().addEventHandler(this);
+	players.getPlayerChangeDispatcher().addEventHandler(this);
+	players.getPlayerSpawnDispatcher().addEventHandler(this);
+	players.getPlayerDamageDispatcher().addEventHandler(this);
+
+	// same priority as the sync validator, which is attached first, so rejected updates are not recorded
+	players.getPlayerUpdateDispatcher().addEventHandler(this, EventPriority_FairlyHigh);
+
+	vehicles_ = components->queryComponent<IVehiclesComponent>();
+	if (vehicles_ != nullptr)
+	{
+		vehicles_->getEventDispatcher().addEventHandler(this);
+		vehicles_->getPoolEventDispatcher().addEventHandler(this);
+	}
+}
+
+void ChangeFeed::onFree(IComponent* component)
+{
+	if (component == vehicles_)
+	{
+		vehicles_ = nullptr;
+	}
+}
+
+void ChangeFeed::detach()
+{
+	if (vehicles_ != nullptr)
+	{
+		vehicles_->getEventDispatcher().removeEventHandler(this);
+		vehicles_->getPoolEventDispatcher().removeEventHandler(this);
+		vehicles_ = nullptr;
+	}
+
+	if (core_ != nullptr)
+	{
+		IPlayerPool& players = core_->getPlayers();
+		players.getPlayerConnectDispatcher().removeEventHandler(this);
+		players.getPlayerChangeDispatcher().removeEventHandler(this);
+		players.getPlayerSpawnDispatcher().removeEventHandler(this);
+		players.getPlayerDamageDispatcher().removeEventHandler(this);
+		players.getPlayerUpdateDispatcher().removeEventHandler(this);
+		core_ = nullptr;
+	}
+}
+
+ChangeFeed::Channel* ChangeFeed::getChannel(EntityTableType type)
+{
+	switch (type)
+	{
+	case EntityTableType_Player:
+		return &playerChanges_;
+	case EntityTableType_Vehicle:
+		return &vehicleChanges_;
+	default:
+		return nullptr;
+	}
+}
+
+const ChangeFeed::Channel* ChangeFeed::getChannel(EntityTableType type) const
+{
+	return const_cast<ChangeFeed*>(this)->getChannel(type);
+}
+
+void ChangeFeed::mark(Channel& channel, int id, uint32_t mask)
+{
+	if (id < 0 || static_cast<size_t>(id) >= channel.pending.size())
+	{
+		return;
+	}
+
+	uint32_t& pending = channel.pending[id];
+	if (pending == 0)
+	{
+		channel.dirty.push_back(id);
+	}
+	pending |= mask;
+}
+
+void ChangeFeed::markPlayer(IPlayer& player, uint32_t mask)
+{
+	mark(playerChanges_, player.getID(), mask);
+}
+
+void ChangeFeed::markVehicle(IVehicle& vehicle, uint32_t mask)
+{
+	mark(vehicleChanges_, vehicle.getID(), mask);
+}
+
+void ChangeFeed::track(IPlayer& player)
+{
+	const int id = player.getID();
+	if (id < 0 || static_cast<size_t>(id) >= PLAYER_POOL_SIZE)
+	{
+		return;
+	}
+
+	TrackedPlayer& tracked = trackedPlayers_[id];
+	uint32_t mask = 0;
+
+	const Vector3 position = player.getPosition();
+	if (changed(position, tracked.position))
+	{
+		mask |= PlayerChange_Position;
+		tracked.position = position;
+	}
+
+	const float health = player.getHealth();
+	if (health != tracked.health)
+	{
+		mask |= PlayerChange_Health;
+		tracked.health = health;
+	}
+
+	const float armour = player.getArmour();
+	if (armour != tracked.armour)
+	{
+		mask |= PlayerChange_Armour;
+		tracked.armour = armour;
+	}
+
+	const uint32_t weapon = player.getArmedWeapon();
+	if (weapon != tracked.weapon)
+	{
+		mask |= PlayerChange_Weapon;
+		tracked.weapon = weapon;
+	}
+
+	if (mask != 0)
+	{
+		mark(playerChanges_, id, mask);
+	}
+}
+
+void ChangeFeed::track(IVehicle& vehicle)
+{
+	const int id = vehicle.getID();
+	if (id < 0 || static_cast<size_t>(id) >= VEHICLE_POOL_SIZE)
+	{
+		return;
+	}
+
+	TrackedVehicle& tracked = trackedVehicles_[id];
+	uint32_t mask = 0;
+
+	const Vector3 position = vehicle.getPosition();
+	if (changed(position, tracked.position))
+	{
+		mask |= VehicleChange_Position;
+		tracked.position = position;
+	}
+
+	const float health = vehicle.getHealth();
+	if (health != tracked.health)
+	{
+		mask |= VehicleChange_Health;
+		tracked.health = health;
+	}
+
+	if (mask != 0)
+	{
+		mark(vehicleChanges_, id, mask);
+	}
+}
+
+void ChangeFeed::publish()
+{
+	for (Channel* channel : { &playerChanges_, &vehicleChanges_ })
+	{
+		for (const EntityChange& change : channel->changes)
+		{
+			channel->published[change.id] = 0;
+		}
+		channel->changes.clear();
+
+		for (int id : channel->dirty)
+		{
+			const uint32_t mask = channel->pending[id];
+			channel->changes.push_back(EntityChange { id, mask });
+			channel->published[id] = mask;
+			channel->pending[id] = 0;
+		}
+		channel->dirty.clear();
+	}
+}
+
+const EntityChange* ChangeFeed::getChanges(EntityTableType type) const
+{
+	const Channel* channel = getChannel(type);
+	return channel ? channel->changes.data() : nullptr;
+}
+
+size_t ChangeFeed::getChangeCount(EntityTableType type) const
+{
+	const Channel* channel = getChannel(type);
+	return channel ? channel->changes.size() : 0;
+}
+
+uint32_t ChangeFeed::getMask(EntityTableType type, int id) const
+{
+	const Channel* channel = getChannel(type);
+	if (channel == nullptr || id < 0 || static_cast<size_t>(id) >= channel->published.size())
+	{
+		return 0;
+	}
+	return channel->published[id];
+}
+
+void ChangeFeed::onPlayerConnect(IPlayer& player)
+{
+	markPlayer(player, PlayerChange_Connected);
+
+	// the first sync is compared with the state at connection
+	const int id = player.getID();
+	if (id >= 0 && static_cast<size_t>(id) < PLAYER_POOL_SIZE)
+	{
+		trackedPlayers_[id] = TrackedPlayer { player.getPosition(), player.getHealth(), player.getArmour(), player.getArmedWeapon() };
+	}
+}
+
+void ChangeFeed::onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason)
+{
+	markPlayer(player, PlayerChange_Disconnected);
+}
+
+void ChangeFeed::onPlayerScoreChange(IPlayer& player, int score)
+{
+	markPlayer(player, PlayerChange_Score);
+}
+
+void ChangeFeed::onPlayerNameChange(IPlayer& player, StringView oldName)
+{
+	markPlayer(player, PlayerChange_Name);
+}
+
+void ChangeFeed::onPlayerInteriorChange(IPlayer& player, unsigned newInterior, unsigned oldInterior)
+{
+	markPlayer(player, PlayerChange_Interior);
+}
+
+void ChangeFeed::onPlayerStateChange(IPlayer& player, PlayerState newState, PlayerState oldState)
+{
+	markPlayer(player, PlayerChange_State);
+}
+
+void ChangeFeed::onPlayerKeyStateChange(IPlayer& player, uint32_t newKeys, uint32_t oldKeys)
+{
+	markPlayer(player, PlayerChange_Keys);
+}
+
+bool ChangeFeed::onPlayerUpdate(IPlayer& player, TimePoint now)
+{
+	track(player);
+
+	if (player.getState() == PlayerState_Driver)
+	{
+		IPlayerVehicleData* data = queryExtension<IPlayerVehicleData>(player);
+		IVehicle* vehicle = data ? data->getVehicle() : nullptr;
+
+		if (vehicle != nullptr)
+		{
+			track(*vehicle);
+		}
+	}
+	return true;
+}
+
+void ChangeFeed::onPlayerSpawn(IPlayer& player)
+{
+	markPlayer(player, PlayerChange_Spawned);
+}
+
+void ChangeFeed::onPlayerDeath(IPlayer& player, IPlayer* killer, int reason)
+{
+	markPlayer(player, PlayerChange_Died);
+}
+
+void ChangeFeed::onVehicleSpawn(IVehicle& vehicle)
+{
+	markVehicle(vehicle, VehicleChange_Spawned);
+	track(vehicle);
+}
+
+void ChangeFeed::onVehicleDeath(IVehicle& vehicle, IPlayer& player)
+{
+	markVehicle(vehicle, VehicleChange_Died);
+}
+
+void ChangeFeed::onPlayerEnterVehicle(IPlayer& player, IVehicle& vehicle, bool passenger)
+{
+	markPlayer(player, PlayerChange_Vehicle);
+	markVehicle(vehicle, VehicleChange_Occupants);
+}
+
+void ChangeFeed::onPlayerExitVehicle(IPlayer& player, IVehicle& vehicle)
+{
+	markPlayer(player, PlayerChange_Vehicle);
+	markVehicle(vehicle, VehicleChange_Occupants);
+}
+
+void ChangeFeed::onVehicleDamageStatusUpdate(IVehicle& vehicle, IPlayer& player)
+{
+	markVehicle(vehicle, VehicleChange_DamageStatus);
+}
+
+bool ChangeFeed::onVehiclePaintJob(IPlayer& player, IVehicle& vehicle, int paintJob)
+{
+	markVehicle(vehicle, VehicleChange_Appearance);
+	return true;
+}
+
+bool ChangeFeed::onVehicleMod(IPlayer& player, IVehicle& vehicle, int component)
+{
+	markVehicle(vehicle, VehicleChange_Appearance);
+	return true;
+}
+
+bool ChangeFeed::onVehicleRespray(IPlayer& player, IVehicle& vehicle, int colour1, int colour2)
+{
+	markVehicle(vehicle, VehicleChange_Appearance);
+	return true;
+}
+
+bool ChangeFeed::onUnoccupiedVehicleUpdate(IVehicle& vehicle, IPlayer& player, UnoccupiedVehicleUpdate const updateData)
+{
+	// the update is applied after the handlers accepted it
+	markVehicle(vehicle, VehicleChange_Position);
+	return true;
+}
+
+bool ChangeFeed::onTrailerUpdate(IPlayer& player, IVehicle& trailer)
+{
+	markVehicle(trailer, VehicleChange_Position);
+	return true;
+}
+
+void ChangeFeed::onPoolEntryCreated(IVehicle& entry)
+{
+	markVehicle(entry, VehicleChange_Created);
+
+	const int id = entry.getID();
+	if (id >= 0 && static_cast<size_t>(id) < VEHICLE_POOL_SIZE)
+	{
+		trackedVehicles_[id] = TrackedVehicle { entry.getPosition(), entry.getHealth() };
+	}
+}
+
+void ChangeFeed::onPoolEntryDestroyed(IVehicle& entry)
+{
+	markVehicle(entry, VehicleChange_Destroyed);
+}
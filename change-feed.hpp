@@ -0,0 +1,185 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/Vehicles/vehicles.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "entity-table.hpp"
+
+using namespace Impl;
+
+enum PlayerChange : uint32_t
+{
+	PlayerChange_Connected = 1 << 0,
+	PlayerChange_Disconnected = 1 << 1,
+	PlayerChange_Spawned = 1 << 2,
+	PlayerChange_Died = 1 << 3,
+	PlayerChange_Position = 1 << 4,
+	PlayerChange_Health = 1 << 5,
+	PlayerChange_Armour = 1 << 6,
+	PlayerChange_Weapon = 1 << 7,
+	PlayerChange_State = 1 << 8,
+	PlayerChange_Keys = 1 << 9,
+	PlayerChange_Interior = 1 << 10,
+	PlayerChange_Score = 1 << 11,
+	PlayerChange_Name = 1 << 12,
+	/// the player entered or exited a vehicle
+	PlayerChange_Vehicle = 1 << 13,
+};
+
+enum VehicleChange : uint32_t
+{
+	VehicleChange_Created = 1 << 0,
+	VehicleChange_Destroyed = 1 << 1,
+	VehicleChange_Spawned = 1 << 2,
+	VehicleChange_Died = 1 << 3,
+	VehicleChange_Position = 1 << 4,
+	VehicleChange_Health = 1 << 5,
+	VehicleChange_DamageStatus = 1 << 6,
+	/// a player entered or exited the vehicle
+	VehicleChange_Occupants = 1 << 7,
+	/// paint job, modification or colours; also set when the change is rejected by another handler
+	VehicleChange_Appearance = 1 << 8,
+};
+
+/// entity which changed during a tick and the properties which changed. layout is shared with the managed EntityChange
+/// struct
+struct EntityChange
+{
+	int32_t id;
+	uint32_t mask;
+};
+
+/// tracks which properties of players and vehicles change, fed by event handlers and sync updates. changes are
+/// accumulated into a bitmask per entity and published at the start of the tick of the component as a compact list of
+/// the entities which changed since the previous tick. properties which are not reported by an event (position,
+/// health, armour and weapon of players; position and health of vehicles) are compared with the previous sync of the
+/// player or driver.
+class ChangeFeed final
+	: public PlayerConnectEventHandler
+	, public PlayerChangeEventHandler
+	, public PlayerUpdateEventHandler
+	, public PlayerSpawnEventHandler
+	, public PlayerDamageEventHandler
+	, public VehicleEventHandler
+	, public PoolEventHandler<IVehicle>
+{
+private:
+	struct Channel
+	{
+		/// masks accumulated during the current tick
+		std::vector<uint32_t> pending;
+		/// masks of the previous tick
+		std::vector<uint32_t> published;
+		/// entities with a pending mask in the order in which they first changed
+		std::vector<int> dirty;
+		std::vector<EntityChange> changes;
+	};
+
+	struct TrackedPlayer
+	{
+		Vector3 position;
+		float health;
+		float armour;
+		uint32_t weapon;
+	};
+
+	struct TrackedVehicle
+	{
+		Vector3 position;
+		float health;
+	};
+
+	ICore* core_ = nullptr;
+	IVehiclesComponent* vehicles_ = nullptr;
+	Channel playerChanges_;
+	Channel vehicleChanges_;
+	TrackedPlayer trackedPlayers_[PLAYER_POOL_SIZE] {};
+	TrackedVehicle trackedVehicles_[VEHICLE_POOL_SIZE] {};
+
+	Channel* getChannel(EntityTableType type);
+
+	const Channel* getChannel(EntityTableType type) const;
+
+	void mark(Channel& channel, int id, uint32_t mask);
+
+	void markPlayer(IPlayer& player, uint32_t mask);
+
+	void markVehicle(IVehicle& vehicle, uint32_t mask);
+
+	void track(IPlayer& player);
+
+	void track(IVehicle& vehicle);
+
+public:
+	ChangeFeed();
+
+	ChangeFeed(const ChangeFeed&) = delete;
+	ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+	~ChangeFeed();
+
+	void attach(ICore* core, IComponentList* components);
+
+	void onFree(IComponent* component);
+
+	void detach();
+
+	/// publishes the changes accumulated since the previous call. must be called from the tick of the component
+	void publish();
+
+	/// changes of the previous tick of the entity type. only players and vehicles are tracked; other types have no
+	/// changes
+	const EntityChange* getChanges(EntityTableType type) const;
+
+	size_t getChangeCount(EntityTableType type) const;
+
+	/// mask of the properties of the entity which changed during the previous tick
+	uint32_t getMask(EntityTableType type, int id) const;
+
+	void onPlayerConnect(IPlayer& player) override;
+
+	void onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason) override;
+
+	void onPlayerScoreChange(IPlayer& player, int score) override;
+
+	void onPlayerNameChange(IPlayer& player, StringView oldName) override;
+
+	void onPlayerInteriorChange(IPlayer& player, unsigned newInterior, unsigned oldInterior) override;
+
+	void onPlayerStateChange(IPlayer& player, PlayerState newState, PlayerState oldState) override;
+
+	void onPlayerKeyStateChange(IPlayer& player, uint32_t newKeys, uint32_t oldKeys) override;
+
+	bool onPlayerUpdate(IPlayer& player, TimePoint now) override;
+
+	void onPlayerSpawn(IPlayer& player) override;
+
+	void onPlayerDeath(IPlayer& player, IPlayer* killer, int reason) override;
+
+	void onVehicleSpawn(IVehicle& vehicle) override;
+
+	void onVehicleDeath(IVehicle& vehicle, IPlayer& player) override;
+
+	void onPlayerEnterVehicle(IPlayer& player, IVehicle& vehicle, bool passenger) override;
+
+	void onPlayerExitVehicle(IPlayer& player, IVehicle& vehicle) override;
+
+	void onVehicleDamageStatusUpdate(IVehicle& vehicle, IPlayer& player) override;
+
+	bool onVehiclePaintJob(IPlayer& player, IVehicle& vehicle, int paintJob) override;
+
+	bool onVehicleMod(IPlayer& player, IVehicle& vehicle, int component) override;
+
+	bool onVehicleRespray(IPlayer& player, IVehicle& vehicle, int colour1, int colour2) override;
+
+	bool onUnoccupiedVehicleUpdate(IVehicle& vehicle, IPlayer& player, UnoccupiedVehicleUpdate const updateData) override;
+
+	bool onTrailerUpdate(IPlayer& player, IVehicle& trailer) override;
+
+	void onPoolEntryCreated(IVehicle& entry) override;
+
+	void onPoolEntryDestroyed(IVehicle& entry) override;
+};
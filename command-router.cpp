@@ -0,0 +1,234 @@
+#include "command-router.hpp"
+
+static bool isSpace(char c)
+{
+	return c == ' ' || c == '\t';
+}
+
+static char toLower(char c)
+{
+	return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+CommandRouter::CommandRouter()
+{
+	clear();
+}
+
+CommandRouter::~CommandRouter()
+{
+	detach();
+}
+
+void CommandRouter::attach(ICore* core)
+{
+	core_ = core;
+
+	// run before any (managed) handler so routed and unknown commands never reach them
+	core_->getPlayers().getPlayerTextDispatcher().addEventHandler(this, EventPriority_FairlyHigh);
+}
+
+void CommandRouter::detach()
+{
+	if (core_ != nullptr)
+	{
+		core_->getPlayers().getPlayerTextDispatcher().removeEventHandler(this);
+		core_ = nullptr;
+	}
+}
+
+void CommandRouter::setHandler(command_handler_fn handler)
+{
+	handler_ = handler;
+}
+
+int CommandRouter::findNode(StringView name, bool create)
+{
+	int node = 0;
+
+	for (size_t i = 0; i < name.size(); i++)
+	{
+		const char c = toLower(name[i]);
+		int next = NO_NODE;
+
+		for (const auto& child : nodes_[node].children)
+		{
+			if (child.first == c)
+			{
+				next = static_cast<int>(child.second);
+				break;
+			}
+		}
+
+		if (next == NO_NODE)
+		{
+			if (!create)
+			{
+				return NO_NODE;
+			}
+
+			next = static_cast<int>(nodes_.size());
+			nodes_[node].children.emplace_back(c, static_cast<uint32_t>(next));
+			nodes_.emplace_back();
+		}
+
+		node = next;
+	}
+
+	return node;
+}
+
+bool CommandRouter::addCommand(StringView name, int id)
+{
+	if (name.empty() || id < 0)
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < name.size(); i++)
+	{
+		if (isSpace(name[i]))
+		{
+			return false;
+		}
+	}
+
+	const int node = findNode(name, true);
+	if (nodes_[node].id != NO_COMMAND)
+	{
+		return false;
+	}
+
+	nodes_[node].id = id;
+	return true;
+}
+
+bool CommandRouter::addAlias(StringView alias, StringView name)
+{
+	const int id = find(name);
+	return id != NO_COMMAND && addCommand(alias, id);
+}
+
+bool CommandRouter::removeName(StringView name)
+{
+	const int node = findNode(name, false);
+	if (node == NO_NODE || nodes_[node].id == NO_COMMAND)
+	{
+		return false;
+	}
+
+	nodes_[node].id = NO_COMMAND;
+	return true;
+}
+
+void CommandRouter::removeCommand(int id)
+{
+	for (TrieNode& node : nodes_)
+	{
+		if (node.id == id)
+		{
+			node.id = NO_COMMAND;
+		}
+	}
+}
+
+void CommandRouter::clear()
+{
+	// node 0 is the root; it matches the empty name which cannot be registered
+	nodes_.assign(1, TrieNode {});
+}
+
+int CommandRouter::find(StringView name)
+{
+	const int node = findNode(name, false);
+	return node == NO_NODE ? NO_COMMAND : nodes_[node].id;
+}
+
+void CommandRouter::setDefaultReply(StringView message, Colour colour)
+{
+	defaultReply_ = message.to_string();
+	defaultReplyColour_ = colour;
+}
+
+void CommandRouter::getStats(CommandRouterStats& stats) const
+{
+	stats = stats_;
+}
+
+size_t CommandRouter::tokenise(StringView text, size_t offset, CommandArgument* arguments)
+{
+	size_t count = 0;
+	size_t i = offset;
+
+	while (count < MAX_ARGUMENTS)
+	{
+		while (i < text.size() && isSpace(text[i]))
+		{
+			i++;
+		}
+
+		if (i == text.size())
+		{
+			break;
+		}
+
+		const size_t start = i;
+		if (count == MAX_ARGUMENTS - 1)
+		{
+			// the last argument spans the remaining text
+			i = text.size();
+			while (isSpace(text[i - 1]))
+			{
+				i--;
+			}
+		}
+		else
+		{
+			while (i < text.size() && !isSpace(text[i]))
+			{
+				i++;
+			}
+		}
+
+		arguments[count++] = { static_cast<uint32_t>(start), static_cast<uint32_t>(i - start) };
+	}
+
+	return count;
+}
+
+bool CommandRouter::onPlayerCommandText(IPlayer& player, StringView message)
+{
+	const size_t start = !message.empty() && message[0] == '/' ? 1 : 0;
+	size_t end = start;
+	while (end < message.size() && !isSpace(message[end]))
+	{
+		end++;
+	}
+
+	const int id = find(StringView(message.data() + start, end - start));
+	if (id == NO_COMMAND)
+	{
+		stats_.unknown++;
+
+		if (defaultReply_.empty())
+		{
+			return false;
+		}
+
+		player.sendClientMessage(defaultReplyColour_, defaultReply_);
+		stats_.replied++;
+		return true;
+	}
+
+	if (handler_ == nullptr)
+	{
+		return false;
+	}
+
+	// arguments live on the stack so a handler may route another command
+	CommandArgument arguments[MAX_ARGUMENTS];
+	const size_t count = tokenise(message, end, arguments);
+
+	stats_.routed++;
+	return handler_(player, id, message, arguments, count);
+}
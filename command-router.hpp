@@ -0,0 +1,110 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dotnet/coreclr_delegates.h"
+
+using namespace Impl;
+
+/// argument of a routed command as a range of the command text. layout is shared with the managed CommandArgument
+/// struct
+struct CommandArgument
+{
+	uint32_t offset;
+	uint32_t length;
+};
+
+/// statistics of the command router. layout is shared with the managed CommandRouterStats struct
+struct CommandRouterStats
+{
+	/// commands passed to the managed handler
+	uint64_t routed;
+	/// commands which did not match a registered name
+	uint64_t unknown;
+	/// unknown commands answered with the default reply
+	uint64_t replied;
+};
+
+/// handler of routed commands. the arguments point into the command text and are only valid during the call. returns
+/// true if the command was handled
+typedef bool (CORECLR_DELEGATE_CALLTYPE *command_handler_fn)(IPlayer&, int id, StringView text, const CommandArgument* arguments, size_t count);
+
+/// matches player commands against registered names before they reach the managed event handlers. names are matched
+/// case-insensitively with a trie; multiple names (aliases) may share a command ID. the arguments are tokenised by
+/// whitespace into offsets of the command text. unknown commands are answered natively with the default reply if one
+/// is set, otherwise they continue to the other handlers of onPlayerCommandText.
+class CommandRouter final : public PlayerTextEventHandler
+{
+public:
+	/// arguments beyond this number are included in the last argument
+	static constexpr size_t MAX_ARGUMENTS = 32;
+
+private:
+	static constexpr int NO_COMMAND = -1;
+	static constexpr int NO_NODE = -1;
+
+	struct TrieNode
+	{
+		int id = NO_COMMAND;
+		/// children keyed by lowercase character, in insertion order
+		std::vector<std::pair<char, uint32_t>> children;
+	};
+
+	ICore* core_ = nullptr;
+	std::vector<TrieNode> nodes_;
+	command_handler_fn handler_ = nullptr;
+	std::string defaultReply_;
+	Colour defaultReplyColour_ {};
+	CommandRouterStats stats_ {};
+
+	/// returns the node of the name or NO_NODE if the name was not inserted and create is false
+	int findNode(StringView name, bool create);
+
+	/// splits the text following offset into arguments; returns the number of arguments
+	static size_t tokenise(StringView text, size_t offset, CommandArgument* arguments);
+
+public:
+	CommandRouter();
+
+	CommandRouter(const CommandRouter&) = delete;
+	CommandRouter& operator=(const CommandRouter&) = delete;
+
+	~CommandRouter();
+
+	void attach(ICore* core);
+
+	void detach();
+
+	void setHandler(command_handler_fn handler);
+
+	/// registers a command name with the specified ID. returns false if the name is empty, contains whitespace or is
+	/// already registered
+	bool addCommand(StringView name, int id);
+
+	/// registers an alias for the command registered as name. returns false if name is not registered or the alias
+	/// cannot be registered
+	bool addAlias(StringView alias, StringView name);
+
+	/// unregisters a single name
+	bool removeName(StringView name);
+
+	/// unregisters all names of the command with the specified ID
+	void removeCommand(int id);
+
+	void clear();
+
+	/// returns the ID of the command registered as name or -1
+	int find(StringView name);
+
+	/// sets the message sent to players entering an unknown command. an empty message passes unknown commands on to the
+	/// other handlers
+	void setDefaultReply(StringView message, Colour colour);
+
+	void getStats(CommandRouterStats& stats) const;
+
+	bool onPlayerCommandText(IPlayer& player, StringView message) override;
+};
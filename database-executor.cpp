@@ -0,0 +1,719 @@
+#include "database-executor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <sqlite3.h>
+
+enum DatabaseJobKind : uint8_t
+{
+	DatabaseJobKind_Query,
+	DatabaseJobKind_Statement,
+	DatabaseJobKind_Prepare,
+	DatabaseJobKind_Finalize,
+	DatabaseJobKind_Close,
+};
+
+struct DatabaseExecutor::Worker
+{
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable signal;
+	std::deque<std::unique_ptr<Job>> queue;
+	bool stopping = false;
+};
+
+struct DatabaseExecutor::Connection
+{
+	int id;
+	sqlite3* db;
+	Worker* worker;
+};
+
+struct DatabaseExecutor::Statement
+{
+	int id;
+	Connection* connection;
+	/// set by the prepare job and only accessed by the worker of the connection; null if the prepare failed
+	sqlite3_stmt* stmt;
+	/// whether the prepare job was dispatched; only accessed by the server thread
+	bool ready;
+};
+
+struct DatabaseExecutor::Job
+{
+	struct Column
+	{
+		std::string name;
+		std::vector<DatabaseValueType> types;
+		std::vector<int64_t> values;
+		std::vector<uint32_t> lengths;
+	};
+
+	DatabaseJobKind kind = DatabaseJobKind_Query;
+	Connection* connection = nullptr;
+	/// the statement of a prepare or statement query, or the statements finalized by a finalize or close
+	std::vector<Statement*> statements;
+	std::string sql;
+	std::vector<DatabaseValue> params;
+	std::vector<uint8_t> paramData;
+	database_callback_fn callback = nullptr;
+	void* state = nullptr;
+	uint64_t query = 0;
+	std::chrono::steady_clock::time_point submitted;
+
+	int status = SQLITE_OK;
+	std::string error;
+	int64_t changes = 0;
+	int64_t lastInsertId = 0;
+	uint64_t queueNanoseconds = 0;
+	uint64_t executeNanoseconds = 0;
+	uint64_t rowCount = 0;
+	std::vector<Column> columns;
+	std::vector<uint8_t> data;
+
+	/// finalized statements are deleted with their job on the server thread after the completions of their earlier
+	/// queries were dispatched, so a prepare completion never refers to a deleted statement
+	~Job()
+	{
+		if (kind == DatabaseJobKind_Finalize || kind == DatabaseJobKind_Close)
+		{
+			for (Statement* statement : statements)
+			{
+				delete statement;
+			}
+		}
+	}
+};
+
+static uint64_t nanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+static int bindParams(sqlite3_stmt* stmt, const std::vector<DatabaseValue>& params)
+{
+	const int count = std::min(static_cast<int>(params.size()), sqlite3_bind_parameter_count(stmt));
+	for (int i = 0; i < count; i++)
+	{
+		const DatabaseValue& param = params[i];
+		int rc;
+
+		switch (param.type)
+		{
+		case DatabaseValueType_Integer:
+			rc = sqlite3_bind_int64(stmt, i + 1, param.integer);
+			break;
+		case DatabaseValueType_Float:
+			rc = sqlite3_bind_double(stmt, i + 1, param.real);
+			break;
+		case DatabaseValueType_Text:
+			rc = sqlite3_bind_text(stmt, i + 1, reinterpret_cast<const char*>(param.data), static_cast<int>(param.length), SQLITE_STATIC);
+			break;
+		case DatabaseValueType_Blob:
+			rc = sqlite3_bind_blob(stmt, i + 1, param.data, static_cast<int>(param.length), SQLITE_STATIC);
+			break;
+		default:
+			rc = sqlite3_bind_null(stmt, i + 1);
+			break;
+		}
+
+		if (rc != SQLITE_OK)
+		{
+			return rc;
+		}
+	}
+	return SQLITE_OK;
+}
+
+DatabaseExecutor::DatabaseExecutor() = default;
+
+DatabaseExecutor::~DatabaseExecutor()
+{
+	stop();
+}
+
+void DatabaseExecutor::start(size_t workers, size_t queue_capacity)
+{
+	if (!workers_.empty())
+	{
+		return;
+	}
+
+	queueCapacity_ = std::max(queue_capacity, static_cast<size_t>(1));
+	for (size_t i = 0; i < std::max(workers, static_cast<size_t>(1)); i++)
+	{
+		auto worker = std::make_unique<Worker>();
+		worker->thread = std::thread(&DatabaseExecutor::run, this, std::ref(*worker));
+		workers_.push_back(std::move(worker));
+	}
+}
+
+void DatabaseExecutor::stop()
+{
+	for (Connection* connection : connections_)
+	{
+		if (connection != nullptr)
+		{
+			close(connection->id);
+		}
+	}
+
+	for (auto& worker : workers_)
+	{
+		{
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			worker->stopping = true;
+		}
+		worker->signal.notify_one();
+		worker->thread.join();
+	}
+
+	workers_.clear();
+	connections_.clear();
+
+	std::lock_guard<std::mutex> lock(completedMutex_);
+	completed_.clear();
+}
+
+DatabaseExecutor::Connection* DatabaseExecutor::getConnection(int id) const
+{
+	return id >= 0 && static_cast<size_t>(id) < connections_.size() ? connections_[id] : nullptr;
+}
+
+int DatabaseExecutor::open(StringView path)
+{
+	if (workers_.empty())
+	{
+		lastError_ = "the database executor is not running";
+		return -1;
+	}
+
+	// the connection is only used by its worker after it was opened
+	sqlite3* db = nullptr;
+	const int rc = sqlite3_open_v2(path.to_string().c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, nullptr);
+	if (rc != SQLITE_OK)
+	{
+		lastError_ = db ? sqlite3_errmsg(db) : sqlite3_errstr(rc);
+		sqlite3_close_v2(db);
+		return -1;
+	}
+
+	sqlite3_busy_timeout(db, 5000);
+
+	auto slot = std::find(connections_.begin(), connections_.end(), nullptr);
+	if (slot == connections_.end())
+	{
+		slot = connections_.insert(connections_.end(), nullptr);
+	}
+
+	const int id = static_cast<int>(slot - connections_.begin());
+	*slot = new Connection { id, db, workers_[id % workers_.size()].get() };
+	return id;
+}
+
+bool DatabaseExecutor::close(int connection)
+{
+	Connection* target = getConnection(connection);
+	if (target == nullptr)
+	{
+		return false;
+	}
+
+	auto job = std::make_unique<Job>();
+	job->kind = DatabaseJobKind_Close;
+	job->connection = target;
+
+	for (Statement*& statement : statements_)
+	{
+		if (statement != nullptr && statement->connection == target)
+		{
+			job->statements.push_back(statement);
+			statement = nullptr;
+		}
+	}
+
+	connections_[connection] = nullptr;
+
+	// the connection is deleted by the worker after its pending queries
+	Worker& worker = *target->worker;
+	{
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		worker.queue.push_back(std::move(job));
+	}
+	worker.signal.notify_one();
+	return true;
+}
+
+uint64_t DatabaseExecutor::prepare(int connection, StringView sql, database_callback_fn callback, void* state)
+{
+	Connection* target = getConnection(connection);
+	if (target == nullptr)
+	{
+		return 0;
+	}
+
+	auto slot = std::find(statements_.begin(), statements_.end(), nullptr);
+	if (slot == statements_.end())
+	{
+		slot = statements_.insert(statements_.end(), nullptr);
+	}
+
+	// the ID is reserved now so queries of the statement can be submitted once the completion delivered it
+	const int id = static_cast<int>(slot - statements_.begin());
+	Statement* statement = new Statement { id, target, nullptr, false };
+	*slot = statement;
+
+	auto job = std::make_unique<Job>();
+	job->kind = DatabaseJobKind_Prepare;
+	job->sql = sql.to_string();
+	job->statements.push_back(statement);
+
+	const uint64_t query = submit(*target, std::move(job), nullptr, 0, callback, state);
+	if (query == 0)
+	{
+		statements_[id] = nullptr;
+		delete statement;
+	}
+	return query;
+}
+
+bool DatabaseExecutor::finalize(int statement)
+{
+	if (statement < 0 || static_cast<size_t>(statement) >= statements_.size() || statements_[statement] == nullptr)
+	{
+		return false;
+	}
+
+	Statement* target = statements_[statement];
+	statements_[statement] = nullptr;
+
+	// the statement is finalized by the worker after the pending queries of its connection
+	auto job = std::make_unique<Job>();
+	job->kind = DatabaseJobKind_Finalize;
+	job->connection = target->connection;
+	job->statements.push_back(target);
+
+	Worker& worker = *target->connection->worker;
+
+	{
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		worker.queue.push_back(std::move(job));
+	}
+	worker.signal.notify_one();
+	return true;
+}
+
+StringView DatabaseExecutor::getLastError() const
+{
+	return lastError_;
+}
+
+uint64_t DatabaseExecutor::execute(int connection, StringView sql, const DatabaseValue* params, size_t count, database_callback_fn callback, void* state)
+{
+	Connection* target = getConnection(connection);
+	if (target == nullptr)
+	{
+		return 0;
+	}
+
+	auto job = std::make_unique<Job>();
+	job->kind = DatabaseJobKind_Query;
+	job->sql = sql.to_string();
+	return submit(*target, std::move(job), params, count, callback, state);
+}
+
+uint64_t DatabaseExecutor::executeStatement(int statement, const DatabaseValue* params, size_t count, database_callback_fn callback, void* state)
+{
+	if (statement < 0 || static_cast<size_t>(statement) >= statements_.size() || statements_[statement] == nullptr || !statements_[statement]->ready)
+	{
+		return 0;
+	}
+
+	Statement* target = statements_[statement];
+
+	auto job = std::make_unique<Job>();
+	job->kind = DatabaseJobKind_Statement;
+	job->statements.push_back(target);
+	return submit(*target->connection, std::move(job), params, count, callback, state);
+}
+
+uint64_t DatabaseExecutor::submit(Connection& connection, std::unique_ptr<Job> job, const DatabaseValue* params, size_t count, database_callback_fn callback, void* state)
+{
+	// text and blob parameters are copied into one block owned by the job
+	size_t size = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (params[i].type == DatabaseValueType_Text || params[i].type == DatabaseValueType_Blob)
+		{
+			size += params[i].length;
+		}
+	}
+
+	job->paramData.resize(size);
+	job->params.assign(params, params + count);
+
+	size_t offset = 0;
+	for (DatabaseValue& param : job->params)
+	{
+		if (param.type == DatabaseValueType_Text || param.type == DatabaseValueType_Blob)
+		{
+			if (param.length != 0)
+			{
+				memcpy(job->paramData.data() + offset, param.data, param.length);
+			}
+			param.data = job->paramData.data() + offset;
+			offset += param.length;
+		}
+	}
+
+	job->connection = &connection;
+	job->callback = callback;
+	job->state = state;
+	job->query = nextQuery_;
+	job->submitted = std::chrono::steady_clock::now();
+
+	Worker& worker = *connection.worker;
+	{
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if (worker.queue.size() >= queueCapacity_)
+		{
+			std::lock_guard<std::mutex> statsLock(statsMutex_);
+			stats_.rejected++;
+			return 0;
+		}
+		worker.queue.push_back(std::move(job));
+	}
+	worker.signal.notify_one();
+
+	{
+		std::lock_guard<std::mutex> lock(statsMutex_);
+		stats_.submitted++;
+	}
+
+	return nextQuery_++;
+}
+
+void DatabaseExecutor::run(Worker& worker)
+{
+	for (;;)
+	{
+		std::unique_ptr<Job> job;
+		{
+			std::unique_lock<std::mutex> lock(worker.mutex);
+			worker.signal.wait(lock, [&worker] {
+				return worker.stopping || !worker.queue.empty();
+			});
+
+			// pending queries are executed before the worker stops
+			if (worker.queue.empty())
+			{
+				return;
+			}
+
+			job = std::move(worker.queue.front());
+			worker.queue.pop_front();
+		}
+
+		switch (job->kind)
+		{
+		case DatabaseJobKind_Finalize:
+		case DatabaseJobKind_Close:
+			for (Statement* statement : job->statements)
+			{
+				sqlite3_finalize(statement->stmt);
+				statement->stmt = nullptr;
+			}
+			if (job->kind == DatabaseJobKind_Close)
+			{
+				sqlite3_close_v2(job->connection->db);
+				delete job->connection;
+			}
+
+			// queued behind the completions of the connection so the statements are deleted after them
+			{
+				std::lock_guard<std::mutex> lock(completedMutex_);
+				completed_.push_back(std::move(job));
+			}
+			break;
+		default:
+			execute(*job);
+			complete(std::move(job));
+			break;
+		}
+	}
+}
+
+int DatabaseExecutor::stepAll(sqlite3_stmt* stmt, Job& job)
+{
+	const int columnCount = sqlite3_column_count(stmt);
+	if (columnCount > 0)
+	{
+		job.rowCount = 0;
+		job.data.clear();
+		job.columns.assign(columnCount, {});
+
+		for (int i = 0; i < columnCount; i++)
+		{
+			const char* name = sqlite3_column_name(stmt, i);
+			job.columns[i].name = name ? name : "";
+		}
+	}
+
+	int rc;
+	while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+	{
+		for (int i = 0; i < columnCount; i++)
+		{
+			Job::Column& column = job.columns[i];
+			int64_t value = 0;
+			uint32_t length = 0;
+			DatabaseValueType type;
+
+			switch (sqlite3_column_type(stmt, i))
+			{
+			case SQLITE_INTEGER:
+				type = DatabaseValueType_Integer;
+				value = sqlite3_column_int64(stmt, i);
+				break;
+			case SQLITE_FLOAT:
+			{
+				type = DatabaseValueType_Float;
+				const double real = sqlite3_column_double(stmt, i);
+				memcpy(&value, &real, sizeof(value));
+				break;
+			}
+			case SQLITE_TEXT:
+			case SQLITE_BLOB:
+			{
+				const bool text = sqlite3_column_type(stmt, i) == SQLITE_TEXT;
+				type = text ? DatabaseValueType_Text : DatabaseValueType_Blob;
+
+				// the pointer must be fetched before the length
+				const uint8_t* bytes = text ? sqlite3_column_text(stmt, i) : static_cast<const uint8_t*>(sqlite3_column_blob(stmt, i));
+				length = static_cast<uint32_t>(sqlite3_column_bytes(stmt, i));
+				value = static_cast<int64_t>(job.data.size());
+				if (length != 0)
+				{
+					job.data.insert(job.data.end(), bytes, bytes + length);
+				}
+				break;
+			}
+			default:
+				type = DatabaseValueType_Null;
+				break;
+			}
+
+			column.types.push_back(type);
+			column.values.push_back(value);
+			column.lengths.push_back(length);
+		}
+		job.rowCount++;
+	}
+
+	return rc;
+}
+
+void DatabaseExecutor::execute(Job& job)
+{
+	const auto start = std::chrono::steady_clock::now();
+	job.queueNanoseconds = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(start - job.submitted).count());
+
+	sqlite3* db = job.connection->db;
+	int rc = SQLITE_OK;
+
+	if (job.kind == DatabaseJobKind_Prepare)
+	{
+		Statement& statement = *job.statements.front();
+		rc = sqlite3_prepare_v3(db, job.sql.data(), static_cast<int>(job.sql.size()), SQLITE_PREPARE_PERSISTENT, &statement.stmt, nullptr);
+		if (rc == SQLITE_OK && statement.stmt == nullptr)
+		{
+			job.status = SQLITE_MISUSE;
+			job.error = "empty statement";
+			job.executeNanoseconds = nanosecondsSince(start);
+			return;
+		}
+	}
+	else if (job.kind == DatabaseJobKind_Statement)
+	{
+		sqlite3_stmt* stmt = job.statements.front()->stmt;
+		if (stmt == nullptr)
+		{
+			job.status = SQLITE_MISUSE;
+			job.error = "the statement failed to prepare";
+			job.executeNanoseconds = nanosecondsSince(start);
+			return;
+		}
+
+		sqlite3_reset(stmt);
+		sqlite3_clear_bindings(stmt);
+
+		rc = bindParams(stmt, job.params);
+		if (rc == SQLITE_OK)
+		{
+			rc = stepAll(stmt, job);
+		}
+		sqlite3_reset(stmt);
+	}
+	else
+	{
+		// every statement of the text is executed; the parameters are bound to the first one
+		const char* tail = job.sql.data();
+		const char* end = tail + job.sql.size();
+		bool first = true;
+
+		while (tail < end)
+		{
+			sqlite3_stmt* stmt = nullptr;
+			rc = sqlite3_prepare_v2(db, tail, static_cast<int>(end - tail), &stmt, &tail);
+			if (rc != SQLITE_OK || stmt == nullptr)
+			{
+				// a null statement without an error is trailing whitespace or a comment
+				break;
+			}
+
+			if (first)
+			{
+				rc = bindParams(stmt, job.params);
+				first = false;
+			}
+
+			if (rc == SQLITE_OK)
+			{
+				rc = stepAll(stmt, job);
+			}
+			sqlite3_finalize(stmt);
+
+			if (rc != SQLITE_DONE)
+			{
+				break;
+			}
+		}
+	}
+
+	if (rc == SQLITE_DONE || rc == SQLITE_OK)
+	{
+		job.status = SQLITE_OK;
+	}
+	else
+	{
+		job.status = rc;
+		job.error = sqlite3_errmsg(db);
+	}
+
+	job.changes = sqlite3_changes(db);
+	job.lastInsertId = sqlite3_last_insert_rowid(db);
+	job.executeNanoseconds = nanosecondsSince(start);
+}
+
+void DatabaseExecutor::complete(std::unique_ptr<Job> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(statsMutex_);
+		stats_.totalQueueNanoseconds += job->queueNanoseconds;
+		stats_.totalExecuteNanoseconds += job->executeNanoseconds;
+		stats_.maxExecuteNanoseconds = std::max(stats_.maxExecuteNanoseconds, job->executeNanoseconds);
+		if (job->status != SQLITE_OK)
+		{
+			stats_.failed++;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(completedMutex_);
+	completed_.push_back(std::move(job));
+}
+
+size_t DatabaseExecutor::dispatch()
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	{
+		std::lock_guard<std::mutex> lock(completedMutex_);
+		if (completed_.empty())
+		{
+			return 0;
+		}
+		dispatching_.swap(completed_);
+	}
+
+	size_t count = 0;
+	std::vector<DatabaseColumn> columns;
+	for (const std::unique_ptr<Job>& job : dispatching_)
+	{
+		if (job->kind == DatabaseJobKind_Finalize || job->kind == DatabaseJobKind_Close)
+		{
+			continue;
+		}
+		count++;
+
+		int statement = -1;
+		if (job->kind == DatabaseJobKind_Prepare)
+		{
+			// the statement is alive until its finalize job is dispatched, but it may have been removed already
+			Statement* prepared = job->statements.front();
+			if (statements_[prepared->id] == prepared)
+			{
+				if (job->status == SQLITE_OK)
+				{
+					prepared->ready = true;
+					statement = prepared->id;
+				}
+				else
+				{
+					finalize(prepared->id);
+				}
+			}
+		}
+
+		if (job->callback == nullptr)
+		{
+			continue;
+		}
+
+		columns.clear();
+		for (const Job::Column& column : job->columns)
+		{
+			columns.push_back({ column.name, column.types.data(), column.values.data(), column.lengths.data() });
+		}
+
+		const DatabaseResult result {
+			job->query,
+			job->status,
+			static_cast<uint32_t>(columns.size()),
+			job->rowCount,
+			columns.data(),
+			job->data.data(),
+			job->changes,
+			job->lastInsertId,
+			job->error,
+			job->queueNanoseconds,
+			job->executeNanoseconds,
+			statement,
+		};
+
+		job->callback(result, job->state);
+	}
+
+	dispatching_.clear();
+
+	std::lock_guard<std::mutex> lock(statsMutex_);
+	stats_.completed += count;
+	stats_.lastDispatchNanoseconds = nanosecondsSince(start);
+	return count;
+}
+
+void DatabaseExecutor::getStats(DatabaseExecutorStats& stats)
+{
+	std::lock_guard<std::mutex> lock(statsMutex_);
+	stats = stats_;
+	stats.pending = stats_.submitted - stats_.completed;
+}
+
+void DatabaseExecutor::resetStats()
+{
+	std::lock_guard<std::mutex> lock(statsMutex_);
+	const uint64_t pending = stats_.submitted - stats_.completed;
+	stats_ = DatabaseExecutorStats {};
+	stats_.submitted = pending;
+}
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dotnet/coreclr_delegates.h"
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+using namespace Impl;
+
+enum DatabaseValueType : uint8_t
+{
+	DatabaseValueType_Null,
+	DatabaseValueType_Integer,
+	DatabaseValueType_Float,
+	DatabaseValueType_Text,
+	DatabaseValueType_Blob,
+};
+
+/// parameter of a query. text and blob data are copied when the query is submitted. layout is shared with the managed
+/// DatabaseValue struct
+struct DatabaseValue
+{
+	DatabaseValueType type;
+	int64_t integer;
+	double real;
+	const uint8_t* data;
+	size_t length;
+};
+
+/// column of a result set. a value is an integer, the bits of a double or the offset of text or blob data in the data
+/// block of the result, depending on its type. layout is shared with the managed DatabaseColumn struct
+struct DatabaseColumn
+{
+	StringView name;
+	const DatabaseValueType* types;
+	const int64_t* values;
+	const uint32_t* lengths;
+};
+
+/// result of a query; only valid during the completion callback. layout is shared with the managed DatabaseResult
+/// struct
+struct DatabaseResult
+{
+	uint64_t query;
+	/// SQLite result code of the query; 0 on success
+	int32_t status;
+	uint32_t columnCount;
+	uint64_t rowCount;
+	const DatabaseColumn* columns;
+	const uint8_t* data;
+	int64_t changes;
+	int64_t lastInsertId;
+	StringView error;
+	/// time between the submission and the start of the execution
+	uint64_t queueNanoseconds;
+	uint64_t executeNanoseconds;
+	/// ID of the statement prepared by a prepare query, or -1 if it failed or the query was not a prepare
+	int32_t statement;
+};
+
+/// statistics of the database executor. layout is shared with the managed DatabaseExecutorStats struct
+struct DatabaseExecutorStats
+{
+	uint64_t submitted;
+	uint64_t completed;
+	uint64_t failed;
+	/// queries rejected because the queue of the connection was full
+	uint64_t rejected;
+	uint64_t pending;
+	uint64_t totalQueueNanoseconds;
+	uint64_t totalExecuteNanoseconds;
+	uint64_t maxExecuteNanoseconds;
+	uint64_t lastDispatchNanoseconds;
+};
+
+/// completion callback of a query
+typedef void (CORECLR_DELEGATE_CALLTYPE *database_callback_fn)(const DatabaseResult&, void* state);
+
+/// executes SQLite queries on a pool of worker threads. each connection is bound to one worker so its queries execute
+/// in submission order; queries of different connections run in parallel. result sets are materialised into columnar
+/// buffers on the worker and the completion callbacks are invoked in a batch on the server thread during the tick of
+/// the component. connections and statements are identified by IDs which are valid until they are closed. a connection
+/// is only used by its worker once it is open; statements are prepared on the worker as well.
+class DatabaseExecutor final
+{
+private:
+	struct Connection;
+	struct Statement;
+	struct Job;
+	struct Worker;
+
+	size_t queueCapacity_ = 0;
+	std::vector<std::unique_ptr<Worker>> workers_;
+	std::vector<Connection*> connections_;
+	std::vector<Statement*> statements_;
+	std::string lastError_;
+	uint64_t nextQuery_ = 1;
+
+	std::mutex completedMutex_;
+	std::vector<std::unique_ptr<Job>> completed_;
+	std::vector<std::unique_ptr<Job>> dispatching_;
+
+	std::mutex statsMutex_;
+	DatabaseExecutorStats stats_ {};
+
+	Connection* getConnection(int id) const;
+
+	uint64_t submit(Connection& connection, std::unique_ptr<Job> job, const DatabaseValue* params, size_t count, database_callback_fn callback, void* state);
+
+	void run(Worker& worker);
+
+	void execute(Job& job);
+
+	/// steps the statement to completion. the rows of a statement returning columns replace the result of the job
+	static int stepAll(sqlite3_stmt* stmt, Job& job);
+
+	void complete(std::unique_ptr<Job> job);
+
+public:
+	DatabaseExecutor();
+
+	DatabaseExecutor(const DatabaseExecutor&) = delete;
+	DatabaseExecutor& operator=(const DatabaseExecutor&) = delete;
+
+	~DatabaseExecutor();
+
+	/// starts the workers. queue_capacity is the maximum number of pending queries per worker
+	void start(size_t workers, size_t queue_capacity);
+
+	/// executes the pending queries, closes all connections and stops the workers. pending completions are discarded
+	void stop();
+
+	/// opens or creates the SQLite database file and returns its connection ID or -1 on failure
+	int open(StringView path);
+
+	/// closes the connection and its statements after its pending queries have been executed
+	bool close(int connection);
+
+	/// submits the preparation of a statement of the connection. the completion carries the ID of the statement, which
+	/// can be executed from then on. returns the query ID or 0 if the connection does not exist or its queue is full
+	uint64_t prepare(int connection, StringView sql, database_callback_fn callback, void* state);
+
+	/// finalizes the statement after the pending queries of its connection have been executed
+	bool finalize(int statement);
+
+	/// returns the error of the last failed open
+	StringView getLastError() const;
+
+	/// submits the SQL text with the parameters bound to its first statement. returns the query ID or 0 if the
+	/// connection does not exist or its queue is full
+	uint64_t execute(int connection, StringView sql, const DatabaseValue* params, size_t count, database_callback_fn callback, void* state);
+
+	/// submits the prepared statement with the parameters. returns the query ID or 0 if the statement does not exist, its
+	/// prepare was not completed or the queue of its connection is full
+	uint64_t executeStatement(int statement, const DatabaseValue* params, size_t count, database_callback_fn callback, void* state);
+
+	/// invokes the callbacks of the completed queries. must only be called from the server thread
+	size_t dispatch();
+
+	void getStats(DatabaseExecutorStats& stats);
+
+	void resetStats();
+};
@@ -0,0 +1,174 @@
+#include "entity-table.hpp"
+
+/// generations start at 1 and skip 0 when they wrap, so 0 is never a valid handle
+static uint32_t nextGeneration(uint32_t generation)
+{
+	return generation == UINT32_MAX ? 1 : generation + 1;
+}
+
+EntityTable::EntityTable(size_t capacity)
+	: slots_(capacity, EntityTableSlot { nullptr, 1, -1 })
+{
+	ids_.reserve(capacity);
+}
+
+void EntityTable::add(int id, void* entity)
+{
+	if (id < 0 || static_cast<size_t>(id) >= slots_.size())
+	{
+		return;
+	}
+
+	EntityTableSlot& slot = slots_[id];
+	if (slot.entity == nullptr)
+	{
+		slot.denseIndex = static_cast<int32_t>(ids_.size());
+		ids_.push_back(id);
+	}
+	slot.entity = entity;
+}
+
+void EntityTable::remove(int id)
+{
+	if (id < 0 || static_cast<size_t>(id) >= slots_.size())
+	{
+		return;
+	}
+
+	EntityTableSlot& slot = slots_[id];
+	if (slot.entity == nullptr)
+	{
+		return;
+	}
+
+	// swap-remove from the dense list
+	const int32_t last = ids_.back();
+	ids_[slot.denseIndex] = last;
+	slots_[last].denseIndex = slot.denseIndex;
+	ids_.pop_back();
+
+	slot.entity = nullptr;
+	slot.denseIndex = -1;
+	slot.generation = nextGeneration(slot.generation);
+}
+
+void EntityTable::clear()
+{
+	for (const int32_t id : ids_)
+	{
+		EntityTableSlot& slot = slots_[id];
+		slot.entity = nullptr;
+		slot.denseIndex = -1;
+		slot.generation = nextGeneration(slot.generation);
+	}
+	ids_.clear();
+}
+
+EntityTableSlot* EntityTable::slots()
+{
+	return slots_.data();
+}
+
+int32_t* EntityTable::ids()
+{
+	return ids_.data();
+}
+
+size_t EntityTable::capacity() const
+{
+	return slots_.size();
+}
+
+size_t EntityTable::count() const
+{
+	return ids_.size();
+}
+
+void* EntityTable::get(int id) const
+{
+	if (id < 0 || static_cast<size_t>(id) >= slots_.size())
+	{
+		return nullptr;
+	}
+	return slots_[id].entity;
+}
+
+uint64_t EntityTable::getHandle(int id) const
+{
+	if (get(id) == nullptr)
+	{
+		return 0;
+	}
+	return static_cast<uint64_t>(slots_[id].generation) << 32 | static_cast<uint32_t>(id);
+}
+
+void* EntityTable::resolve(uint64_t handle) const
+{
+	const uint32_t id = static_cast<uint32_t>(handle);
+	if (id >= slots_.size())
+	{
+		return nullptr;
+	}
+
+	const EntityTableSlot& slot = slots_[id];
+	if (slot.entity == nullptr || slot.generation != static_cast<uint32_t>(handle >> 32))
+	{
+		return nullptr;
+	}
+	return slot.entity;
+}
+
+void EntityTables::attach(ICore* core, IComponentList* components)
+{
+	attach<IPlayer>(EntityTableType_Player, nullptr, core->getPlayers(), PLAYER_POOL_SIZE);
+
+	if (auto vehicles = components->queryComponent<IVehiclesComponent>())
+	{
+		attach<IVehicle>(EntityTableType_Vehicle, vehicles, *vehicles, VEHICLE_POOL_SIZE);
+	}
+	if (auto objects = components->queryComponent<IObjectsComponent>())
+	{
+		attach<IObject>(EntityTableType_Object, objects, *objects, OBJECT_POOL_SIZE);
+	}
+	if (auto pickups = components->queryComponent<IPickupsComponent>())
+	{
+		attach<IPickup>(EntityTableType_Pickup, pickups, *pickups, PICKUP_POOL_SIZE);
+	}
+	if (auto labels = components->queryComponent<ITextLabelsComponent>())
+	{
+		attach<ITextLabel>(EntityTableType_TextLabel, labels, *labels, TEXT_LABEL_POOL_SIZE);
+	}
+	if (auto gangZones = components->queryComponent<IGangZonesComponent>())
+	{
+		attach<IGangZone>(EntityTableType_GangZone, gangZones, *gangZones, GANG_ZONE_POOL_SIZE);
+	}
+}
+
+void EntityTables::onFree(IComponent* component)
+{
+	for (auto it = attachments_.begin(); it != attachments_.end();)
+	{
+		if ((*it)->owner == component)
+		{
+			it = attachments_.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+void EntityTables::detachAll()
+{
+	attachments_.clear();
+}
+
+EntityTable* EntityTables::get(EntityTableType type)
+{
+	if (type < 0 || type >= EntityTableType_Count)
+	{
+		return nullptr;
+	}
+	return tables_[type].get();
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/GangZones/gangzones.hpp>
+#include <Server/Components/Objects/objects.hpp>
+#include <Server/Components/Pickups/pickups.hpp>
+#include <Server/Components/TextLabels/textlabels.hpp>
+#include <Server/Components/Vehicles/vehicles.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace Impl;
+
+enum EntityTableType : int
+{
+	EntityTableType_Player,
+	EntityTableType_Vehicle,
+	EntityTableType_Object,
+	EntityTableType_Pickup,
+	EntityTableType_TextLabel,
+	EntityTableType_GangZone,
+	EntityTableType_Count
+};
+
+/// slot of an entity table. layout is shared with the managed EntityTableSlot struct
+struct EntityTableSlot
+{
+	void* entity;
+	uint32_t generation;
+	int32_t denseIndex;
+};
+
+/// dense table of pool entries indexed by pool ID. every slot carries a generation which is incremented when the entry
+/// is destroyed, so handles (generation << 32 | id) of destroyed entities can be detected. generations are never 0, so
+/// the handle 0 never references an entity. the IDs of live entries are additionally kept in a contiguous array for
+/// iteration.
+class EntityTable final
+{
+private:
+	std::vector<EntityTableSlot> slots_;
+	std::vector<int32_t> ids_;
+
+public:
+	explicit EntityTable(size_t capacity);
+
+	EntityTable(const EntityTable&) = delete;
+	EntityTable& operator=(const EntityTable&) = delete;
+
+	void add(int id, void* entity);
+
+	void remove(int id);
+
+	void clear();
+
+	/// pointer to the first slot; the slots are not reallocated for the lifetime of the table
+	EntityTableSlot* slots();
+
+	/// pointer to the first ID of the live entries; the order changes when entries are removed
+	int32_t* ids();
+
+	size_t capacity() const;
+
+	size_t count() const;
+
+	void* get(int id) const;
+
+	/// returns the handle of the entity or 0 if the slot is empty
+	uint64_t getHandle(int id) const;
+
+	/// returns the entity referenced by the handle or null if the handle is stale
+	void* resolve(uint64_t handle) const;
+};
+
+/// registers pool event handlers which keep the entity tables in sync with the open.mp pools
+class EntityTables final
+{
+private:
+	struct IAttachment
+	{
+		IComponent* owner;
+
+		virtual ~IAttachment() = default;
+	};
+
+	template <class T>
+	struct Attachment final : IAttachment, PoolEventHandler<T>
+	{
+		EntityTable& table;
+		IEventDispatcher<PoolEventHandler<T>>& dispatcher;
+
+		Attachment(IComponent* owner, EntityTable& table, IEventDispatcher<PoolEventHandler<T>>& dispatcher)
+			: table(table)
+			, dispatcher(dispatcher)
+		{
+			this->owner = owner;
+			dispatcher.addEventHandler(this);
+		}
+
+		~Attachment() override
+		{
+			dispatcher.removeEventHandler(this);
+		}
+
+		void onPoolEntryCreated(T& entry) override
+		{
+			table.add(entry.getID(), &entry);
+		}
+
+		void onPoolEntryDestroyed(T& entry) override
+		{
+			table.remove(entry.getID());
+		}
+	};
+
+	std::unique_ptr<EntityTable> tables_[EntityTableType_Count];
+	std::vector<std::unique_ptr<IAttachment>> attachments_;
+
+	template <class T, class Pool>
+	void attach(EntityTableType type, IComponent* owner, Pool& pool, size_t capacity)
+	{
+		auto& table = tables_[type];
+		table = std::make_unique<EntityTable>(capacity);
+
+		// entries which were created before the handler was registered
+		for (size_t id = 0; id < capacity; id++)
+		{
+			if (T* entry = pool.get(static_cast<int>(id)))
+			{
+				table->add(static_cast<int>(id), entry);
+			}
+		}
+
+		attachments_.push_back(std::make_unique<Attachment<T>>(owner, *table, pool.getPoolEventDispatcher()));
+	}
+
+public:
+	void attach(ICore* core, IComponentList* components);
+
+	/// detaches the tables of a component which is being freed
+	void onFree(IComponent* component);
+
+	void detachAll();
+
+	EntityTable* get(EntityTableType type);
+};
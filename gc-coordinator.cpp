@@ -0,0 +1,236 @@
+#include "gc-coordinator.hpp"
+
+#include <algorithm>
+
+GcCoordinator::GcCoordinator()
+{
+	config_.budgetMicroseconds = 20000;
+	config_.sleepMicroseconds = 5000;
+	config_.minSlackMicroseconds = 4000;
+	config_.fullSlackMicroseconds = 15000;
+	config_.minIntervalTicks = 50;
+	config_.blockingFull = false;
+	config_.allocationThreshold = 16 * 1024 * 1024;
+	config_.fullAllocationThreshold = 256 * 1024 * 1024;
+	config_.noGcRegionSize = 16 * 1024 * 1024;
+}
+
+GcCoordinator::~GcCoordinator()
+{
+	detach();
+}
+
+void GcCoordinator::attach(const TickPacer& pacer)
+{
+	pacer_ = &pacer;
+}
+
+void GcCoordinator::detach()
+{
+	// the handler is not called anymore, so the runtime is not left in a no-GC region
+	if (stats_.critical)
+	{
+		endCritical();
+	}
+	handler_ = nullptr;
+	pacer_ = nullptr;
+}
+
+void GcCoordinator::setConfig(const GcCoordinatorConfig& config)
+{
+	config_ = config;
+}
+
+void GcCoordinator::getConfig(GcCoordinatorConfig& config) const
+{
+	config = config_;
+}
+
+void GcCoordinator::getStats(GcCoordinatorStats& stats) const
+{
+	stats = stats_;
+}
+
+GcReport GcCoordinator::request(GcCommand command, int generation)
+{
+	GcRequest request {};
+	request.command = command;
+	request.generation = generation;
+	request.slackMicroseconds = stats_.slackMicroseconds;
+	request.blocking = generation < 2 || config_.blockingFull;
+	request.noGcRegionSize = config_.noGcRegionSize;
+
+	GcReport report {};
+	handler_(request, report);
+	return report;
+}
+
+void GcCoordinator::updateCounts(const GcReport& report)
+{
+	report_ = report;
+	stats_.gen0Collections = report.gen0Collections;
+	stats_.gen1Collections = report.gen1Collections;
+	stats_.gen2Collections = report.gen2Collections;
+}
+
+void GcCoordinator::setHandler(gc_handler_fn handler)
+{
+	if (stats_.critical && handler_ != nullptr)
+	{
+		request(GcCommand_EndCritical);
+		stats_.critical = false;
+	}
+
+	handler_ = handler;
+	sampled_ = false;
+	inducedPause_ = 0;
+
+	if (handler_ != nullptr)
+	{
+		updateCounts(request(GcCommand_Sample));
+		allocatedAtCollection_ = report_.allocatedBytes;
+		allocatedAtFullCollection_ = report_.allocatedBytes;
+	}
+}
+
+void GcCoordinator::beginCritical(uint32_t ticks)
+{
+	criticalTicks_ = ticks;
+
+	if (stats_.critical || handler_ == nullptr)
+	{
+		return;
+	}
+
+	stats_.critical = true;
+	stats_.criticalWindows++;
+
+	// entering a no-GC region may itself collect to make room for the region; that pause is not induced by the slack
+	const GcReport report = request(GcCommand_BeginCritical);
+	if (report.succeeded)
+	{
+		stats_.noGcRegions++;
+	}
+}
+
+void GcCoordinator::endCritical()
+{
+	criticalTicks_ = 0;
+
+	if (!stats_.critical)
+	{
+		return;
+	}
+
+	stats_.critical = false;
+	if (handler_ != nullptr)
+	{
+		request(GcCommand_EndCritical);
+	}
+}
+
+bool GcCoordinator::isCritical() const
+{
+	return stats_.critical;
+}
+
+void GcCoordinator::tick(Microseconds elapsed)
+{
+	if (handler_ == nullptr)
+	{
+		return;
+	}
+
+	stats_.ticks++;
+	ticksSinceCollection_++;
+
+	const uint64_t interval = static_cast<uint64_t>(std::max<Microseconds::rep>(elapsed.count(), 0));
+	stats_.tickMicroseconds += interval;
+
+	// pauses since the previous sample happened during the interval which ends with this tick
+	const GcReport report = request(GcCommand_Sample);
+	const uint64_t paused = report.pauseMicroseconds - report_.pauseMicroseconds;
+	const uint64_t pause = paused > inducedPause_ ? paused - inducedPause_ : 0;
+	updateCounts(report);
+	inducedPause_ = 0;
+
+	if (pause > 0)
+	{
+		stats_.pausedTicks++;
+		stats_.pauseMicroseconds += pause;
+		stats_.maxPauseMicroseconds = std::max(stats_.maxPauseMicroseconds, pause);
+	}
+
+	if (interval > config_.budgetMicroseconds)
+	{
+		stats_.hitches++;
+		if (pause > 0)
+		{
+			stats_.pausedHitches++;
+		}
+	}
+
+	TickPacerStats pacer {};
+	if (pacer_ != nullptr)
+	{
+		pacer_->getStats(pacer);
+	}
+	const uint64_t sleep = pacer.mode != TickPacerMode_Disabled ? pacer.sleepMicroseconds : config_.sleepMicroseconds;
+	const uint64_t work = interval > sleep ? interval - sleep : 0;
+
+	lastWork_ = static_cast<uint32_t>(std::min<uint64_t>(work, UINT32_MAX));
+	if (!sampled_)
+	{
+		stats_.workMicroseconds = static_cast<float>(work);
+		sampled_ = true;
+	}
+	else
+	{
+		stats_.workMicroseconds += (static_cast<float>(work) - stats_.workMicroseconds) * SMOOTHING;
+	}
+
+	// a single slow tick is not hidden by the average
+	const uint32_t expected = std::max(lastWork_, static_cast<uint32_t>(stats_.workMicroseconds));
+	stats_.slackMicroseconds = config_.budgetMicroseconds > expected ? config_.budgetMicroseconds - expected : 0;
+
+	if (stats_.critical && criticalTicks_ != 0 && --criticalTicks_ == 0)
+	{
+		stats_.critical = false;
+		request(GcCommand_EndCritical);
+	}
+}
+
+void GcCoordinator::collect()
+{
+	if (handler_ == nullptr || stats_.critical || config_.minSlackMicroseconds == 0)
+	{
+		return;
+	}
+
+	if (ticksSinceCollection_ < config_.minIntervalTicks || stats_.slackMicroseconds < config_.minSlackMicroseconds)
+	{
+		return;
+	}
+
+	const GcReport before = request(GcCommand_Sample);
+	if (before.allocatedBytes - allocatedAtCollection_ < config_.allocationThreshold)
+	{
+		return;
+	}
+
+	const bool full = config_.fullSlackMicroseconds != 0 && stats_.slackMicroseconds >= config_.fullSlackMicroseconds && before.allocatedBytes - allocatedAtFullCollection_ >= config_.fullAllocationThreshold;
+	const GcReport after = request(GcCommand_Collect, full ? 2 : 1);
+
+	ticksSinceCollection_ = 0;
+	allocatedAtCollection_ = after.allocatedBytes;
+	if (full)
+	{
+		allocatedAtFullCollection_ = after.allocatedBytes;
+		stats_.inducedFullCollections++;
+	}
+	stats_.inducedCollections++;
+
+	const uint64_t pause = after.pauseMicroseconds - before.pauseMicroseconds;
+	stats_.inducedPauseMicroseconds += pause;
+	inducedPause_ += pause;
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <cstdint>
+
+#include "dotnet/coreclr_delegates.h"
+#include "tick-pacer.hpp"
+
+using namespace Impl;
+
+enum GcCommand : uint32_t
+{
+	/// reports the counters of the runtime without collecting
+	GcCommand_Sample,
+	/// collects the requested generation
+	GcCommand_Collect,
+	/// enters a no-GC region of the requested size, or sustained low latency mode if the region cannot be entered
+	GcCommand_BeginCritical,
+	/// leaves the no-GC region or low latency mode and restores the previous latency mode
+	GcCommand_EndCritical,
+};
+
+/// request passed to the managed handler. layout is shared with the managed GcRequest struct
+struct GcRequest
+{
+	GcCommand command;
+	int32_t generation;
+	/// estimated time left in the tick budget
+	uint32_t slackMicroseconds;
+	/// whether a full collection must block; otherwise it may run as a background collection
+	bool blocking;
+	uint64_t noGcRegionSize;
+};
+
+/// cumulative counters of the runtime reported by the managed handler after every request. layout is shared with the
+/// managed GcReport struct
+struct GcReport
+{
+	uint64_t pauseMicroseconds;
+	uint64_t allocatedBytes;
+	uint32_t gen0Collections;
+	uint32_t gen1Collections;
+	uint32_t gen2Collections;
+	/// whether a no-GC region was entered
+	bool succeeded;
+};
+
+/// configuration of the GC coordinator. layout is shared with the managed GcCoordinatorConfig struct
+struct GcCoordinatorConfig
+{
+	/// tick interval the server may reach before a tick counts as a hitch
+	uint32_t budgetMicroseconds;
+	/// sleep of the core between ticks while the tick pacer is disabled
+	uint32_t sleepMicroseconds;
+	/// slack required for a collection of generation 1; 0 disables induced collections
+	uint32_t minSlackMicroseconds;
+	/// slack required for a full collection; 0 disables induced full collections
+	uint32_t fullSlackMicroseconds;
+	/// ticks between induced collections
+	uint32_t minIntervalTicks;
+	/// whether induced full collections block instead of running in the background
+	bool blockingFull;
+	/// bytes allocated since the previous induced collection before another is induced
+	uint64_t allocationThreshold;
+	/// bytes allocated since the previous induced full collection before another is induced
+	uint64_t fullAllocationThreshold;
+	/// size of the no-GC region requested for critical windows; 0 only enables sustained low latency mode
+	uint64_t noGcRegionSize;
+};
+
+/// pause time of the runtime recorded against tick time. layout is shared with the managed GcCoordinatorStats struct
+struct GcCoordinatorStats
+{
+	uint64_t ticks;
+	/// sum of the intervals between ticks
+	uint64_t tickMicroseconds;
+	/// ticks in which the runtime paused for collections which were not induced by the coordinator
+	uint64_t pausedTicks;
+	uint64_t pauseMicroseconds;
+	/// longest pause which was not induced within a single tick
+	uint64_t maxPauseMicroseconds;
+	/// ticks with an interval beyond the budget
+	uint64_t hitches;
+	/// hitches in which the runtime paused for a collection which was not induced
+	uint64_t pausedHitches;
+	uint64_t inducedCollections;
+	uint64_t inducedFullCollections;
+	uint64_t inducedPauseMicroseconds;
+	uint64_t criticalWindows;
+	/// critical windows in which a no-GC region was entered
+	uint64_t noGcRegions;
+	uint32_t gen0Collections;
+	uint32_t gen1Collections;
+	uint32_t gen2Collections;
+	uint32_t slackMicroseconds;
+	/// smoothed time between ticks minus the sleep
+	float workMicroseconds;
+	bool critical;
+};
+
+/// handler which runs the request in the runtime and writes the counters of the runtime after the request
+typedef void (CORECLR_DELEGATE_CALLTYPE *gc_handler_fn)(const GcRequest&, GcReport&);
+
+/// schedules collections of the managed runtime into the slack of the tick loop. the work of a tick is estimated as the
+/// time between ticks minus the sleep of the core (taken from the tick pacer while it is enabled); collections are
+/// induced at the end of the tick of the component when the budget leaves enough slack and enough memory was allocated
+/// since the previous induced collection. during critical windows no collections are induced and the handler keeps the
+/// runtime in a no-GC region or low latency mode. the counters of the runtime are sampled at the start of every tick so
+/// pauses are attributed to the tick in which they happened.
+class GcCoordinator final
+{
+private:
+	static constexpr float SMOOTHING = 0.1f;
+
+	const TickPacer* pacer_ = nullptr;
+	gc_handler_fn handler_ = nullptr;
+	GcCoordinatorConfig config_;
+	GcCoordinatorStats stats_ {};
+	GcReport report_ {};
+	bool sampled_ = false;
+	uint32_t lastWork_ = 0;
+	/// pause induced since the previous sample
+	uint64_t inducedPause_ = 0;
+	uint32_t ticksSinceCollection_ = 0;
+	uint64_t allocatedAtCollection_ = 0;
+	uint64_t allocatedAtFullCollection_ = 0;
+	/// ticks left in the critical window; 0 if the window lasts until it is ended
+	uint32_t criticalTicks_ = 0;
+
+	GcReport request(GcCommand command, int generation = 0);
+
+	void updateCounts(const GcReport& report);
+
+public:
+	GcCoordinator();
+
+	GcCoordinator(const GcCoordinator&) = delete;
+	GcCoordinator& operator=(const GcCoordinator&) = delete;
+
+	~GcCoordinator();
+
+	void attach(const TickPacer& pacer);
+
+	void detach();
+
+	void setConfig(const GcCoordinatorConfig& config);
+
+	void getConfig(GcCoordinatorConfig& config) const;
+
+	void getStats(GcCoordinatorStats& stats) const;
+
+	/// sets the handler; the counters of the runtime are sampled immediately so earlier pauses are not attributed to a
+	/// tick. a null handler disables the coordinator
+	void setHandler(gc_handler_fn handler);
+
+	/// starts a critical window lasting the number of ticks, or until it is ended if ticks is 0. starting a window
+	/// while one is active only changes its length
+	void beginCritical(uint32_t ticks);
+
+	void endCritical();
+
+	bool isCritical() const;
+
+	/// samples the runtime and records the pause of the previous tick. must be called at the start of the tick of the
+	/// component
+	void tick(Microseconds elapsed);
+
+	/// induces a collection if the tick has enough slack. must be called at the end of the tick of the component
+	void collect();
+};
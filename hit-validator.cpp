@@ -0,0 +1,243 @@
+#include "hit-validator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+HitValidator::HitValidator()
+	: histories_(PLAYER_POOL_SIZE)
+	, verdicts_(PLAYER_POOL_SIZE)
+{
+	config_.enabled = false;
+	config_.reject = false;
+	config_.hitboxRadius = 1.0f;
+	config_.hitboxHalfHeight = 1.0f;
+	config_.tolerance = 1.5f;
+	config_.originTolerance = 0.0f;
+	config_.maxRewindMilliseconds = 1000;
+}
+
+HitValidator::~HitValidator()
+{
+	detach();
+}
+
+void HitValidator::attach(ICore* core)
+{
+	core_ = core;
+
+	IPlayerPool& players = core_->getPlayers();
+	players.getPlayerUpdateDispatcher().addEventHandler(this, EventPriority_FairlyHigh);
+	players.getPlayerShotDispatcher().addEventHandler(this, EventPriority_FairlyHigh);
+	players.getPlayerSpawnDispatcher().addEventHandler(this);
+	players.getPlayerConnectDispatcher().addEventHandler(this);
+}
+
+void HitValidator::detach()
+{
+	if (core_ != nullptr)
+	{
+		IPlayerPool& players = core_->getPlayers();
+		players.getPlayerUpdateDispatcher().removeEventHandler(this);
+		players.getPlayerShotDispatcher().removeEventHandler(this);
+		players.getPlayerSpawnDispatcher().removeEventHandler(this);
+		players.getPlayerConnectDispatcher().removeEventHandler(this);
+		core_ = nullptr;
+	}
+}
+
+void HitValidator::setConfig(const HitValidatorConfig& config)
+{
+	config_ = config;
+}
+
+void HitValidator::getConfig(HitValidatorConfig& config) const
+{
+	config = config_;
+}
+
+HitValidator::History* HitValidator::getHistory(int id)
+{
+	if (id < 0 || static_cast<size_t>(id) >= histories_.size())
+	{
+		return nullptr;
+	}
+	return &histories_[id];
+}
+
+bool HitValidator::sample(const History& history, TimePoint time, Vector3& position, GTAQuat& rotation) const
+{
+	if (history.count == 0)
+	{
+		return false;
+	}
+
+	// walk back from the newest sample until the sample is not newer than the requested time
+	const size_t newest = (history.head + HISTORY_SIZE - 1) % HISTORY_SIZE;
+	const Sample* later = &history.samples[newest];
+
+	if (time >= later->time)
+	{
+		position = later->position;
+		rotation = later->rotation;
+		return true;
+	}
+
+	for (size_t i = 1; i < history.count; i++)
+	{
+		const Sample* earlier = &history.samples[(newest + HISTORY_SIZE - i) % HISTORY_SIZE];
+
+		if (earlier->time <= time)
+		{
+			const float span = std::chrono::duration<float>(later->time - earlier->time).count();
+			const float t = span > 0.0f ? std::chrono::duration<float>(time - earlier->time).count() / span : 0.0f;
+
+			position.x = earlier->position.x + (later->position.x - earlier->position.x) * t;
+			position.y = earlier->position.y + (later->position.y - earlier->position.y) * t;
+			position.z = earlier->position.z + (later->position.z - earlier->position.z) * t;
+			rotation = t < 0.5f ? earlier->rotation : later->rotation;
+			return true;
+		}
+
+		later = earlier;
+	}
+
+	// older than the history; use the oldest sample
+	position = later->position;
+	rotation = later->rotation;
+	return true;
+}
+
+bool HitValidator::rewind(IPlayer& player, uint32_t milliseconds, Vector3& position, GTAQuat& rotation)
+{
+	History* history = getHistory(player.getID());
+	if (history == nullptr)
+	{
+		return false;
+	}
+
+	const TimePoint time = std::chrono::steady_clock::now() - Milliseconds(milliseconds);
+	return sample(*history, time, position, rotation);
+}
+
+bool HitValidator::validate(IPlayer& shooter, IPlayer& target, const PlayerBulletData& bullet, HitVerdict& verdict)
+{
+	verdict = HitVerdict { HitVerdictResult_Valid, target.getID(), 0.0f, 0, Vector3(0.0f, 0.0f, 0.0f) };
+
+	History* history = getHistory(target.getID());
+	const uint32_t rewind = std::min(shooter.getPing(), config_.maxRewindMilliseconds);
+	const TimePoint time = std::chrono::steady_clock::now() - Milliseconds(rewind);
+	GTAQuat rotation;
+
+	verdict.rewindMilliseconds = rewind;
+
+	if (history == nullptr || !sample(*history, time, verdict.rewoundPosition, rotation))
+	{
+		verdict.result = HitVerdictResult_NoHistory;
+	}
+	else
+	{
+		// distance between the hit position and a vertical capsule around the rewound position
+		const Vector3& hit = bullet.hitPos;
+		const Vector3& center = verdict.rewoundPosition;
+		const float z = std::clamp(hit.z, center.z - config_.hitboxHalfHeight, center.z + config_.hitboxHalfHeight);
+		const float dx = hit.x - center.x;
+		const float dy = hit.y - center.y;
+		const float dz = hit.z - z;
+
+		verdict.distance = std::max(0.0f, std::sqrt(dx * dx + dy * dy + dz * dz) - config_.hitboxRadius);
+
+		if (verdict.distance > config_.tolerance)
+		{
+			verdict.result = HitVerdictResult_OutOfHitbox;
+		}
+		else if (config_.originTolerance > 0.0f)
+		{
+			const Vector3 origin = shooter.getPosition();
+			const float ox = bullet.origin.x - origin.x;
+			const float oy = bullet.origin.y - origin.y;
+			const float oz = bullet.origin.z - origin.z;
+
+			if (std::sqrt(ox * ox + oy * oy + oz * oz) > config_.originTolerance)
+			{
+				verdict.result = HitVerdictResult_OriginMismatch;
+			}
+		}
+	}
+
+	const int shooterId = shooter.getID();
+	if (shooterId >= 0 && static_cast<size_t>(shooterId) < verdicts_.size())
+	{
+		verdicts_[shooterId] = verdict;
+	}
+
+	return verdict.result == HitVerdictResult_Valid;
+}
+
+bool HitValidator::getLastVerdict(IPlayer& shooter, HitVerdict& verdict)
+{
+	const int id = shooter.getID();
+	if (id < 0 || static_cast<size_t>(id) >= verdicts_.size())
+	{
+		return false;
+	}
+
+	verdict = verdicts_[id];
+	return true;
+}
+
+void HitValidator::clearHistory(IPlayer& player)
+{
+	if (History* history = getHistory(player.getID()))
+	{
+		history->head = 0;
+		history->count = 0;
+	}
+}
+
+uint64_t HitValidator::getRejectedCount() const
+{
+	return rejected_;
+}
+
+bool HitValidator::onPlayerUpdate(IPlayer& player, TimePoint now)
+{
+	if (!config_.enabled)
+	{
+		return true;
+	}
+
+	if (History* history = getHistory(player.getID()))
+	{
+		history->samples[history->head] = Sample { now, player.getPosition(), player.getRotation() };
+		history->head = (history->head + 1) % HISTORY_SIZE;
+		history->count = std::min(history->count + 1, HISTORY_SIZE);
+	}
+	return true;
+}
+
+bool HitValidator::onPlayerShotPlayer(IPlayer& player, IPlayer& target, const PlayerBulletData& bulletData)
+{
+	if (!config_.enabled)
+	{
+		return true;
+	}
+
+	HitVerdict verdict;
+	if (validate(player, target, bulletData, verdict) || !config_.reject)
+	{
+		return true;
+	}
+
+	rejected_++;
+	return false;
+}
+
+void HitValidator::onPlayerSpawn(IPlayer& player)
+{
+	clearHistory(player);
+}
+
+void HitValidator::onPlayerConnect(IPlayer& player)
+{
+	clearHistory(player);
+}
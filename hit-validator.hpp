@@ -0,0 +1,117 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Impl;
+
+enum HitVerdictResult : uint8_t
+{
+	HitVerdictResult_Valid,
+	HitVerdictResult_NoHistory,
+	HitVerdictResult_OutOfHitbox,
+	HitVerdictResult_OriginMismatch,
+};
+
+/// verdict of the last validated hit of a shooter. layout is shared with the managed HitVerdict struct
+struct HitVerdict
+{
+	HitVerdictResult result;
+	int targetId;
+	float distance;
+	uint32_t rewindMilliseconds;
+	Vector3 rewoundPosition;
+};
+
+/// configuration of the hit validator. layout is shared with the managed HitValidatorConfig struct
+struct HitValidatorConfig
+{
+	bool enabled;
+	/// drop shots with an invalid verdict before they reach other (managed) handlers
+	bool reject;
+	/// radius of the vertical capsule around the player position used as hitbox
+	float hitboxRadius;
+	/// half height of the capsule
+	float hitboxHalfHeight;
+	/// additional distance allowed between the hit position and the rewound hitbox
+	float tolerance;
+	/// maximum distance between the bullet origin and the shooter; 0 disables the check
+	float originTolerance;
+	/// upper bound of the rewind time
+	uint32_t maxRewindMilliseconds;
+};
+
+/// records a ring buffer of timestamped positions and rotations per player from player updates, and validates
+/// player-on-player shots against the target's hitbox at the time the shooter saw it (now - ping of the shooter).
+class HitValidator final
+	: public PlayerUpdateEventHandler
+	, public PlayerShotEventHandler
+	, public PlayerSpawnEventHandler
+	, public PlayerConnectEventHandler
+{
+private:
+	static constexpr size_t HISTORY_SIZE = 64;
+
+	struct Sample
+	{
+		TimePoint time;
+		Vector3 position;
+		GTAQuat rotation;
+	};
+
+	struct History
+	{
+		size_t head;
+		size_t count;
+		Sample samples[HISTORY_SIZE];
+	};
+
+	ICore* core_ = nullptr;
+	HitValidatorConfig config_;
+	std::vector<History> histories_;
+	std::vector<HitVerdict> verdicts_;
+	uint64_t rejected_ = 0;
+
+	History* getHistory(int id);
+
+	bool sample(const History& history, TimePoint time, Vector3& position, GTAQuat& rotation) const;
+
+public:
+	HitValidator();
+
+	HitValidator(const HitValidator&) = delete;
+	HitValidator& operator=(const HitValidator&) = delete;
+
+	~HitValidator();
+
+	void attach(ICore* core);
+
+	void detach();
+
+	void setConfig(const HitValidatorConfig& config);
+
+	void getConfig(HitValidatorConfig& config) const;
+
+	/// interpolated position and rotation (of the nearest sample) of the player the specified time ago
+	bool rewind(IPlayer& player, uint32_t milliseconds, Vector3& position, GTAQuat& rotation);
+
+	/// validates a shot of the shooter at the target. the verdict is also stored as the last verdict of the shooter
+	bool validate(IPlayer& shooter, IPlayer& target, const PlayerBulletData& bullet, HitVerdict& verdict);
+
+	/// verdict of the last shot of the shooter validated by the hit validator
+	bool getLastVerdict(IPlayer& shooter, HitVerdict& verdict);
+
+	void clearHistory(IPlayer& player);
+
+	uint64_t getRejectedCount() const;
+
+	bool onPlayerUpdate(IPlayer& player, TimePoint now) override;
+
+	bool onPlayerShotPlayer(IPlayer& player, IPlayer& target, const PlayerBulletData& bulletData) override;
+
+	void onPlayerSpawn(IPlayer& player) override;
+
+	void onPlayerConnect(IPlayer& player) override;
+};
@@ -19,6 +19,12 @@ public static class Constants
 
     public const string CustomMarshallerAttributeFQN = "System.Runtime.InteropServices.Marshalling.CustomMarshallerAttribute";
 
+    public const string StructLayoutAttributeFQN = "System.Runtime.InteropServices.StructLayoutAttribute";
+
+    public const string FieldOffsetAttributeFQN = "System.Runtime.InteropServices.FieldOffsetAttribute";
+
+    public const string InlineArrayAttributeFQN = "System.Runtime.CompilerServices.InlineArrayAttribute";
+
     // SashManaged.OpenMp
     public const string StringViewFQN = "SashManaged.OpenMp.StringView";
 
@@ -63,6 +69,14 @@ public static class Constants
 
     public const string BooleanMarshallerFQN = "SashManaged.BooleanMarshaller";
     
+    // Interop
+
+    /// <summary>
+    /// Unmanaged structs returned by value which are larger than this number of bytes are returned through a pointer
+    /// provided by the caller. The native proxy exposes these as "{type}_{method}_out" functions.
+    /// </summary>
+    public const int OutPointerReturnThreshold = 16;
+
     public static readonly string DelegateFQN = typeof(Delegate).FullName!;
 
     public static readonly string MarshalFQN = typeof(Marshal).FullName!;
@@ -10,6 +10,7 @@ public record MethodStubGenerationContext(
     ParameterStubGenerationContext[] Parameters,
     IMarshallerShape? ReturnMarshallerShape,
     bool RequiresMarshalling,
+    bool ReturnsByOutPointer,
     string Library,
     string NativeTypeName)
 {
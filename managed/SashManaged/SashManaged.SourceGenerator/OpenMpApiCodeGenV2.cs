@@ -625,6 +625,10 @@ public class OpenMpApiCodeGenV2 : IIncrementalGenerator
                 ? PointerType(externReturnType)
                 : RefType(externReturnType);
         }
+        else if (ctx.ReturnsByOutPointer)
+        {
+            externReturnType = PredefinedType(Token(SyntaxKind.VoidKeyword));
+        }
 
         var externFunction = GenerateExternFunction(ctx, externReturnType);
 
@@ -655,6 +659,7 @@ public class OpenMpApiCodeGenV2 : IIncrementalGenerator
                         .AddRange(
                             ctx.Parameters.Select(GetArgumentForParameter)
                         )
+                        .AddRange(GetReturnValueArguments(ctx))
                 )
             );
 
@@ -662,6 +667,17 @@ public class OpenMpApiCodeGenV2 : IIncrementalGenerator
         {
             return Block(ExpressionStatement(invoke));
         }
+
+        if (ctx.ReturnsByOutPointer)
+        {
+            // the native function constructs the return value in the uninitialized local
+            return Block(
+                LocalDeclarationStatement(
+                    VariableDeclaration(TypeNameGlobal(ctx.Symbol.ReturnType))
+                        .WithVariables(SingletonSeparatedList(VariableDeclarator(Identifier("__retVal"))))),
+                ExpressionStatement(invoke),
+                ReturnStatement(IdentifierName("__retVal")));
+        }
             
         if (ctx.Symbol.ReturnsByRef || ctx.Symbol.ReturnsByRefReadonly)
         {
@@ -680,9 +696,10 @@ public class OpenMpApiCodeGenV2 : IIncrementalGenerator
                         SingletonSeparatedList(
                                 Argument(IdentifierName("_handle")))
                             .AddRange(
-                                ctx.Parameters.Select(GetArgumentForParameter))));
+                                ctx.Parameters.Select(GetArgumentForParameter))
+                            .AddRange(GetReturnValueArguments(ctx))));
         
-        if (!ctx.Symbol.ReturnsVoid)
+        if (!ctx.Symbol.ReturnsVoid && !ctx.ReturnsByOutPointer)
         {
             invoke = 
                 AssignmentExpression(
@@ -836,6 +853,19 @@ public class OpenMpApiCodeGenV2 : IIncrementalGenerator
 
     }
     
+    /// <summary>
+    /// Returns the trailing argument pointing to the return value if the method returns by out pointer.
+    /// </summary>
+    private static IEnumerable<ArgumentSyntax> GetReturnValueArguments(MethodStubGenerationContext ctx)
+    {
+        if (!ctx.ReturnsByOutPointer)
+        {
+            return [];
+        }
+
+        return [Argument(PrefixUnaryExpression(SyntaxKind.AddressOfExpression, IdentifierName("__retVal")))];
+    }
+
     private static ArgumentSyntax GetArgumentForParameter(ParameterStubGenerationContext ctx)
     {
         return ctx.MarshallerShape != null 
@@ -902,25 +932,32 @@ public class OpenMpApiCodeGenV2 : IIncrementalGenerator
     private static LocalFunctionStatementSyntax GenerateExternFunction(MethodStubGenerationContext ctx, TypeSyntax externReturnType)
     {
         var handleParam = Parameter(Identifier("handle_")).WithType(ParseTypeName("nint"));
+        var parameters = ctx.Parameters.Select(x => ToForwardInfo(x.Symbol, x.MarshallerShape));
+
+        if (ctx.ReturnsByOutPointer)
+        {
+            parameters = parameters.Append(new ParamForwardInfo("retVal_", PointerType(TypeNameGlobal(ctx.Symbol.ReturnType)), RefKind.None));
+        }
 
         return HelperSyntaxFactory.GenerateExternFunction(
             library: ctx.Library, 
             externName: ToExternName(ctx),
             externReturnType: externReturnType, 
-            parameters: ctx.Parameters.Select(x => ToForwardInfo(x.Symbol, x.MarshallerShape)), 
+            parameters: parameters, 
             parametersPrefix: handleParam);
     }
 
     /// <summary>
-    /// Returns the external native name of a function.
+    /// Returns the external native name of a function. Functions returning by out pointer are post-fixed with "_out".
     /// </summary>
     private static string ToExternName(MethodStubGenerationContext ctx)
     {
         var overload = ctx.Symbol.GetAttribute(Constants.OverloadAttributeFQN)?.ConstructorArguments[0].Value as string;
+        var suffix = ctx.ReturnsByOutPointer ? "_out" : string.Empty;
 
         return ctx.Symbol.GetAttribute(Constants.FunctionAttributeFQN)?.ConstructorArguments[0].Value is string functionName 
-            ? $"{ctx.NativeTypeName}_{functionName}" 
-            : $"{ctx.NativeTypeName}_{StringUtil.FirstCharToLower(ctx.Symbol.Name)}{overload}";
+            ? $"{ctx.NativeTypeName}_{functionName}{suffix}" 
+            : $"{ctx.NativeTypeName}_{StringUtil.FirstCharToLower(ctx.Symbol.Name)}{overload}{suffix}";
     }
     
     /// <summary>
@@ -971,8 +1008,16 @@ public class OpenMpApiCodeGenV2 : IIncrementalGenerator
                     // TODO: diagnostic
                     return null;
                 }
+
+                // large structs are constructed by the native proxy in memory provided by the caller
+                var returnsByOutPointer = returnMarshallerShape == null &&
+                                          !method.methodSymbol.ReturnsVoid &&
+                                          !method.methodSymbol.ReturnsByRef &&
+                                          !method.methodSymbol.ReturnsByRefReadonly &&
+                                          method.methodSymbol.ReturnType is { TypeKind: TypeKind.Struct, IsUnmanagedType: true } &&
+                                          method.methodSymbol.ReturnType.GetNativeSize() > Constants.OutPointerReturnThreshold;
                 
-                return new MethodStubGenerationContext(method.methodDeclaration!, method.methodSymbol, parameters, returnMarshallerShape, requiresMarshalling, library, nativeTypeName);
+                return new MethodStubGenerationContext(method.methodDeclaration!, method.methodSymbol, parameters, returnMarshallerShape, requiresMarshalling, returnsByOutPointer, library, nativeTypeName);
             })
             .Where(x => x != null)
             .ToArray();
@@ -2,6 +2,7 @@
 using System.Collections.Generic;
 using System.Collections.Immutable;
 using System.Linq;
+using System.Runtime.InteropServices;
 using Microsoft.CodeAnalysis;
 using Microsoft.CodeAnalysis.CSharp;
 using Microsoft.CodeAnalysis.CSharp.Syntax;
@@ -72,6 +73,88 @@ public static class SymbolExtensions
             );
     }
     
+    /// <summary>
+    /// Returns the estimated size in bytes of an unmanaged type in native memory on a 64-bit platform. The layout rules
+    /// of sequential, explicit and inline array structs are applied.
+    /// </summary>
+    public static int GetNativeSize(this ITypeSymbol type)
+    {
+        return GetNativeLayout(type).size;
+    }
+
+    private static (int size, int alignment) GetNativeLayout(ITypeSymbol type)
+    {
+        if (type.TypeKind is TypeKind.Pointer or TypeKind.FunctionPointer)
+        {
+            return (8, 8);
+        }
+
+        if (type is INamedTypeSymbol { TypeKind: TypeKind.Enum, EnumUnderlyingType: { } underlyingType })
+        {
+            return GetNativeLayout(underlyingType);
+        }
+
+        switch (type.SpecialType)
+        {
+            case SpecialType.System_Boolean:
+            case SpecialType.System_Byte:
+            case SpecialType.System_SByte:
+                return (1, 1);
+            case SpecialType.System_Char:
+            case SpecialType.System_Int16:
+            case SpecialType.System_UInt16:
+                return (2, 2);
+            case SpecialType.System_Int32:
+            case SpecialType.System_UInt32:
+            case SpecialType.System_Single:
+                return (4, 4);
+            case SpecialType.System_Int64:
+            case SpecialType.System_UInt64:
+            case SpecialType.System_Double:
+            case SpecialType.System_IntPtr:
+            case SpecialType.System_UIntPtr:
+                return (8, 8);
+        }
+
+        if (type.TypeKind != TypeKind.Struct)
+        {
+            // references
+            return (8, 8);
+        }
+
+        var explicitLayout = type.GetAttribute(Constants.StructLayoutAttributeFQN)?.ConstructorArguments[0].Value is (int)LayoutKind.Explicit;
+        var size = 0;
+        var alignment = 1;
+
+        foreach (var field in type.GetMembers().OfType<IFieldSymbol>().Where(x => !x.IsStatic))
+        {
+            var (fieldSize, fieldAlignment) = GetNativeLayout(field.Type);
+            alignment = Math.Max(alignment, fieldAlignment);
+
+            if (explicitLayout)
+            {
+                var offset = field.GetAttribute(Constants.FieldOffsetAttributeFQN)?.ConstructorArguments[0].Value as int? ?? 0;
+                size = Math.Max(size, offset + fieldSize);
+            }
+            else
+            {
+                size = Align(size, fieldAlignment) + fieldSize;
+            }
+        }
+
+        if (type.GetAttribute(Constants.InlineArrayAttributeFQN)?.ConstructorArguments[0].Value is int length)
+        {
+            size *= length;
+        }
+
+        return (Align(size, alignment), alignment);
+    }
+
+    private static int Align(int value, int alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
     private static readonly SymbolDisplayFormat _fullyQualifiedFormatWithoutGlobal =
         SymbolDisplayFormat.FullyQualifiedFormat.WithGlobalNamespaceStyle(SymbolDisplayGlobalNamespaceStyle.OmittedAsContaining);
 }
\ No newline at end of file
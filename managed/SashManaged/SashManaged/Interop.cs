@@ -1,7 +1,7 @@
 ﻿using System.Numerics;
 using System.Runtime.InteropServices;
-using System.Text;
 using SashManaged.OpenMp;
+using SashManaged.SampSharp;
 
 namespace SashManaged;
 
@@ -9,6 +9,7 @@ public class Interop : IPlayerConnectEventHandler, ICoreEventHandler, IPlayerSpa
 {
     private static ICore _core;
     private static IVehiclesComponent _vehicles;
+    private static TickArena _arena;
 
     #region Handlers
 
@@ -21,7 +22,7 @@ public class Interop : IPlayerConnectEventHandler, ICoreEventHandler, IPlayerSpa
     {
     }
 
-    public unsafe void OnPlayerConnect(IPlayer player)
+    public void OnPlayerConnect(IPlayer player)
     {
         var view = player.GetName();
 
@@ -30,12 +31,7 @@ public class Interop : IPlayerConnectEventHandler, ICoreEventHandler, IPlayerSpa
 
         var col = new Colour(255, 255, 255, 255);
 
-        var bytes = Encoding.UTF8.GetBytes($"Welcome, {view}!");
-
-        fixed (byte* pin = bytes)
-        {
-            player.SendClientMessage(ref col, new StringView(pin, bytes.Length));
-        }
+        player.SendClientMessage(ref col, _arena.Encode($"Welcome, {view}!"));
 
         Console.WriteLine("iter players...");
         foreach (var player1 in _players.Players())
@@ -53,7 +49,7 @@ public class Interop : IPlayerConnectEventHandler, ICoreEventHandler, IPlayerSpa
     {
     }
 
-    public unsafe bool OnPlayerShotMissed(IPlayer player, ref PlayerBulletData bulletData)
+    public bool OnPlayerShotMissed(IPlayer player, ref PlayerBulletData bulletData)
     {
         var col = new Colour(255, 255, 255, 255);
 
@@ -61,12 +57,7 @@ public class Interop : IPlayerConnectEventHandler, ICoreEventHandler, IPlayerSpa
             $"Your shot missed @ hit {bulletData.hitPos}, from {bulletData.origin}, offset {bulletData.offset}, weapon {bulletData.weapon} type {bulletData.hitType} id {bulletData.hitID}";
 
         Console.WriteLine(msg);
-        var bytes = Encoding.UTF8.GetBytes(msg);
-
-        fixed (byte* pin = bytes)
-        {
-            player.SendClientMessage(ref col, new StringView(pin, bytes.Length));
-        }
+        player.SendClientMessage(ref col, _arena.Encode(msg));
 
         return true;
     }
@@ -76,19 +67,15 @@ public class Interop : IPlayerConnectEventHandler, ICoreEventHandler, IPlayerSpa
         return true;
     }
 
-    public unsafe bool OnPlayerShotVehicle(IPlayer player, IVehicle target, ref PlayerBulletData bulletData)
+    public bool OnPlayerShotVehicle(IPlayer player, IVehicle target, ref PlayerBulletData bulletData)
     {
         var col = new Colour(255, 255, 255, 255);
 
         var msg =
             $"Your shot vehicle @ hit {bulletData.hitPos}, from {bulletData.origin}, offset {bulletData.offset}, weapon {bulletData.weapon} type {bulletData.hitType} id {bulletData.hitID}";
-        var bytes = Encoding.UTF8.GetBytes(msg.Substring(0, 143));
 
         Console.WriteLine(msg);
-        fixed (byte* pin = bytes)
-        {
-            player.SendClientMessage(ref col, new StringView(pin, bytes.Length));
-        }
+        player.SendClientMessage(ref col, _arena.Encode(msg.AsSpan(0, 143)));
 
         return true;
     }
@@ -192,6 +179,7 @@ public class Interop : IPlayerConnectEventHandler, ICoreEventHandler, IPlayerSpa
 
         Console.WriteLine($"alias: {alias.First} {alias.Second}");
         _vehicles = componentList.QueryComponent<IVehiclesComponent>();
+        _arena = componentList.QueryComponent<ISampSharpComponent>().GetTickArena();
 
         // test handlers
         var players = core.GetPlayers();
@@ -6,7 +6,7 @@ namespace SashManaged.OpenMp;
 public readonly partial struct IVehicle
 {
     public partial void SetSpawnData(ref VehicleSpawnData data);
-    public partial ref VehicleSpawnData GetSpawnData();
+    public partial VehicleSpawnData GetSpawnData();
     public partial bool IsStreamedInForPlayer(IPlayer player);
     public partial void StreamInForPlayer(IPlayer player);
     public partial void StreamOutForPlayer(IPlayer player);
@@ -35,7 +35,7 @@ public readonly partial struct IVehicle
     public partial float GetZAngle();
     public partial void SetParams(ref VehicleParams parms);
     public partial void SetParamsForPlayer(IPlayer player, ref VehicleParams parms);
-    public partial ref VehicleParams GetParams();
+    public partial VehicleParams GetParams();
     public partial bool IsDead();
     public partial void Respawn();
     public partial Seconds GetRespawnDelay();
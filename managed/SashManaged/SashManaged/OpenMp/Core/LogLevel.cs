@@ -0,0 +1,9 @@
+﻿namespace SashManaged.OpenMp;
+
+public enum LogLevel
+{
+    Debug,
+    Message,
+    Warning,
+    Error
+}
\ No newline at end of file
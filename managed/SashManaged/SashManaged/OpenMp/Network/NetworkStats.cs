@@ -23,7 +23,7 @@ public readonly struct NetworkStats
     public readonly double BitsPerSecond;
     public readonly double BpsSent;
     public readonly double BpsReceived;
-    public readonly bool IsActive;
+    public readonly BlittableBoolean IsActive;
     public readonly int ConnectMode;
     public readonly uint ConnectionElapsedTime;
 }
\ No newline at end of file
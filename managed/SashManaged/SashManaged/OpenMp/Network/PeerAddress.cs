@@ -1,13 +1,23 @@
-﻿using System.Runtime.InteropServices;
+﻿using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
 
 namespace SashManaged.OpenMp;
 
-[StructLayout(LayoutKind.Sequential)]
+[StructLayout(LayoutKind.Explicit)]
 public readonly struct PeerAddress
 {
-    public readonly bool Ipv6;
+    [FieldOffset(0)]
+    public readonly BlittableBoolean Ipv6;
+
+    [FieldOffset(4)]
     public readonly uint V4;
 
-    [MarshalAs(UnmanagedType.ByValArray, SizeConst = 16)]
-    public readonly byte[] Bytes;
+    [FieldOffset(4)]
+    public readonly AddressBytes Bytes;
+
+    [InlineArray(16)]
+    public struct AddressBytes
+    {
+        private byte _element0;
+    }
 }
\ No newline at end of file
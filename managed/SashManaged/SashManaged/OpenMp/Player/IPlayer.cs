@@ -8,7 +8,7 @@ public readonly partial struct IPlayer
     public partial void Kick();
     public partial void Ban(StringView reason);
     public partial bool IsBot();
-    public partial ref PeerNetworkData GetNetworkData();
+    public partial PeerNetworkData GetNetworkData();
     public partial uint GetPing();
     public partial bool SendPacket(SpanLite<byte> data, int channel, bool dispatchEvents = true);
     public partial bool SendRPC(int id, SpanLite<byte> data, int channel, bool dispatchEvents = true);
@@ -1,12 +1,11 @@
-﻿using System.Runtime.InteropServices;
+﻿using System.Runtime.CompilerServices;
 
 namespace SashManaged.OpenMp;
 
-[StructLayout(LayoutKind.Sequential)]
-public readonly struct WeaponSlots
+[InlineArray(MAX_WEAPON_SLOTS)]
+public struct WeaponSlots
 {
-    private const int MAX_WEAPON_SLOTS = 13;
+    public const int MAX_WEAPON_SLOTS = 13;
 
-    [MarshalAs(UnmanagedType.ByValArray, SizeConst = MAX_WEAPON_SLOTS)]
-    public readonly WeaponSlotData[] Data;
+    private WeaponSlotData _element0;
 }
\ No newline at end of file
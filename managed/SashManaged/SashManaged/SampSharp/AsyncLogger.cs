@@ -0,0 +1,66 @@
+﻿using System.Text.Unicode;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Logging sink for preformatted UTF-8 records which can be used from any thread. Records are copied into a bounded
+/// lock-free ring and written by a background thread to the server log or, if <c>sampsharp.logger.path</c> is
+/// configured, to a set of rotated files. Records below the minimum level are rejected before they are copied and
+/// records which do not fit in the ring are dropped, so logging never blocks the caller.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct AsyncLogger
+{
+    /// <summary>
+    /// The maximum number of bytes of a record; longer records are truncated.
+    /// </summary>
+    public const int MaxRecordSize = 480;
+
+    public partial bool Log(LogLevel level, StringView text);
+
+    public partial bool IsEnabled(LogLevel level);
+
+    public partial void SetMinLevel(LogLevel level);
+
+    public partial LogLevel GetMinLevel();
+
+    public partial bool IsRunning();
+
+    public partial Size Depth();
+
+    public partial Size Capacity();
+
+    public partial void GetStats(ref AsyncLoggerStats stats);
+
+    public partial void ResetStats();
+
+    public AsyncLoggerStats GetStats()
+    {
+        var stats = default(AsyncLoggerStats);
+        GetStats(ref stats);
+        return stats;
+    }
+
+    public unsafe bool Log(LogLevel level, ReadOnlySpan<byte> utf8)
+    {
+        fixed (byte* pointer = utf8)
+        {
+            return Log(level, StringView.Create(pointer, utf8.Length));
+        }
+    }
+
+    public bool Log(LogLevel level, ReadOnlySpan<char> text)
+    {
+        // filtered records are neither encoded nor passed to the logger, so they are not counted as filtered
+        if (!IsEnabled(level))
+        {
+            return false;
+        }
+
+        // encodes no more than the ring can hold; the few bytes beyond the maximum let the logger count the truncation
+        Span<byte> buffer = stackalloc byte[MaxRecordSize + 4];
+        Utf8.FromUtf16(text, buffer, out _, out var written);
+        return Log(level, buffer[..written]);
+    }
+}
\ No newline at end of file
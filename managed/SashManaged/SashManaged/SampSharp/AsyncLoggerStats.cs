@@ -0,0 +1,33 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct AsyncLoggerStats
+{
+    /// <summary>
+    /// The number of records accepted into the ring.
+    /// </summary>
+    public readonly ulong Accepted;
+
+    /// <summary>
+    /// The number of records below the minimum level which were passed to the logger. Text records are checked with
+    /// <see cref="AsyncLogger.IsEnabled" /> before they are encoded and are not counted.
+    /// </summary>
+    public readonly ulong Filtered;
+
+    /// <summary>
+    /// The number of records rejected because the ring was full.
+    /// </summary>
+    public readonly ulong Dropped;
+
+    /// <summary>
+    /// The number of records cut off at <see cref="AsyncLogger.MaxRecordSize" /> bytes.
+    /// </summary>
+    public readonly ulong Truncated;
+
+    public readonly ulong Written;
+    public readonly ulong Depth;
+    public readonly ulong PeakDepth;
+    public readonly ulong Rotations;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Index of the bans of the config for lookups in constant time. Addresses and names are hashed and ranges are kept in
+/// a prefix trie shared by IPv4 and IPv6. Bans added through <see cref="IConfig" /> are indexed as they are added and
+/// bans added elsewhere, such as by <c>IPlayer.Ban</c>, before the next lookup. The index is only rebuilt when bans are
+/// removed or reloaded; a removal and an addition made outside <see cref="IConfig" /> leave the number of bans
+/// unchanged and are not detected until the next <see cref="Rebuild" />. The bans of the config have no serial, so
+/// serials are banned in the index itself and are not persisted.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct BanIndex
+{
+    public partial void Rebuild();
+
+    public partial bool AddSerial(string serial);
+
+    public partial bool RemoveSerial(string serial);
+
+    public partial void ClearSerials();
+
+    /// <summary>
+    /// Looks up the address, name and serial; empty values are not looked up. Returns <see langword="true" /> if any
+    /// of them is banned.
+    /// </summary>
+    public partial bool Check(string address, string name, string serial, ref BanVerdict verdict);
+
+    /// <summary>
+    /// Looks up the address, name and serial of the player.
+    /// </summary>
+    public partial bool CheckPlayer(IPlayer player, ref BanVerdict verdict);
+
+    public partial void GetStats(ref BanIndexStats stats);
+
+    public BanVerdict CheckPlayer(IPlayer player)
+    {
+        var verdict = default(BanVerdict);
+        CheckPlayer(player, ref verdict);
+        return verdict;
+    }
+
+    public BanIndexStats GetStats()
+    {
+        var stats = default(BanIndexStats);
+        GetStats(ref stats);
+        return stats;
+    }
+}
\ No newline at end of file
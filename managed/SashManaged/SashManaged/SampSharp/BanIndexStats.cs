@@ -0,0 +1,33 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct BanIndexStats
+{
+    public readonly ulong Checks;
+
+    public readonly ulong Hits;
+
+    public readonly ulong Rebuilds;
+
+    /// <summary>
+    /// The time spent on the last rebuild.
+    /// </summary>
+    public readonly ulong RebuildNanoseconds;
+
+    public readonly uint Bans;
+
+    public readonly uint Addresses;
+
+    public readonly uint Ranges;
+
+    public readonly uint Names;
+
+    public readonly uint Serials;
+
+    /// <summary>
+    /// The number of bans with an address which is neither an address nor a range.
+    /// </summary>
+    public readonly uint Invalid;
+}
\ No newline at end of file
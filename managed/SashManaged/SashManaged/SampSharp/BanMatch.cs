@@ -0,0 +1,27 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum BanMatch : byte
+{
+    None,
+
+    /// <summary>
+    /// The address of a ban.
+    /// </summary>
+    Address,
+
+    /// <summary>
+    /// A range of a ban, written as a prefix length (<c>1.2.3.0/24</c>) or with wildcards (<c>1.2.*.*</c>).
+    /// </summary>
+    Range,
+
+    /// <summary>
+    /// The name of a ban without an address, which is matched case-insensitively. The name of an address ban is
+    /// informational and is not matched.
+    /// </summary>
+    Name,
+
+    /// <summary>
+    /// A serial added to the index.
+    /// </summary>
+    Serial
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct BanVerdict
+{
+    public readonly BanMatch Match;
+
+    private readonly byte _reserved0;
+    private readonly byte _reserved1;
+    private readonly byte _reserved2;
+
+    /// <summary>
+    /// The index of the matching ban in the bans of the config, or -1 for serials.
+    /// </summary>
+    public readonly int Index;
+
+    public bool IsBanned => Match != BanMatch.None;
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Decodes network bit streams into blittable structs and encodes structs into bit streams following a schema which is
+/// registered once, so a packet or RPC is read or written with a single native call instead of one per field. Decoded
+/// strings are valid until the next decode and encoded data until the next encode. Must only be used from the server
+/// thread.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct BitStreamCodec
+{
+    public partial int AddSchema(nint fields, Size count, Size size);
+
+    public partial Size GetSchemaCount();
+
+    public partial bool Decode(int schema, NetworkBitStream bs, nint output, Size size);
+
+    public partial bool DecodeBytes(int schema, nint data, Size bits, ref Size offset, nint output, Size size);
+
+    public partial bool Encode(int schema, nint input, Size size);
+
+    public partial nint GetData();
+
+    public partial Size GetLength();
+
+    public partial Size GetBitLength();
+
+    public partial bool SendRPC(IPlayer player, int id, int schema, nint input, Size size, int channel);
+
+    public partial bool SendPacket(IPlayer player, int schema, nint input, Size size, int channel);
+
+    /// <summary>
+    /// Registers a schema for <typeparamref name="T" /> and returns its ID or -1 if a field is invalid or does not fit
+    /// in the struct.
+    /// </summary>
+    public unsafe int AddSchema<T>(ReadOnlySpan<BitStreamField> fields) where T : unmanaged
+    {
+        fixed (BitStreamField* ptr = fields)
+        {
+            return AddSchema((nint)ptr, fields.Length, sizeof(T));
+        }
+    }
+
+    /// <summary>
+    /// Decodes the fields from the read offset of the bit stream and advances the read offset.
+    /// </summary>
+    public unsafe bool Decode<T>(int schema, NetworkBitStream bs, out T value) where T : unmanaged
+    {
+        value = default;
+        fixed (T* ptr = &value)
+        {
+            return Decode(schema, bs, (nint)ptr, sizeof(T));
+        }
+    }
+
+    public unsafe bool Decode<T>(int schema, ReadOnlySpan<byte> data, out T value) where T : unmanaged
+    {
+        value = default;
+        var offset = new Size(0);
+        fixed (byte* dataPtr = data)
+        fixed (T* ptr = &value)
+        {
+            return DecodeBytes(schema, (nint)dataPtr, data.Length * 8, ref offset, (nint)ptr, sizeof(T));
+        }
+    }
+
+    /// <summary>
+    /// Encodes the value and returns the encoded data or an empty span if the value could not be encoded.
+    /// </summary>
+    public unsafe ReadOnlySpan<byte> Encode<T>(int schema, in T value) where T : unmanaged
+    {
+        fixed (T* ptr = &value)
+        {
+            if (!Encode(schema, (nint)ptr, sizeof(T)))
+            {
+                return ReadOnlySpan<byte>.Empty;
+            }
+        }
+
+        return new ReadOnlySpan<byte>((void*)GetData(), (int)GetLength().Value);
+    }
+
+    public unsafe bool SendRPC<T>(IPlayer player, int id, int schema, in T value, int channel) where T : unmanaged
+    {
+        fixed (T* ptr = &value)
+        {
+            return SendRPC(player, id, schema, (nint)ptr, sizeof(T), channel);
+        }
+    }
+
+    public unsafe bool SendPacket<T>(IPlayer player, int schema, in T value, int channel) where T : unmanaged
+    {
+        fixed (T* ptr = &value)
+        {
+            return SendPacket(player, schema, (nint)ptr, sizeof(T), channel);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+﻿using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Field of a <see cref="BitStreamCodec" /> schema.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct BitStreamField
+{
+    public readonly BitStreamFieldType Type;
+
+    /// <summary>
+    /// Number of bits of an integer on the wire (all bits of the type if 0) or the number of bits skipped by a
+    /// <see cref="BitStreamFieldType.Skip" /> field.
+    /// </summary>
+    public readonly byte Bits;
+
+    private readonly ushort _reserved;
+
+    /// <summary>
+    /// Offset of the value in the struct.
+    /// </summary>
+    public readonly uint Offset;
+
+    public BitStreamField(BitStreamFieldType type, uint offset, byte bits = 0)
+    {
+        Type = type;
+        Offset = offset;
+        Bits = bits;
+    }
+
+    /// <summary>
+    /// Creates a field for the field of <typeparamref name="T" /> returned by the selector, for example
+    /// <c>Of((ref Sync s) => ref s.Health, BitStreamFieldType.Float)</c>. The offset is measured on a value of
+    /// <typeparamref name="T" />, so it is the offset the codec writes to, unlike the marshalled offset which differs
+    /// for <see langword="bool" /> and <see langword="char" /> fields.
+    /// </summary>
+    public static BitStreamField Of<T, TField>(BitStreamFieldSelector<T, TField> selector, BitStreamFieldType type, byte bits = 0)
+        where T : unmanaged where TField : unmanaged
+    {
+        var value = default(T);
+        ref var field = ref selector(ref value);
+        var offset = Unsafe.ByteOffset(ref Unsafe.As<T, byte>(ref value), ref Unsafe.As<TField, byte>(ref field));
+        if (offset < 0 || offset + Unsafe.SizeOf<TField>() > Unsafe.SizeOf<T>())
+        {
+            throw new ArgumentException("The selector must return a field of the value.", nameof(selector));
+        }
+
+        return new BitStreamField(type, (uint)offset, bits);
+    }
+
+    public static BitStreamField Skip(byte bits)
+    {
+        return new BitStreamField(BitStreamFieldType.Skip, 0, bits);
+    }
+
+    public static BitStreamField Align()
+    {
+        return new BitStreamField(BitStreamFieldType.Align, 0);
+    }
+}
\ No newline at end of file
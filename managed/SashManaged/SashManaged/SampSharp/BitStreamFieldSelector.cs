@@ -0,0 +1,6 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Returns a reference to a field of the value, which locates the field for <see cref="BitStreamField.Of{T,TField}" />.
+/// </summary>
+public delegate ref TField BitStreamFieldSelector<T, TField>(ref T value) where T : unmanaged where TField : unmanaged;
\ No newline at end of file
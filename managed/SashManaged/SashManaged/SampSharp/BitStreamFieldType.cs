@@ -0,0 +1,36 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum BitStreamFieldType : byte
+{
+    /// <summary>Single bit stored as a byte.</summary>
+    Bool,
+    UInt8,
+    UInt16,
+    UInt32,
+    UInt64,
+    Int8,
+    Int16,
+    Int32,
+    Int64,
+    Float,
+    Double,
+    Vector2,
+    Vector3,
+    Vector4,
+    /// <summary>Four floats in w, x, y, z order.</summary>
+    Quat,
+    /// <summary>Float in [-1, 1] compressed to 16 bits.</summary>
+    CompressedFloat,
+    /// <summary>Normalized quaternion compressed to 4 sign bits and 3 x 16 bits; stored as four floats in w, x, y, z order.</summary>
+    CompressedQuat,
+    /// <summary>String with an 8 bit length prefix stored as a <see cref="SashManaged.OpenMp.StringView" />.</summary>
+    String8,
+    /// <summary>String with a 16 bit length prefix stored as a <see cref="SashManaged.OpenMp.StringView" />.</summary>
+    String16,
+    /// <summary>String with a 32 bit length prefix stored as a <see cref="SashManaged.OpenMp.StringView" />.</summary>
+    String32,
+    /// <summary>Skips the bits of the field; nothing is stored.</summary>
+    Skip,
+    /// <summary>Skips to the next byte boundary; nothing is stored.</summary>
+    Align
+}
\ No newline at end of file
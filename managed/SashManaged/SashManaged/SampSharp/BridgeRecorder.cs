@@ -0,0 +1,25 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Records every event passed to a managed event handler, with its arguments and timestamp, into memory-mapped segment
+/// files (<c>&lt;prefix&gt;.0000.ssbr</c>, <c>&lt;prefix&gt;.0001.ssbr</c>, ...). Recording can also be enabled from
+/// startup with the <c>sampsharp.bridge_recorder.path</c> configuration option.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct BridgeRecorder
+{
+    public partial bool Start(string prefix);
+
+    public partial void Stop();
+
+    public partial bool IsRecording();
+
+    public partial void GetStats(ref BridgeRecorderStats stats);
+
+    public BridgeRecorderStats GetStats()
+    {
+        var stats = default(BridgeRecorderStats);
+        GetStats(ref stats);
+        return stats;
+    }
+}
@@ -0,0 +1,17 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct BridgeRecorderStats
+{
+    public readonly ulong Records;
+    public readonly ulong Bytes;
+    public readonly ulong Dropped;
+    public readonly ulong Segments;
+
+    /// <summary>
+    /// The number of segments which could not be truncated to their records when closed.
+    /// </summary>
+    public readonly ulong TruncateFailures;
+}
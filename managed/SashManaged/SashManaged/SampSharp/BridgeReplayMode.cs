@@ -0,0 +1,14 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum BridgeReplayMode : byte
+{
+    /// <summary>
+    /// Events are replayed with the timing at which they were recorded.
+    /// </summary>
+    Recorded,
+
+    /// <summary>
+    /// All events are replayed during the next tick.
+    /// </summary>
+    Maximum
+}
@@ -0,0 +1,29 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct BridgeReplayStats
+{
+    public readonly ulong Records;
+    public readonly ulong Replayed;
+
+    /// <summary>
+    /// The number of events which could not be replayed because an argument was not recorded or an entity could not be
+    /// mapped.
+    /// </summary>
+    public readonly ulong Skipped;
+
+    /// <summary>
+    /// The number of managed handler invocations. Connects and disconnects of stand-in players are dispatched by the
+    /// server and not counted.
+    /// </summary>
+    public readonly ulong Invocations;
+    public readonly ulong HandlerNanoseconds;
+    public readonly ulong ElapsedNanoseconds;
+
+    /// <summary>
+    /// The recorded time of the last replayed event.
+    /// </summary>
+    public readonly ulong RecordedNanoseconds;
+}
@@ -0,0 +1,27 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Replays a recording of the <see cref="BridgeRecorder" /> into the managed event handlers during the tick of the
+/// component. Recorded players are replayed as NPCs, other entities as the live entity with the recorded ID or a
+/// stand-in created for the replay, so a recording can be replayed without its players and entities. Every recorded
+/// entity is passed as the same open.mp entity until it is destroyed. The stand-ins are destroyed when the replay ends.
+/// Events of which an entity cannot be mapped, e.g. players without the NPC component, are skipped.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct BridgeReplayer
+{
+    public partial bool Start(string prefix, BridgeReplayMode mode);
+
+    public partial void Stop();
+
+    public partial bool IsReplaying();
+
+    public partial void GetStats(ref BridgeReplayStats stats);
+
+    public BridgeReplayStats GetStats()
+    {
+        var stats = default(BridgeReplayStats);
+        GetStats(ref stats);
+        return stats;
+    }
+}
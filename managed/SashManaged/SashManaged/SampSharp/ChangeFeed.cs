@@ -0,0 +1,46 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Native tracking of the properties of players and vehicles which changed. Changes are accumulated from event
+/// handlers and sync updates and published at the start of every tick of the SampSharp component as a list of the
+/// entities which changed since the previous tick, so incremental systems only visit what changed. The list is valid
+/// until the next tick.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct ChangeFeed
+{
+    public partial nint GetChanges(EntityTableType type);
+
+    public partial Size GetChangeCount(EntityTableType type);
+
+    public partial uint GetMask(EntityTableType type, int id);
+
+    /// <summary>
+    /// Returns the changes of the entity type published at the start of the current tick. Only players and vehicles
+    /// are tracked.
+    /// </summary>
+    public unsafe ReadOnlySpan<EntityChange> GetChangeSpan(EntityTableType type)
+    {
+        return new ReadOnlySpan<EntityChange>((void*)GetChanges(type), (int)GetChangeCount(type).Value);
+    }
+
+    public ReadOnlySpan<EntityChange> GetPlayerChanges()
+    {
+        return GetChangeSpan(EntityTableType.Player);
+    }
+
+    public ReadOnlySpan<EntityChange> GetVehicleChanges()
+    {
+        return GetChangeSpan(EntityTableType.Vehicle);
+    }
+
+    public PlayerChange GetPlayerMask(int playerId)
+    {
+        return (PlayerChange)GetMask(EntityTableType.Player, playerId);
+    }
+
+    public VehicleChange GetVehicleMask(int vehicleId)
+    {
+        return (VehicleChange)GetMask(EntityTableType.Vehicle, vehicleId);
+    }
+}
\ No newline at end of file
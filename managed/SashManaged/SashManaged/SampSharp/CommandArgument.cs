@@ -0,0 +1,19 @@
+﻿using System.Runtime.InteropServices;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// An argument of a routed command as a range of the UTF-8 command text.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct CommandArgument
+{
+    public readonly uint Offset;
+    public readonly uint Length;
+
+    public ReadOnlySpan<byte> GetValue(StringView text)
+    {
+        return text.AsSpan().Slice((int)Offset, (int)Length);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Routes player commands natively by name before they reach the managed event handlers. Names are matched
+/// case-insensitively and several names (aliases) may share a command ID. Matched commands are passed to the handler
+/// by ID with the arguments as ranges of the command text. Unknown commands are answered with the default reply if one
+/// is set; otherwise they continue to the <c>OnPlayerCommandText</c> handlers.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct CommandRouter
+{
+    /// <summary>
+    /// Arguments beyond this number are included in the last argument.
+    /// </summary>
+    public const int MaxArguments = 32;
+
+    public partial void SetHandler(nint handler);
+
+    public partial bool AddCommand(string name, int id);
+
+    public partial bool AddAlias(string alias, string name);
+
+    public partial bool RemoveName(string name);
+
+    public partial void RemoveCommand(int id);
+
+    public partial void Clear();
+
+    public partial int Find(string name);
+
+    public partial void SetDefaultReply(string message, Colour colour);
+
+    public partial void GetStats(ref CommandRouterStats stats);
+
+    public CommandRouterStats GetStats()
+    {
+        var stats = default(CommandRouterStats);
+        GetStats(ref stats);
+        return stats;
+    }
+
+    public unsafe void SetHandler(delegate* unmanaged<IPlayer, int, StringView, CommandArgument*, Size, BlittableBoolean> handler)
+    {
+        SetHandler((nint)handler);
+    }
+}
\ No newline at end of file
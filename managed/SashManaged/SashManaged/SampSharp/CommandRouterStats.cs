@@ -0,0 +1,11 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct CommandRouterStats
+{
+    public readonly ulong Routed;
+    public readonly ulong Unknown;
+    public readonly ulong Replied;
+}
\ No newline at end of file
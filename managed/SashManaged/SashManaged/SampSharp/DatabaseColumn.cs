@@ -0,0 +1,17 @@
+﻿using System.Runtime.InteropServices;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Column of a <see cref="DatabaseResult" />. A value is an integer, the bits of a double or the offset of text or blob
+/// data in the data block of the result, depending on its type.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly unsafe struct DatabaseColumn
+{
+    public readonly StringView Name;
+    public readonly DatabaseValueType* Types;
+    public readonly long* Values;
+    public readonly uint* Lengths;
+}
\ No newline at end of file
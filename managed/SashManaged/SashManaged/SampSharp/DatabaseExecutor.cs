@@ -0,0 +1,79 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Executes SQLite queries on a pool of worker threads. Each connection is bound to one worker, so its queries execute
+/// in submission order. Result sets are materialised into columnar buffers on the worker and the completion callbacks
+/// are invoked in a batch on the server thread during the tick. The number of workers and the capacity of their queues
+/// are configured with <c>sampsharp.database.workers</c> and <c>sampsharp.database.queue_capacity</c>. Statements are
+/// prepared on the worker of their connection as well. The executor is only available in components built with the
+/// <c>SAMPSHARP_DATABASE</c> CMake option, which is on by default; otherwise
+/// <see cref="ISampSharpComponent.GetDatabaseExecutor" /> returns an executor whose <see cref="Handle" /> is 0.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct DatabaseExecutor
+{
+    /// <summary>
+    /// Opens or creates the database file and returns its connection ID, or -1 on failure; see <see cref="GetLastError" />.
+    /// </summary>
+    public partial int Open(string path);
+
+    /// <summary>
+    /// Closes the connection and its statements after its pending queries have been executed.
+    /// </summary>
+    public partial bool Close(int connection);
+
+    public partial ulong Prepare(int connection, string sql, nint callback, nint state);
+
+    public partial bool Finalize(int statement);
+
+    public partial string GetLastError();
+
+    public partial ulong Execute(int connection, string sql, nint parameters, Size count, nint callback, nint state);
+
+    public partial ulong ExecuteStatement(int statement, nint parameters, Size count, nint callback, nint state);
+
+    public partial void GetStats(ref DatabaseExecutorStats stats);
+
+    public partial void ResetStats();
+
+    public DatabaseExecutorStats GetStats()
+    {
+        var stats = default(DatabaseExecutorStats);
+        GetStats(ref stats);
+        return stats;
+    }
+
+    /// <summary>
+    /// Submits the SQL text with the parameters bound to its first statement. Returns the query ID, or 0 if the
+    /// connection does not exist or its queue is full.
+    /// </summary>
+    public unsafe ulong Execute(int connection, string sql, ReadOnlySpan<DatabaseValue> parameters, delegate* unmanaged<DatabaseResult*, nint, void> callback, nint state)
+    {
+        fixed (DatabaseValue* pointer = parameters)
+        {
+            return Execute(connection, sql, (nint)pointer, parameters.Length, (nint)callback, state);
+        }
+    }
+
+    /// <summary>
+    /// Submits the preparation of a statement of the connection. The completion carries the ID of the statement in
+    /// <see cref="DatabaseResult.Statement" />, which can be executed from then on. Returns the query ID, or 0 if the
+    /// connection does not exist or its queue is full.
+    /// </summary>
+    public unsafe ulong Prepare(int connection, string sql, delegate* unmanaged<DatabaseResult*, nint, void> callback, nint state)
+    {
+        return Prepare(connection, sql, (nint)callback, state);
+    }
+
+    /// <summary>
+    /// Submits the prepared statement with the parameters. Returns the query ID, or 0 if the statement does not exist,
+    /// its preparation has not completed or the queue of its connection is full.
+    /// </summary>
+    public unsafe ulong ExecuteStatement(int statement, ReadOnlySpan<DatabaseValue> parameters, delegate* unmanaged<DatabaseResult*, nint, void> callback, nint state)
+    {
+        fixed (DatabaseValue* pointer = parameters)
+        {
+            return ExecuteStatement(statement, (nint)pointer, parameters.Length, (nint)callback, state);
+        }
+    }
+}
\ No newline at end of file
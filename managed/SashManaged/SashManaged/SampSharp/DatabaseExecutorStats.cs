@@ -0,0 +1,22 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct DatabaseExecutorStats
+{
+    public readonly ulong Submitted;
+    public readonly ulong Completed;
+    public readonly ulong Failed;
+
+    /// <summary>
+    /// The number of queries rejected because the queue of the connection was full.
+    /// </summary>
+    public readonly ulong Rejected;
+
+    public readonly ulong Pending;
+    public readonly ulong TotalQueueNanoseconds;
+    public readonly ulong TotalExecuteNanoseconds;
+    public readonly ulong MaxExecuteNanoseconds;
+    public readonly ulong LastDispatchNanoseconds;
+}
\ No newline at end of file
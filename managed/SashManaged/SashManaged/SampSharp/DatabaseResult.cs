@@ -0,0 +1,134 @@
+﻿using System.Runtime.InteropServices;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Result of a query of the <see cref="DatabaseExecutor" />. The result and its data are only valid during the
+/// completion callback.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly unsafe struct DatabaseResult
+{
+    public readonly ulong Query;
+
+    /// <summary>
+    /// The SQLite result code of the query; 0 on success.
+    /// </summary>
+    public readonly int Status;
+
+    public readonly uint ColumnCount;
+    public readonly ulong RowCount;
+    private readonly DatabaseColumn* _columns;
+    private readonly byte* _data;
+    public readonly long Changes;
+    public readonly long LastInsertId;
+    public readonly StringView Error;
+
+    /// <summary>
+    /// The time between the submission and the start of the execution of the query.
+    /// </summary>
+    public readonly ulong QueueNanoseconds;
+
+    public readonly ulong ExecuteNanoseconds;
+
+    /// <summary>
+    /// The ID of the statement prepared by a <see cref="DatabaseExecutor.Prepare(int, string, nint, nint)" /> query,
+    /// or -1 if it failed or the query was not a prepare.
+    /// </summary>
+    public readonly int Statement;
+
+    public bool IsSuccess => Status == 0;
+
+    public ref readonly DatabaseColumn GetColumn(int column)
+    {
+        ArgumentOutOfRangeException.ThrowIfGreaterThanOrEqual((uint)column, ColumnCount, nameof(column));
+        return ref _columns[column];
+    }
+
+    /// <summary>
+    /// Returns the index of the column with the specified name or -1 if the result has no such column.
+    /// </summary>
+    public int FindColumn(string name)
+    {
+        for (var i = 0; i < ColumnCount; i++)
+        {
+            if (_columns[i].Name.ToString() == name)
+            {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    public DatabaseValueType GetValueType(int column, int row)
+    {
+        return GetColumn(column).Types[CheckRow(row)];
+    }
+
+    public bool IsNull(int column, int row)
+    {
+        return GetValueType(column, row) == DatabaseValueType.Null;
+    }
+
+    /// <summary>
+    /// Returns the value as an integer. Floats are truncated; text, blobs and nulls are 0.
+    /// </summary>
+    public long GetInteger(int column, int row)
+    {
+        ref readonly var col = ref GetColumn(column);
+        row = CheckRow(row);
+
+        return col.Types[row] switch
+        {
+            DatabaseValueType.Integer => col.Values[row],
+            DatabaseValueType.Float => (long)BitConverter.Int64BitsToDouble(col.Values[row]),
+            _ => 0
+        };
+    }
+
+    /// <summary>
+    /// Returns the value as a double. Text, blobs and nulls are 0.
+    /// </summary>
+    public double GetFloat(int column, int row)
+    {
+        ref readonly var col = ref GetColumn(column);
+        row = CheckRow(row);
+
+        return col.Types[row] switch
+        {
+            DatabaseValueType.Integer => col.Values[row],
+            DatabaseValueType.Float => BitConverter.Int64BitsToDouble(col.Values[row]),
+            _ => 0
+        };
+    }
+
+    /// <summary>
+    /// Returns the UTF-8 text or the blob data of the value; empty for other types.
+    /// </summary>
+    public ReadOnlySpan<byte> GetBytes(int column, int row)
+    {
+        ref readonly var col = ref GetColumn(column);
+        row = CheckRow(row);
+
+        return col.Types[row] is DatabaseValueType.Text or DatabaseValueType.Blob
+            ? new ReadOnlySpan<byte>(_data + col.Values[row], (int)col.Lengths[row])
+            : ReadOnlySpan<byte>.Empty;
+    }
+
+    public StringView GetText(int column, int row)
+    {
+        var bytes = GetBytes(column, row);
+        fixed (byte* pointer = bytes)
+        {
+            return StringView.Create(pointer, bytes.Length);
+        }
+    }
+
+    private int CheckRow(int row)
+    {
+        ArgumentOutOfRangeException.ThrowIfGreaterThanOrEqual((ulong)row, RowCount, nameof(row));
+        return row;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Parameter of a query of the <see cref="DatabaseExecutor" />. Text and blob data only need to remain valid until the
+/// query has been submitted; it is copied by the executor.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly unsafe struct DatabaseValue
+{
+    public readonly DatabaseValueType Type;
+    public readonly long Integer;
+    public readonly double Float;
+    public readonly byte* Data;
+    public readonly Size Length;
+
+    private DatabaseValue(DatabaseValueType type, long integer, double value, byte* data, Size length)
+    {
+        Type = type;
+        Integer = integer;
+        Float = value;
+        Data = data;
+        Length = length;
+    }
+
+    public static DatabaseValue Null => default;
+
+    public static DatabaseValue FromInteger(long value)
+    {
+        return new DatabaseValue(DatabaseValueType.Integer, value, 0, null, 0);
+    }
+
+    public static DatabaseValue FromFloat(double value)
+    {
+        return new DatabaseValue(DatabaseValueType.Float, 0, value, null, 0);
+    }
+
+    /// <summary>
+    /// Creates a text value of UTF-8 data. The data must be pinned until the query has been submitted.
+    /// </summary>
+    public static DatabaseValue FromText(byte* utf8, int length)
+    {
+        return new DatabaseValue(DatabaseValueType.Text, 0, 0, utf8, length);
+    }
+
+    /// <summary>
+    /// Creates a blob value. The data must be pinned until the query has been submitted.
+    /// </summary>
+    public static DatabaseValue FromBlob(byte* data, int length)
+    {
+        return new DatabaseValue(DatabaseValueType.Blob, 0, 0, data, length);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum DatabaseValueType : byte
+{
+    Null,
+    Integer,
+    Float,
+    Text,
+    Blob
+}
\ No newline at end of file
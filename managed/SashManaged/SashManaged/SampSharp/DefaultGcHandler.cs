@@ -0,0 +1,85 @@
+﻿using System.Runtime;
+using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Handler of the <see cref="GcCoordinator" /> which runs the requests with the <see cref="GC" /> of this runtime.
+/// </summary>
+internal static class DefaultGcHandler
+{
+    private static GCLatencyMode _previousLatencyMode;
+
+    [UnmanagedCallersOnly]
+    public static unsafe void Handle(GcRequest* request, GcReport* report)
+    {
+        report->Succeeded = false;
+
+        try
+        {
+            switch (request->Command)
+            {
+                case GcCommand.Collect:
+                    GC.Collect(request->Generation, GCCollectionMode.Forced, request->Blocking, false);
+                    break;
+                case GcCommand.BeginCritical:
+                    report->Succeeded = EnterCriticalMode(request->NoGcRegionSize);
+                    break;
+                case GcCommand.EndCritical:
+                    LeaveCriticalMode();
+                    break;
+            }
+        }
+        catch (Exception)
+        {
+            // a failed request must not escape into the tick; a failed critical mode is reported by Succeeded
+        }
+
+        report->PauseMicroseconds = (ulong)(GC.GetTotalPauseDuration().Ticks / TimeSpan.TicksPerMicrosecond);
+        report->AllocatedBytes = (ulong)GC.GetTotalAllocatedBytes();
+        report->Gen0Collections = (uint)GC.CollectionCount(0);
+        report->Gen1Collections = (uint)GC.CollectionCount(1);
+        report->Gen2Collections = (uint)GC.CollectionCount(2);
+    }
+
+    private static bool EnterCriticalMode(ulong noGcRegionSize)
+    {
+        _previousLatencyMode = GCSettings.LatencyMode;
+
+        try
+        {
+            if (noGcRegionSize > 0 && noGcRegionSize <= long.MaxValue && GC.TryStartNoGCRegion((long)noGcRegionSize))
+            {
+                return true;
+            }
+        }
+        catch (ArgumentOutOfRangeException)
+        {
+            // the region is larger than the ephemeral segment
+        }
+        catch (InvalidOperationException)
+        {
+            // a no-GC region is already in progress
+        }
+
+        GCSettings.LatencyMode = GCLatencyMode.SustainedLowLatency;
+        return false;
+    }
+
+    private static void LeaveCriticalMode()
+    {
+        if (GCSettings.LatencyMode == GCLatencyMode.NoGCRegion)
+        {
+            try
+            {
+                GC.EndNoGCRegion();
+            }
+            catch (InvalidOperationException)
+            {
+                // the region was left because more memory was allocated than requested
+            }
+        }
+
+        GCSettings.LatencyMode = _previousLatencyMode;
+    }
+}
\ No newline at end of file
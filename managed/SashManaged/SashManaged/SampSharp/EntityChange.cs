@@ -0,0 +1,18 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Entity which changed during a tick and the mask of the properties which changed. The mask is a
+/// <see cref="PlayerChange" /> or <see cref="VehicleChange" /> value depending on the type of the entity.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct EntityChange
+{
+    public readonly int Id;
+    public readonly uint Mask;
+
+    public PlayerChange PlayerChanges => (PlayerChange)Mask;
+
+    public VehicleChange VehicleChanges => (VehicleChange)Mask;
+}
\ No newline at end of file
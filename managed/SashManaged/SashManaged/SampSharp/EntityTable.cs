@@ -0,0 +1,49 @@
+﻿using System.Runtime.InteropServices;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Dense native table of the entries of an open.mp pool indexed by pool ID. The table is kept in sync by pool event
+/// handlers of the SampSharp component. The slots live in native memory and never move.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct EntityTable
+{
+    public partial ref EntityTableSlot Slots();
+
+    public partial ref int Ids();
+
+    public partial Size Capacity();
+
+    public partial Size Count();
+
+    public partial nint Get(int id);
+
+    /// <summary>
+    /// Returns the handle of the entity or 0 if the slot is empty. Generations are never 0, so 0 is never a valid
+    /// handle.
+    /// </summary>
+    public partial ulong GetHandle(int id);
+
+    /// <summary>
+    /// Returns the entity referenced by the handle or 0 if the entity has been destroyed since the handle was created.
+    /// </summary>
+    public partial nint Resolve(ulong handle);
+
+    /// <summary>
+    /// Returns a span over all slots of the table, indexed by pool ID.
+    /// </summary>
+    public ReadOnlySpan<EntityTableSlot> GetSlots()
+    {
+        return MemoryMarshal.CreateReadOnlySpan(ref Slots(), (int)Capacity().Value);
+    }
+
+    /// <summary>
+    /// Returns a span over the IDs of the live entries. The span is invalidated when an entry is created or destroyed.
+    /// </summary>
+    public ReadOnlySpan<int> GetIds()
+    {
+        return MemoryMarshal.CreateReadOnlySpan(ref Ids(), (int)Count().Value);
+    }
+}
@@ -0,0 +1,21 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct EntityTableSlot
+{
+    public readonly nint Entity;
+    public readonly uint Generation;
+    public readonly int DenseIndex;
+
+    public bool IsAlive => Entity != 0;
+
+    /// <summary>
+    /// Gets a handle of this slot which can be resolved as long as the entity in this slot is alive.
+    /// </summary>
+    public ulong GetHandle(int id)
+    {
+        return (ulong)Generation << 32 | (uint)id;
+    }
+}
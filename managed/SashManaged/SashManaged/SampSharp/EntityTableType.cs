@@ -0,0 +1,11 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum EntityTableType
+{
+    Player,
+    Vehicle,
+    Object,
+    Pickup,
+    TextLabel,
+    GangZone
+}
@@ -0,0 +1,24 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum GcCommand : uint
+{
+    /// <summary>
+    /// Report the counters of the runtime without collecting.
+    /// </summary>
+    Sample,
+
+    /// <summary>
+    /// Collect the requested generation.
+    /// </summary>
+    Collect,
+
+    /// <summary>
+    /// Enter a no-GC region of the requested size, or sustained low latency mode if the region cannot be entered.
+    /// </summary>
+    BeginCritical,
+
+    /// <summary>
+    /// Leave the no-GC region or low latency mode and restore the previous latency mode.
+    /// </summary>
+    EndCritical
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Native scheduling of collections into the slack of the server tick loop. The runtime is sampled through the handler
+/// at the start of every tick so pauses are recorded against the tick in which they happened. Collections are induced
+/// at the end of a tick which leaves enough of the budget. During critical windows no collections are induced and the
+/// runtime is kept in a no-GC region or sustained low latency mode. The coordinator is inactive until a handler is set,
+/// for example through <see cref="UseDefaultHandler" />.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct GcCoordinator
+{
+    public partial void SetConfig(ref GcCoordinatorConfig config);
+
+    public partial void GetConfig(ref GcCoordinatorConfig config);
+
+    public partial void GetStats(ref GcCoordinatorStats stats);
+
+    public partial void SetHandler(nint handler);
+
+    /// <summary>
+    /// Starts a critical window lasting the number of ticks, or until <see cref="EndCritical" /> is called if
+    /// <paramref name="ticks" /> is 0.
+    /// </summary>
+    public partial void BeginCritical(uint ticks);
+
+    public partial void EndCritical();
+
+    public partial bool IsCritical();
+
+    public GcCoordinatorConfig GetConfig()
+    {
+        var config = default(GcCoordinatorConfig);
+        GetConfig(ref config);
+        return config;
+    }
+
+    public GcCoordinatorStats GetStats()
+    {
+        var stats = default(GcCoordinatorStats);
+        GetStats(ref stats);
+        return stats;
+    }
+
+    public unsafe void SetHandler(delegate* unmanaged<GcRequest*, GcReport*, void> handler)
+    {
+        SetHandler((nint)handler);
+    }
+
+    /// <summary>
+    /// Sets the handler which runs the requests with the <see cref="GC" /> of this runtime.
+    /// </summary>
+    public unsafe void UseDefaultHandler()
+    {
+        SetHandler(&DefaultGcHandler.Handle);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public struct GcCoordinatorConfig
+{
+    /// <summary>
+    /// The tick interval the server may reach before a tick counts as a hitch.
+    /// </summary>
+    public uint BudgetMicroseconds;
+
+    /// <summary>
+    /// The sleep of the server between ticks while the <see cref="TickPacer" /> is disabled.
+    /// </summary>
+    public uint SleepMicroseconds;
+
+    /// <summary>
+    /// The slack required for a collection of generation 1, or 0 to disable induced collections.
+    /// </summary>
+    public uint MinSlackMicroseconds;
+
+    /// <summary>
+    /// The slack required for a full collection, or 0 to disable induced full collections.
+    /// </summary>
+    public uint FullSlackMicroseconds;
+
+    /// <summary>
+    /// The number of ticks between induced collections.
+    /// </summary>
+    public uint MinIntervalTicks;
+
+    /// <summary>
+    /// Whether induced full collections block instead of running in the background.
+    /// </summary>
+    public BlittableBoolean BlockingFull;
+
+    /// <summary>
+    /// The number of bytes allocated since the previous induced collection before another is induced.
+    /// </summary>
+    public ulong AllocationThreshold;
+
+    /// <summary>
+    /// The number of bytes allocated since the previous induced full collection before another is induced.
+    /// </summary>
+    public ulong FullAllocationThreshold;
+
+    /// <summary>
+    /// The size of the no-GC region requested for critical windows, or 0 to only enable sustained low latency mode.
+    /// </summary>
+    public ulong NoGcRegionSize;
+}
\ No newline at end of file
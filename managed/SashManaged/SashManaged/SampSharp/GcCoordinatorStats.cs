@@ -0,0 +1,58 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct GcCoordinatorStats
+{
+    public readonly ulong Ticks;
+
+    /// <summary>
+    /// The sum of the intervals between ticks.
+    /// </summary>
+    public readonly ulong TickMicroseconds;
+
+    /// <summary>
+    /// The number of ticks in which the runtime paused for collections which were not induced by the coordinator.
+    /// </summary>
+    public readonly ulong PausedTicks;
+
+    public readonly ulong PauseMicroseconds;
+
+    /// <summary>
+    /// The longest pause which was not induced within a single tick.
+    /// </summary>
+    public readonly ulong MaxPauseMicroseconds;
+
+    /// <summary>
+    /// The number of ticks with an interval beyond the budget.
+    /// </summary>
+    public readonly ulong Hitches;
+
+    /// <summary>
+    /// The number of hitches in which the runtime paused for a collection which was not induced.
+    /// </summary>
+    public readonly ulong PausedHitches;
+
+    public readonly ulong InducedCollections;
+    public readonly ulong InducedFullCollections;
+    public readonly ulong InducedPauseMicroseconds;
+    public readonly ulong CriticalWindows;
+
+    /// <summary>
+    /// The number of critical windows in which a no-GC region was entered.
+    /// </summary>
+    public readonly ulong NoGcRegions;
+
+    public readonly uint Gen0Collections;
+    public readonly uint Gen1Collections;
+    public readonly uint Gen2Collections;
+    public readonly uint SlackMicroseconds;
+
+    /// <summary>
+    /// The smoothed time between ticks minus the sleep.
+    /// </summary>
+    public readonly float WorkMicroseconds;
+
+    public readonly BlittableBoolean Critical;
+}
\ No newline at end of file
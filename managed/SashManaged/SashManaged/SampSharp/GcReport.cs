@@ -0,0 +1,21 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Cumulative counters of the runtime, written by the GC handler after every request.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct GcReport
+{
+    public ulong PauseMicroseconds;
+    public ulong AllocatedBytes;
+    public uint Gen0Collections;
+    public uint Gen1Collections;
+    public uint Gen2Collections;
+
+    /// <summary>
+    /// Whether a no-GC region was entered.
+    /// </summary>
+    public BlittableBoolean Succeeded;
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct GcRequest
+{
+    public readonly GcCommand Command;
+    public readonly int Generation;
+
+    /// <summary>
+    /// The estimated time left in the tick budget.
+    /// </summary>
+    public readonly uint SlackMicroseconds;
+
+    /// <summary>
+    /// Whether a full collection must block; otherwise it may run as a background collection.
+    /// </summary>
+    public readonly BlittableBoolean Blocking;
+
+    public readonly ulong NoGcRegionSize;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+﻿using System.Numerics;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Records the position history of every player and validates player-on-player shots against the hitbox of the
+/// target at the time the shooter saw it. The verdict of a shot is available through <see cref="GetLastVerdict" />
+/// while its event is dispatched.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct HitValidator
+{
+    public partial void SetConfig(ref HitValidatorConfig config);
+
+    public partial void GetConfig(ref HitValidatorConfig config);
+
+    public partial bool Rewind(IPlayer player, uint milliseconds, ref Vector3 position, ref GTAQuat rotation);
+
+    public partial bool Validate(IPlayer shooter, IPlayer target, ref PlayerBulletData bullet, ref HitVerdict verdict);
+
+    public partial bool GetLastVerdict(IPlayer shooter, ref HitVerdict verdict);
+
+    public partial void ClearHistory(IPlayer player);
+
+    public partial ulong GetRejectedCount();
+}
@@ -0,0 +1,29 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public struct HitValidatorConfig
+{
+    public BlittableBoolean Enabled;
+
+    /// <summary>
+    /// Drop shots with an invalid verdict before they reach managed event handlers.
+    /// </summary>
+    public BlittableBoolean Reject;
+
+    public float HitboxRadius;
+    public float HitboxHalfHeight;
+
+    /// <summary>
+    /// The additional distance allowed between the hit position and the rewound hitbox.
+    /// </summary>
+    public float Tolerance;
+
+    /// <summary>
+    /// The maximum distance between the bullet origin and the shooter, or 0 to disable the check.
+    /// </summary>
+    public float OriginTolerance;
+
+    public uint MaxRewindMilliseconds;
+}
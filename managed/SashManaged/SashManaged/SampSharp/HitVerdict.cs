@@ -0,0 +1,19 @@
+﻿using System.Numerics;
+using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct HitVerdict
+{
+    public readonly HitVerdictResult Result;
+    public readonly int TargetId;
+
+    /// <summary>
+    /// The distance between the hit position and the rewound hitbox of the target.
+    /// </summary>
+    public readonly float Distance;
+
+    public readonly uint RewindMilliseconds;
+    public readonly Vector3 RewoundPosition;
+}
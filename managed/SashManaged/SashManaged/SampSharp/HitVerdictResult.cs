@@ -0,0 +1,9 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum HitVerdictResult : byte
+{
+    Valid,
+    NoHistory,
+    OutOfHitbox,
+    OriginMismatch
+}
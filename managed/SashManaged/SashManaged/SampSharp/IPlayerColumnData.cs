@@ -0,0 +1,13 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+[OpenMpApi2(typeof(IExtension))]
+public readonly partial struct IPlayerColumnData
+{
+    public static UID ExtensionId => new(0x5A3F0B9C7E21D463);
+
+    public partial int GetRow();
+
+    public partial nint GetField(int column);
+}
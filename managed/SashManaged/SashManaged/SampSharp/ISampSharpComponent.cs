@@ -0,0 +1,63 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+[OpenMpApi2(typeof(IComponent))]
+public readonly partial struct ISampSharpComponent
+{
+    public static UID ComponentId => new(0x0B61929D1E94A319);
+
+    public partial TickQueue GetTickQueue();
+
+    public partial EntityTable GetEntityTable(EntityTableType type);
+
+    public partial PlayerColumnStore GetPlayerColumnStore();
+
+    public partial SyncValidator GetSyncValidator();
+
+    public partial HitValidator GetHitValidator();
+
+    public partial BridgeRecorder GetBridgeRecorder();
+
+    public partial BridgeReplayer GetBridgeReplayer();
+
+    public partial CommandRouter GetCommandRouter();
+
+    public partial TextDrawStyler GetTextDrawStyler();
+
+    public partial TextDedupeCache GetTextDedupeCache();
+
+    public partial WorldLoader GetWorldLoader();
+
+    public partial PlayerFanOut GetPlayerFanOut();
+
+    public partial AsyncLogger GetAsyncLogger();
+
+    /// <summary>
+    /// Returns the database executor, whose <see cref="DatabaseExecutor.Handle" /> is 0 if the component was built
+    /// without <c>SAMPSHARP_DATABASE</c>.
+    /// </summary>
+    public partial DatabaseExecutor GetDatabaseExecutor();
+
+    public partial TickArena GetTickArena();
+
+    public partial PlayerStringTable GetPlayerStringTable();
+
+    public partial BitStreamCodec GetBitStreamCodec();
+
+    public partial ChangeFeed GetChangeFeed();
+
+    public partial StreamMatrix GetStreamMatrix();
+
+    public partial TickPacer GetTickPacer();
+
+    public partial GcCoordinator GetGcCoordinator();
+
+    public partial WorldSnapshot GetWorldSnapshot();
+
+    public partial ObjectAnimator GetObjectAnimator();
+
+    public partial RateLimiter GetRateLimiter();
+
+    public partial BanIndex GetBanIndex();
+}
@@ -0,0 +1,56 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Moves objects along paths of waypoints natively: the next move is issued when the previous one completes, so no
+/// managed code runs per segment. Splines and easing are approximated by subdividing every segment into several moves.
+/// The <c>OnMoved</c> handlers are still called for every move and can skip animated objects with
+/// <see cref="IsAnimating" />.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct ObjectAnimator
+{
+    public partial void SetCompletedHandler(nint handler);
+
+    public partial bool Animate(IObject objekt, nint waypoints, Size count, ref ObjectPathOptions options);
+
+    /// <summary>
+    /// Stops the animation and the movement of the object.
+    /// </summary>
+    public partial void Stop(IObject objekt);
+
+    public partial bool IsAnimating(IObject objekt);
+
+    public partial void GetStats(ref ObjectAnimatorStats stats);
+
+    public ObjectAnimatorStats GetStats()
+    {
+        var stats = default(ObjectAnimatorStats);
+        GetStats(ref stats);
+        return stats;
+    }
+
+    /// <summary>
+    /// Sets the handler which is called when an object reached the end of a path which is followed once.
+    /// </summary>
+    public unsafe void SetCompletedHandler(delegate* unmanaged<IObject, void> handler)
+    {
+        SetCompletedHandler((nint)handler);
+    }
+
+    /// <summary>
+    /// Starts moving the object along the path. On an open path the object first moves to the first waypoint at its
+    /// speed, or is placed there if the speed is 0. In <see cref="ObjectPathMode.Loop" /> the first waypoint ends the
+    /// closing segment, so every waypoint including the first requires a positive speed. Returns
+    /// <see langword="false" /> if the path has less than two waypoints or a waypoint at the end of a segment has no
+    /// speed.
+    /// </summary>
+    public unsafe bool Animate(IObject objekt, ReadOnlySpan<ObjectPathWaypoint> waypoints, ObjectPathOptions options)
+    {
+        fixed (ObjectPathWaypoint* pointer = waypoints)
+        {
+            return Animate(objekt, (nint)pointer, waypoints.Length, ref options);
+        }
+    }
+}
\ No newline at end of file
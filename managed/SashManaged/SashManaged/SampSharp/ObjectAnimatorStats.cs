@@ -0,0 +1,19 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct ObjectAnimatorStats
+{
+    /// <summary>
+    /// The number of moves issued to animated objects.
+    /// </summary>
+    public readonly ulong Moves;
+
+    /// <summary>
+    /// The number of paths which were followed to the end.
+    /// </summary>
+    public readonly ulong Completed;
+
+    public readonly uint Active;
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum ObjectPathEasing : byte
+{
+    None,
+
+    /// <summary>
+    /// Every segment starts slow.
+    /// </summary>
+    In,
+
+    /// <summary>
+    /// Every segment ends slow.
+    /// </summary>
+    Out,
+
+    InOut
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum ObjectPathInterpolation : byte
+{
+    /// <summary>
+    /// Straight segments between the waypoints.
+    /// </summary>
+    Linear,
+
+    /// <summary>
+    /// A Catmull-Rom spline through the waypoints.
+    /// </summary>
+    CatmullRom
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum ObjectPathMode : byte
+{
+    /// <summary>
+    /// The path is followed once.
+    /// </summary>
+    Once,
+
+    /// <summary>
+    /// The path is closed with a segment from the last to the first waypoint and repeated.
+    /// </summary>
+    Loop,
+
+    /// <summary>
+    /// The path is followed forwards and backwards.
+    /// </summary>
+    PingPong
+}
\ No newline at end of file
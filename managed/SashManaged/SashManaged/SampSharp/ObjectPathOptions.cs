@@ -0,0 +1,21 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public struct ObjectPathOptions
+{
+    public ObjectPathInterpolation Interpolation;
+    public ObjectPathMode Mode;
+    public ObjectPathEasing Easing;
+
+    /// <summary>
+    /// Whether the rotation of the waypoints is applied; otherwise the rotation of the object is not changed.
+    /// </summary>
+    public BlittableBoolean Rotate;
+
+    /// <summary>
+    /// The number of moves per segment of a spline or eased path.
+    /// </summary>
+    public uint Subdivisions;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+﻿using System.Numerics;
+using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct ObjectPathWaypoint(Vector3 position, Vector3 rotation, float speed)
+{
+    public readonly Vector3 Position = position;
+    public readonly Vector3 Rotation = rotation;
+
+    /// <summary>
+    /// The speed of the segment which ends at this waypoint. The first waypoint ends the closing segment of a
+    /// <see cref="ObjectPathMode.Loop" />, so its speed is only optional on an open path.
+    /// </summary>
+    public readonly float Speed = speed;
+}
\ No newline at end of file
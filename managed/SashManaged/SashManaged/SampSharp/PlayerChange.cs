@@ -0,0 +1,21 @@
+﻿namespace SashManaged.SampSharp;
+
+[Flags]
+public enum PlayerChange : uint
+{
+    None = 0,
+    Connected = 1 << 0,
+    Disconnected = 1 << 1,
+    Spawned = 1 << 2,
+    Died = 1 << 3,
+    Position = 1 << 4,
+    Health = 1 << 5,
+    Armour = 1 << 6,
+    Weapon = 1 << 7,
+    State = 1 << 8,
+    Keys = 1 << 9,
+    Interior = 1 << 10,
+    Score = 1 << 11,
+    Name = 1 << 12,
+    Vehicle = 1 << 13
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Typed view of a column in the <see cref="PlayerColumnStore" />.
+/// </summary>
+public readonly unsafe struct PlayerColumn<T> where T : unmanaged
+{
+    private readonly T* _data;
+    private readonly int _length;
+
+    public PlayerColumn(T* data, int length)
+    {
+        _data = data;
+        _length = length;
+    }
+
+    public ref T this[int playerId] => ref AsSpan()[playerId];
+
+    public Span<T> AsSpan()
+    {
+        return new Span<T>(_data, _length);
+    }
+}
@@ -0,0 +1,32 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Native structure-of-arrays storage for per-player data. Every column is a contiguous, 64-byte aligned array with
+/// one element per player ID. Column memory never moves and rows are zeroed when a player disconnects.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct PlayerColumnStore
+{
+    public partial int AddColumn(Size elementSize);
+
+    public partial nint GetColumn(int column);
+
+    public partial Size GetElementSize(int column);
+
+    public partial Size GetColumnCount();
+
+    public partial Size GetRowCount();
+
+    public partial void ClearRow(int row);
+
+    /// <summary>
+    /// Adds a column with an element of type <typeparamref name="T" /> for every player.
+    /// </summary>
+    public unsafe PlayerColumn<T> AddColumn<T>() where T : unmanaged
+    {
+        var column = AddColumn(new Size(sizeof(T)));
+        return new PlayerColumn<T>((T*)GetColumn(column), (int)GetRowCount().Value);
+    }
+}
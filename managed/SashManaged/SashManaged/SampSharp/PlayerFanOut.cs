@@ -0,0 +1,165 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Applies a show or hide operation of a global textdraw, gang zone or menu to many players in a single native call.
+/// Players are passed either as a span of players or as a bitset of player IDs, where bit <c>n</c> of word <c>w</c> is
+/// player ID <c>w * 64 + n</c>; unused IDs in a bitset are skipped. All operations return the number of players to
+/// which they were applied.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct PlayerFanOut
+{
+    public partial Size ShowTextDraw(ITextDraw textDraw, nint players, Size count);
+    public partial Size ShowTextDrawForIds(ITextDraw textDraw, nint ids, Size words);
+
+    public partial Size HideTextDraw(ITextDraw textDraw, nint players, Size count);
+    public partial Size HideTextDrawForIds(ITextDraw textDraw, nint ids, Size words);
+
+    public partial Size ShowGangZone(IBaseGangZone gangZone, nint players, Size count, ref Colour colour);
+    public partial Size ShowGangZoneForIds(IBaseGangZone gangZone, nint ids, Size words, ref Colour colour);
+
+    public partial Size HideGangZone(IBaseGangZone gangZone, nint players, Size count);
+    public partial Size HideGangZoneForIds(IBaseGangZone gangZone, nint ids, Size words);
+
+    public partial Size FlashGangZone(IBaseGangZone gangZone, nint players, Size count, ref Colour colour);
+    public partial Size FlashGangZoneForIds(IBaseGangZone gangZone, nint ids, Size words, ref Colour colour);
+
+    public partial Size StopFlashGangZone(IBaseGangZone gangZone, nint players, Size count);
+    public partial Size StopFlashGangZoneForIds(IBaseGangZone gangZone, nint ids, Size words);
+
+    public partial Size ShowMenu(IMenu menu, nint players, Size count);
+    public partial Size ShowMenuForIds(IMenu menu, nint ids, Size words);
+
+    public partial Size HideMenu(IMenu menu, nint players, Size count);
+    public partial Size HideMenuForIds(IMenu menu, nint ids, Size words);
+
+    public unsafe int ShowTextDraw(ITextDraw textDraw, ReadOnlySpan<IPlayer> players)
+    {
+        fixed (IPlayer* pointer = players)
+        {
+            return (int)ShowTextDraw(textDraw, (nint)pointer, players.Length).Value;
+        }
+    }
+
+    public unsafe int ShowTextDraw(ITextDraw textDraw, ReadOnlySpan<ulong> ids)
+    {
+        fixed (ulong* pointer = ids)
+        {
+            return (int)ShowTextDrawForIds(textDraw, (nint)pointer, ids.Length).Value;
+        }
+    }
+
+    public unsafe int HideTextDraw(ITextDraw textDraw, ReadOnlySpan<IPlayer> players)
+    {
+        fixed (IPlayer* pointer = players)
+        {
+            return (int)HideTextDraw(textDraw, (nint)pointer, players.Length).Value;
+        }
+    }
+
+    public unsafe int HideTextDraw(ITextDraw textDraw, ReadOnlySpan<ulong> ids)
+    {
+        fixed (ulong* pointer = ids)
+        {
+            return (int)HideTextDrawForIds(textDraw, (nint)pointer, ids.Length).Value;
+        }
+    }
+
+    public unsafe int ShowGangZone(IBaseGangZone gangZone, ReadOnlySpan<IPlayer> players, Colour colour)
+    {
+        fixed (IPlayer* pointer = players)
+        {
+            return (int)ShowGangZone(gangZone, (nint)pointer, players.Length, ref colour).Value;
+        }
+    }
+
+    public unsafe int ShowGangZone(IBaseGangZone gangZone, ReadOnlySpan<ulong> ids, Colour colour)
+    {
+        fixed (ulong* pointer = ids)
+        {
+            return (int)ShowGangZoneForIds(gangZone, (nint)pointer, ids.Length, ref colour).Value;
+        }
+    }
+
+    public unsafe int HideGangZone(IBaseGangZone gangZone, ReadOnlySpan<IPlayer> players)
+    {
+        fixed (IPlayer* pointer = players)
+        {
+            return (int)HideGangZone(gangZone, (nint)pointer, players.Length).Value;
+        }
+    }
+
+    public unsafe int HideGangZone(IBaseGangZone gangZone, ReadOnlySpan<ulong> ids)
+    {
+        fixed (ulong* pointer = ids)
+        {
+            return (int)HideGangZoneForIds(gangZone, (nint)pointer, ids.Length).Value;
+        }
+    }
+
+    public unsafe int FlashGangZone(IBaseGangZone gangZone, ReadOnlySpan<IPlayer> players, Colour colour)
+    {
+        fixed (IPlayer* pointer = players)
+        {
+            return (int)FlashGangZone(gangZone, (nint)pointer, players.Length, ref colour).Value;
+        }
+    }
+
+    public unsafe int FlashGangZone(IBaseGangZone gangZone, ReadOnlySpan<ulong> ids, Colour colour)
+    {
+        fixed (ulong* pointer = ids)
+        {
+            return (int)FlashGangZoneForIds(gangZone, (nint)pointer, ids.Length, ref colour).Value;
+        }
+    }
+
+    public unsafe int StopFlashGangZone(IBaseGangZone gangZone, ReadOnlySpan<IPlayer> players)
+    {
+        fixed (IPlayer* pointer = players)
+        {
+            return (int)StopFlashGangZone(gangZone, (nint)pointer, players.Length).Value;
+        }
+    }
+
+    public unsafe int StopFlashGangZone(IBaseGangZone gangZone, ReadOnlySpan<ulong> ids)
+    {
+        fixed (ulong* pointer = ids)
+        {
+            return (int)StopFlashGangZoneForIds(gangZone, (nint)pointer, ids.Length).Value;
+        }
+    }
+
+    public unsafe int ShowMenu(IMenu menu, ReadOnlySpan<IPlayer> players)
+    {
+        fixed (IPlayer* pointer = players)
+        {
+            return (int)ShowMenu(menu, (nint)pointer, players.Length).Value;
+        }
+    }
+
+    public unsafe int ShowMenu(IMenu menu, ReadOnlySpan<ulong> ids)
+    {
+        fixed (ulong* pointer = ids)
+        {
+            return (int)ShowMenuForIds(menu, (nint)pointer, ids.Length).Value;
+        }
+    }
+
+    public unsafe int HideMenu(IMenu menu, ReadOnlySpan<IPlayer> players)
+    {
+        fixed (IPlayer* pointer = players)
+        {
+            return (int)HideMenu(menu, (nint)pointer, players.Length).Value;
+        }
+    }
+
+    public unsafe int HideMenu(IMenu menu, ReadOnlySpan<ulong> ids)
+    {
+        fixed (ulong* pointer = ids)
+        {
+            return (int)HideMenuForIds(menu, (nint)pointer, ids.Length).Value;
+        }
+    }
+}
\ No newline at end of file
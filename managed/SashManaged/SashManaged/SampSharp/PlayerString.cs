@@ -0,0 +1,45 @@
+﻿using System.Runtime.InteropServices;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// String of a player in UTF-8 and UTF-16, interned by the <see cref="PlayerStringTable" />. Both forms are null
+/// terminated and point into native memory which never moves.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly unsafe struct PlayerString
+{
+    public readonly byte* Utf8;
+    public readonly char* Utf16;
+    public readonly uint Utf8Length;
+    public readonly uint Utf16Length;
+
+    /// <summary>
+    /// Incremented every time the string changes, including when the strings of a disconnected player are cleared
+    /// after the disconnect handlers ran.
+    /// </summary>
+    public readonly uint Version;
+
+    private readonly uint _reserved;
+
+    public ReadOnlySpan<char> AsSpan()
+    {
+        return new ReadOnlySpan<char>(Utf16, (int)Utf16Length);
+    }
+
+    public ReadOnlySpan<byte> AsUtf8Span()
+    {
+        return new ReadOnlySpan<byte>(Utf8, (int)Utf8Length);
+    }
+
+    public StringView AsStringView()
+    {
+        return new StringView(Utf8, (int)Utf8Length);
+    }
+
+    public override string ToString()
+    {
+        return new string(AsSpan());
+    }
+}
\ No newline at end of file
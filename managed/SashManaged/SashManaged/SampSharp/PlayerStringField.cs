@@ -0,0 +1,9 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum PlayerStringField : byte
+{
+    Name,
+    Serial,
+    Ip,
+    ClientVersion
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Native table of the name, serial, IP address and client version of the connected players. The strings are copied
+/// and transcoded once when a player connects or changes their name, so reading them does not call into the player or
+/// decode them again, and after the first read does not call into the component either. The entries of disconnected
+/// players are empty; they are cleared after every disconnect handler, so the strings of a disconnecting player can
+/// still be read in <c>OnPlayerDisconnect</c>.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct PlayerStringTable
+{
+    public partial nint GetEntries(PlayerStringField field);
+
+    public partial Size GetEntryCount();
+
+    public partial nint Get(int player, PlayerStringField field);
+
+    /// <summary>
+    /// Returns the entries of the field indexed by player ID. The span stays valid for the lifetime of the component.
+    /// The entries never move, so they are fetched from the component once and later calls make no native call.
+    /// </summary>
+    public unsafe ReadOnlySpan<PlayerString> GetStrings(PlayerStringField field)
+    {
+        var entries = _entries;
+        if (entries == null || entries.Table != Handle)
+        {
+            var fields = new nint[FieldCount];
+            for (var i = 0; i < FieldCount; i++)
+            {
+                fields[i] = GetEntries((PlayerStringField)i);
+            }
+
+            entries = new Entries(Handle, fields, (int)GetEntryCount().Value);
+            _entries = entries;
+        }
+
+        return new ReadOnlySpan<PlayerString>((void*)entries.Fields[(int)field], entries.Count);
+    }
+
+    public ReadOnlySpan<char> GetName(int playerId)
+    {
+        return GetStrings(PlayerStringField.Name)[playerId].AsSpan();
+    }
+
+    public ReadOnlySpan<char> GetSerial(int playerId)
+    {
+        return GetStrings(PlayerStringField.Serial)[playerId].AsSpan();
+    }
+
+    public ReadOnlySpan<char> GetIp(int playerId)
+    {
+        return GetStrings(PlayerStringField.Ip)[playerId].AsSpan();
+    }
+
+    public ReadOnlySpan<char> GetClientVersion(int playerId)
+    {
+        return GetStrings(PlayerStringField.ClientVersion)[playerId].AsSpan();
+    }
+
+    private const int FieldCount = (int)PlayerStringField.ClientVersion + 1;
+
+    /// <summary>
+    /// The entries of every field of a table, replaced as a whole so concurrent readers never see a partial set.
+    /// </summary>
+    private sealed class Entries(nint table, nint[] fields, int count)
+    {
+        public readonly nint Table = table;
+        public readonly nint[] Fields = fields;
+        public readonly int Count = count;
+    }
+
+    private static Entries? _entries;
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public struct RateLimitConfig
+{
+    /// <summary>
+    /// The number of events per second which refill the bucket of a player. 0 disables the bucket.
+    /// </summary>
+    public float Rate;
+
+    /// <summary>
+    /// The capacity of the bucket of a player.
+    /// </summary>
+    public float Burst;
+
+    /// <summary>
+    /// The number of events per second which refill the bucket of an address, which is shared by the players connected
+    /// from it. 0 disables the bucket.
+    /// </summary>
+    public float IpRate;
+
+    public float IpBurst;
+
+    /// <summary>
+    /// The minimum time between two escalations of the event for a player.
+    /// </summary>
+    public uint WindowMilliseconds;
+
+    /// <summary>
+    /// Whether the escalation handler is called for the event.
+    /// </summary>
+    public BlittableBoolean Escalate;
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum RateLimitedEvent : byte
+{
+    Text,
+    CommandText,
+    DialogResponse,
+    ClickTextDraw,
+    ClickMap,
+
+    /// <summary>
+    /// Connections from an address. Only the bucket of the address is used; connections over the limit are kicked.
+    /// </summary>
+    IncomingConnection
+}
\ No newline at end of file
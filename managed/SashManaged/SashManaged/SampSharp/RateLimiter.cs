@@ -0,0 +1,55 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Token buckets for inbound player events which are cheap to send and expensive to handle in managed code. Every
+/// player and, optionally, every address has a bucket per event; events over the limit are dropped natively before
+/// they reach the managed handlers. Dropped text and commands do not reach native handlers either. Players are sent
+/// the reply at most once per window, and connections over the limit of their address are kicked.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct RateLimiter
+{
+    public partial void SetEnabled(bool enabled);
+
+    public partial bool IsEnabled();
+
+    public partial void SetConfig(RateLimitedEvent eventType, ref RateLimitConfig config);
+
+    public partial void GetConfig(RateLimitedEvent eventType, ref RateLimitConfig config);
+
+    /// <summary>
+    /// Sets the message sent to players once per window when their events are dropped. An empty message drops events
+    /// silently.
+    /// </summary>
+    public partial void SetReply(string message, Colour colour);
+
+    public partial void SetHandler(nint handler);
+
+    public partial void GetStats(ref RateLimiterStats stats);
+
+    public RateLimitConfig GetConfig(RateLimitedEvent eventType)
+    {
+        var config = default(RateLimitConfig);
+        GetConfig(eventType, ref config);
+        return config;
+    }
+
+    public RateLimiterStats GetStats()
+    {
+        var stats = default(RateLimiterStats);
+        GetStats(ref stats);
+        return stats;
+    }
+
+    /// <summary>
+    /// Sets the handler which is called for a player whose events are dropped, at most once per window of the event
+    /// and only for events with <see cref="RateLimitConfig.Escalate" />. The last argument is the number of events
+    /// dropped since the previous call.
+    /// </summary>
+    public unsafe void SetHandler(delegate* unmanaged<IPlayer, RateLimitedEvent, uint, void> handler)
+    {
+        SetHandler((nint)handler);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct RateLimiterStats
+{
+    /// <summary>
+    /// The number of events which were passed on.
+    /// </summary>
+    public readonly ulong Passed;
+
+    /// <summary>
+    /// The number of events which were dropped by the bucket of a player.
+    /// </summary>
+    public readonly ulong Limited;
+
+    /// <summary>
+    /// The number of events which were dropped by the bucket of an address.
+    /// </summary>
+    public readonly ulong IpLimited;
+
+    /// <summary>
+    /// The number of calls of the escalation handler.
+    /// </summary>
+    public readonly ulong Escalated;
+
+    /// <summary>
+    /// The number of default replies sent to players.
+    /// </summary>
+    public readonly ulong Replied;
+
+    /// <summary>
+    /// The number of connections kicked by the bucket of their address.
+    /// </summary>
+    public readonly ulong Kicked;
+
+    /// <summary>
+    /// The number of addresses with buckets.
+    /// </summary>
+    public readonly uint Addresses;
+}
\ No newline at end of file
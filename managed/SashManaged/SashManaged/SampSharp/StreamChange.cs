@@ -0,0 +1,14 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Entity streamed in or out for a player.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct StreamChange
+{
+    public readonly int Player;
+    public readonly int Entity;
+    public readonly BlittableBoolean StreamedIn;
+}
\ No newline at end of file
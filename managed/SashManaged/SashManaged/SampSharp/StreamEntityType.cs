@@ -0,0 +1,8 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum StreamEntityType : byte
+{
+    Player,
+    Vehicle,
+    Actor
+}
\ No newline at end of file
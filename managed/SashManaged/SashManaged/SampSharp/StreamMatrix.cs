@@ -0,0 +1,54 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Native bitsets of the players, vehicles and actors streamed in for every player, maintained from the stream events.
+/// Every entity type has a matrix with one row of words per player in which bit N is set if the entity with ID N is
+/// streamed in for the player. The matrices live in native memory which never moves. Stream events are also collected
+/// into a list of changes per entity type which is published at the start of every tick of the SampSharp component.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct StreamMatrix
+{
+    public partial nint GetBits(StreamEntityType type);
+
+    public partial Size GetRowWords(StreamEntityType type);
+
+    public partial nint GetRow(StreamEntityType type, int player);
+
+    public partial bool IsStreamedIn(StreamEntityType type, int player, int entity);
+
+    public partial Size GetViewers(StreamEntityType type, int entity, nint output, Size words);
+
+    public partial nint GetChanges(StreamEntityType type);
+
+    public partial Size GetChangeCount(StreamEntityType type);
+
+    /// <summary>
+    /// Returns the bitset of the entities of the type streamed in for the player.
+    /// </summary>
+    public unsafe ReadOnlySpan<ulong> GetRowSpan(StreamEntityType type, int playerId)
+    {
+        var row = GetRow(type, playerId);
+        return row == 0 ? ReadOnlySpan<ulong>.Empty : new ReadOnlySpan<ulong>((void*)row, (int)GetRowWords(type).Value);
+    }
+
+    /// <summary>
+    /// Writes the bitset of the players for which the entity is streamed in and returns the number of players. The
+    /// bitset can be passed to the ID variants of <see cref="PlayerFanOut" />.
+    /// </summary>
+    public unsafe int GetViewers(StreamEntityType type, int entity, Span<ulong> output)
+    {
+        fixed (ulong* pointer = output)
+        {
+            return (int)GetViewers(type, entity, (nint)pointer, output.Length).Value;
+        }
+    }
+
+    /// <summary>
+    /// Returns the changes of the entity type published at the start of the current tick in the order of the events.
+    /// </summary>
+    public unsafe ReadOnlySpan<StreamChange> GetChangeSpan(StreamEntityType type)
+    {
+        return new ReadOnlySpan<StreamChange>((void*)GetChanges(type), (int)GetChangeCount(type).Value);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+﻿namespace SashManaged.SampSharp;
+
+[Flags]
+public enum SyncRule : uint
+{
+    None = 0,
+    VehicleSpeed = 1 << 0,
+    Teleport = 1 << 1,
+    Weapon = 1 << 2,
+    Ammo = 1 << 3,
+    Health = 1 << 4,
+    Armour = 1 << 5
+}
@@ -0,0 +1,43 @@
+﻿using System.Numerics;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Native validation of player and driver sync. Only violations are passed to the violation handler. Health, armour,
+/// ammo and position changes caused by the game mode must be applied through the validator so they are not reported.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct SyncValidator
+{
+    public partial void SetConfig(ref SyncValidatorConfig config);
+
+    public partial void GetConfig(ref SyncValidatorConfig config);
+
+    public partial void SetMaxVehicleSpeed(int model, float speed);
+
+    public partial float GetMaxVehicleSpeed(int model);
+
+    public partial void SetViolationHandler(nint handler);
+
+    public partial void SetHealth(IPlayer player, float health);
+
+    public partial void SetArmour(IPlayer player, float armour);
+
+    public partial void SetPosition(IPlayer player, Vector3 position);
+
+    public partial void GiveWeapon(IPlayer player, WeaponSlotData weapon);
+
+    public partial void SetWeaponAmmo(IPlayer player, WeaponSlotData weapon);
+
+    public partial void ResetPlayer(IPlayer player);
+
+    public partial ulong GetViolationCount();
+
+    public partial ulong GetRejectedCount();
+
+    public unsafe void SetViolationHandler(delegate* unmanaged<IPlayer, SyncViolation*, void> handler)
+    {
+        SetViolationHandler((nint)handler);
+    }
+}
@@ -0,0 +1,30 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public struct SyncValidatorConfig
+{
+    /// <summary>
+    /// The rules which are checked on every player update.
+    /// </summary>
+    public SyncRule EnabledRules;
+
+    /// <summary>
+    /// The rules of which a violation causes the player update to be dropped.
+    /// </summary>
+    public SyncRule RejectRules;
+
+    /// <summary>
+    /// The maximum distance a player may move between two updates which are at most
+    /// <see cref="TeleportIntervalMilliseconds" /> apart.
+    /// </summary>
+    public float TeleportDistance;
+
+    public uint TeleportIntervalMilliseconds;
+
+    /// <summary>
+    /// The amount of health or armour a client may gain without a server-side cause.
+    /// </summary>
+    public float HealthTolerance;
+}
@@ -0,0 +1,14 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct SyncViolation
+{
+    public readonly int PlayerId;
+    public readonly SyncRule Rule;
+    public readonly int VehicleModel;
+    public readonly int Weapon;
+    public readonly float Observed;
+    public readonly float Limit;
+}
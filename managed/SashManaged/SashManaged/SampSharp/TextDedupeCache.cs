@@ -0,0 +1,25 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Suppresses <c>ITextDraw.SetTextForPlayer</c> and <c>ITextLabelBase.SetText</c> calls which would not change the text
+/// shown to a player. The cache is disabled by default and can be enabled from startup with the
+/// <c>sampsharp.text_dedupe</c> configuration option.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct TextDedupeCache
+{
+    public partial void SetEnabled(bool enabled);
+
+    public partial bool IsEnabled();
+
+    public partial void GetStats(ref TextDedupeStats stats);
+
+    public partial void ResetStats();
+
+    public TextDedupeStats GetStats()
+    {
+        var stats = default(TextDedupeStats);
+        GetStats(ref stats);
+        return stats;
+    }
+}
\ No newline at end of file
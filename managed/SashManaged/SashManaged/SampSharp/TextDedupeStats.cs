@@ -0,0 +1,12 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct TextDedupeStats
+{
+    public readonly ulong TextDrawsSent;
+    public readonly ulong TextDrawsSuppressed;
+    public readonly ulong LabelsSent;
+    public readonly ulong LabelsSuppressed;
+}
\ No newline at end of file
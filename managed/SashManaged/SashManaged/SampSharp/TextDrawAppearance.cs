@@ -0,0 +1,152 @@
+﻿using System.Numerics;
+using System.Runtime.InteropServices;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Packed appearance of a textdraw. Setting a property adds its field to <see cref="Fields" />; only those fields are
+/// applied by the <see cref="TextDrawStyler" />.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct TextDrawAppearance
+{
+    private TextDrawField _fields;
+    private Vector2 _position;
+    private Vector2 _letterSize;
+    private Vector2 _textSize;
+    private Colour _letterColour;
+    private Colour _boxColour;
+    private Colour _backgroundColour;
+    private Vector3 _previewRotation;
+    private float _previewZoom;
+    private TextDrawAlignmentTypes _alignment;
+    private int _shadow;
+    private int _outline;
+    private TextDrawStyle _style;
+    private int _previewModel;
+    private int _previewVehicleColour1;
+    private int _previewVehicleColour2;
+    private BlittableBoolean _box;
+    private BlittableBoolean _proportional;
+    private BlittableBoolean _selectable;
+
+    public TextDrawField Fields
+    {
+        readonly get => _fields;
+        set => _fields = value;
+    }
+
+    public Vector2 Position
+    {
+        readonly get => _position;
+        set => Set(ref _position, value, TextDrawField.Position);
+    }
+
+    public Vector2 LetterSize
+    {
+        readonly get => _letterSize;
+        set => Set(ref _letterSize, value, TextDrawField.LetterSize);
+    }
+
+    public Vector2 TextSize
+    {
+        readonly get => _textSize;
+        set => Set(ref _textSize, value, TextDrawField.TextSize);
+    }
+
+    public TextDrawAlignmentTypes Alignment
+    {
+        readonly get => _alignment;
+        set => Set(ref _alignment, value, TextDrawField.Alignment);
+    }
+
+    public Colour LetterColour
+    {
+        readonly get => _letterColour;
+        set => Set(ref _letterColour, value, TextDrawField.LetterColour);
+    }
+
+    public bool Box
+    {
+        readonly get => _box;
+        set => Set(ref _box, (BlittableBoolean)value, TextDrawField.Box);
+    }
+
+    public Colour BoxColour
+    {
+        readonly get => _boxColour;
+        set => Set(ref _boxColour, value, TextDrawField.BoxColour);
+    }
+
+    public int Shadow
+    {
+        readonly get => _shadow;
+        set => Set(ref _shadow, value, TextDrawField.Shadow);
+    }
+
+    public int Outline
+    {
+        readonly get => _outline;
+        set => Set(ref _outline, value, TextDrawField.Outline);
+    }
+
+    public Colour BackgroundColour
+    {
+        readonly get => _backgroundColour;
+        set => Set(ref _backgroundColour, value, TextDrawField.BackgroundColour);
+    }
+
+    public TextDrawStyle Style
+    {
+        readonly get => _style;
+        set => Set(ref _style, value, TextDrawField.Style);
+    }
+
+    public bool Proportional
+    {
+        readonly get => _proportional;
+        set => Set(ref _proportional, (BlittableBoolean)value, TextDrawField.Proportional);
+    }
+
+    public bool Selectable
+    {
+        readonly get => _selectable;
+        set => Set(ref _selectable, (BlittableBoolean)value, TextDrawField.Selectable);
+    }
+
+    public int PreviewModel
+    {
+        readonly get => _previewModel;
+        set => Set(ref _previewModel, value, TextDrawField.PreviewModel);
+    }
+
+    public Vector3 PreviewRotation
+    {
+        readonly get => _previewRotation;
+        set => Set(ref _previewRotation, value, TextDrawField.PreviewRotation);
+    }
+
+    public (int Colour1, int Colour2) PreviewVehicleColour
+    {
+        readonly get => (_previewVehicleColour1, _previewVehicleColour2);
+        set
+        {
+            _previewVehicleColour1 = value.Colour1;
+            _previewVehicleColour2 = value.Colour2;
+            _fields |= TextDrawField.PreviewVehicleColour;
+        }
+    }
+
+    public float PreviewZoom
+    {
+        readonly get => _previewZoom;
+        set => Set(ref _previewZoom, value, TextDrawField.PreviewZoom);
+    }
+
+    private void Set<T>(ref T field, T value, TextDrawField flag)
+    {
+        field = value;
+        _fields |= flag;
+    }
+}
\ No newline at end of file
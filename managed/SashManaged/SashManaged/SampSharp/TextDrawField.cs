@@ -0,0 +1,24 @@
+﻿namespace SashManaged.SampSharp;
+
+[Flags]
+public enum TextDrawField : uint
+{
+    None = 0,
+    Position = 1 << 0,
+    LetterSize = 1 << 1,
+    TextSize = 1 << 2,
+    Alignment = 1 << 3,
+    LetterColour = 1 << 4,
+    Box = 1 << 5,
+    BoxColour = 1 << 6,
+    Shadow = 1 << 7,
+    Outline = 1 << 8,
+    BackgroundColour = 1 << 9,
+    Style = 1 << 10,
+    Proportional = 1 << 11,
+    Selectable = 1 << 12,
+    PreviewModel = 1 << 13,
+    PreviewRotation = 1 << 14,
+    PreviewVehicleColour = 1 << 15,
+    PreviewZoom = 1 << 16
+}
\ No newline at end of file
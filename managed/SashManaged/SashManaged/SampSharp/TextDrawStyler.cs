@@ -0,0 +1,30 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Applies packed textdraw appearances in a single call. A textdraw is restreamed once, and only if an applied field
+/// differs from its current value.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct TextDrawStyler
+{
+    public partial bool Apply(ITextDrawBase textDraw, ref TextDrawAppearance appearance);
+
+    public partial Size ApplyBatch(nint textDraws, Size count, ref TextDrawAppearance appearance);
+
+    public partial ulong GetAppliedCount();
+
+    public partial ulong GetRestreamedCount();
+
+    /// <summary>
+    /// Applies the appearance to each of the textdraws and returns the number of restreamed textdraws.
+    /// </summary>
+    public unsafe int ApplyBatch(ReadOnlySpan<ITextDrawBase> textDraws, ref TextDrawAppearance appearance)
+    {
+        fixed (ITextDrawBase* pointer = textDraws)
+        {
+            return (int)ApplyBatch((nint)pointer, textDraws.Length, ref appearance).Value;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+﻿using System.Text;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Native bump allocator for short-lived copies of managed data. Memory allocated from the arena is valid until the end
+/// of the current server tick, so text can be encoded directly into native memory instead of into a pinned managed
+/// buffer per call. The arena must only be used from the server thread.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct TickArena
+{
+    public partial nint Allocate(Size size);
+
+    public partial bool Commit(Size used);
+
+    public partial void GetStats(ref TickArenaStats stats);
+
+    public partial void ResetStats();
+
+    public TickArenaStats GetStats()
+    {
+        var stats = default(TickArenaStats);
+        GetStats(ref stats);
+        return stats;
+    }
+
+    /// <summary>
+    /// Returns a writable span of native memory which is valid until the end of the tick.
+    /// </summary>
+    public unsafe Span<byte> Allocate(int size)
+    {
+        return new Span<byte>((void*)Allocate(new Size(size)), size);
+    }
+
+    /// <summary>
+    /// Encodes the text as UTF-8 into native memory which is valid until the end of the tick.
+    /// </summary>
+    public unsafe StringView Encode(ReadOnlySpan<char> text)
+    {
+        var maxLength = Encoding.UTF8.GetMaxByteCount(text.Length);
+        var data = (byte*)Allocate(new Size(maxLength));
+        var length = Encoding.UTF8.GetBytes(text, new Span<byte>(data, maxLength));
+
+        // returns the unused part of the allocation to the arena
+        Commit(length);
+        return new StringView(data, length);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct TickArenaStats
+{
+    public readonly ulong Allocations;
+
+    /// <summary>
+    /// The number of allocations which did not fit in a chunk and were given a chunk of their own.
+    /// </summary>
+    public readonly ulong LargeAllocations;
+
+    /// <summary>
+    /// The number of bytes allocated since the last reset.
+    /// </summary>
+    public readonly ulong Used;
+
+    public readonly ulong PeakUsed;
+
+    /// <summary>
+    /// The number of bytes of memory held by the arena.
+    /// </summary>
+    public readonly ulong Reserved;
+
+    public readonly ulong Resets;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Native adjustment of the thread sleep of the server to its load. The time between ticks minus the sleep estimates
+/// the work of a tick, and the sleep is set to the remainder of the target interval. While the pacer is enabled dynamic
+/// ticks of the server are disabled; disabling the pacer restores the <c>sleep</c> and <c>use_dyn_ticks</c> of the
+/// server configuration.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct TickPacer
+{
+    public partial void SetConfig(ref TickPacerConfig config);
+
+    public partial void GetConfig(ref TickPacerConfig config);
+
+    public partial void GetStats(ref TickPacerStats stats);
+
+    public TickPacerConfig GetConfig()
+    {
+        var config = default(TickPacerConfig);
+        GetConfig(ref config);
+        return config;
+    }
+
+    public TickPacerStats GetStats()
+    {
+        var stats = default(TickPacerStats);
+        GetStats(ref stats);
+        return stats;
+    }
+}
\ No newline at end of file
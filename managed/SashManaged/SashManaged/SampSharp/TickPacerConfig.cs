@@ -0,0 +1,37 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public struct TickPacerConfig
+{
+    /// <summary>
+    /// The number of ticks per second to hold while the server is not idle. 0 disables the pacer.
+    /// </summary>
+    public uint TargetRate;
+
+    /// <summary>
+    /// The number of ticks per second to hold while the server is idle.
+    /// </summary>
+    public uint IdleRate;
+
+    public uint MinSleepMicroseconds;
+
+    public uint MaxSleepMicroseconds;
+
+    /// <summary>
+    /// The sleep is only changed if it differs more than this from the desired sleep.
+    /// </summary>
+    public uint DeadbandMicroseconds;
+
+    /// <summary>
+    /// The number of queued network messages above which the pacer boosts until the backlog falls below half of it. 0
+    /// disables boosting.
+    /// </summary>
+    public uint BacklogThreshold;
+
+    /// <summary>
+    /// The number of consecutive idle ticks before the pacer switches to the idle rate.
+    /// </summary>
+    public uint IdleTicks;
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum TickPacerMode : uint
+{
+    Disabled,
+
+    /// <summary>
+    /// The sleep is adjusted to hold the target rate.
+    /// </summary>
+    Active,
+
+    /// <summary>
+    /// No players are connected and no messages are queued; the sleep is adjusted to hold the idle rate.
+    /// </summary>
+    Idle,
+
+    /// <summary>
+    /// The network backlog exceeds the threshold; the minimum sleep is used.
+    /// </summary>
+    Boost
+}
\ No newline at end of file
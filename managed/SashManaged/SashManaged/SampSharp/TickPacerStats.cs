@@ -0,0 +1,39 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct TickPacerStats
+{
+    public readonly ulong Ticks;
+
+    /// <summary>
+    /// The number of times the sleep was changed.
+    /// </summary>
+    public readonly ulong Adjustments;
+
+    public readonly ulong IdleTransitions;
+
+    public readonly ulong BoostTransitions;
+
+    public readonly TickPacerMode Mode;
+
+    public readonly uint SleepMicroseconds;
+
+    public readonly uint TargetIntervalMicroseconds;
+
+    /// <summary>
+    /// The number of queued network messages at the last sample.
+    /// </summary>
+    public readonly uint Backlog;
+
+    /// <summary>
+    /// The smoothed time between ticks.
+    /// </summary>
+    public readonly float IntervalMicroseconds;
+
+    /// <summary>
+    /// The smoothed time between ticks minus the sleep.
+    /// </summary>
+    public readonly float WorkMicroseconds;
+}
\ No newline at end of file
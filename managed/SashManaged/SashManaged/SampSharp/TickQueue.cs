@@ -0,0 +1,37 @@
+﻿using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Bounded lock-free queue owned by the SampSharp component. Any thread may enqueue a callback; queued callbacks are
+/// invoked on the server thread at the start of the component's tick.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct TickQueue
+{
+    /// <summary>
+    /// Enqueues an unmanaged callback with the specified payload. Safe to call from any thread. Returns <c>false</c> if
+    /// the queue is full.
+    /// </summary>
+    public partial bool Enqueue(nint callback, nint payload);
+
+    public partial Size Depth();
+
+    public partial Size Capacity();
+
+    public partial void GetStats(ref TickQueueStats stats);
+
+    public partial void ResetStats();
+
+    public unsafe bool Enqueue(delegate* unmanaged<nint, void> callback, nint payload)
+    {
+        return Enqueue((nint)callback, payload);
+    }
+
+    public TickQueueStats GetStats()
+    {
+        var stats = default(TickQueueStats);
+        GetStats(ref stats);
+        return stats;
+    }
+}
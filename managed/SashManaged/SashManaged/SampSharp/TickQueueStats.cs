@@ -0,0 +1,16 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct TickQueueStats
+{
+    public readonly ulong Enqueued;
+    public readonly ulong Drained;
+    public readonly ulong Rejected;
+    public readonly ulong Depth;
+    public readonly ulong PeakDepth;
+    public readonly ulong TotalWaitNanoseconds;
+    public readonly ulong MaxWaitNanoseconds;
+    public readonly ulong LastDrainNanoseconds;
+}
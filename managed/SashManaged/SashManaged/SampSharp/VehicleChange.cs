@@ -0,0 +1,16 @@
+﻿namespace SashManaged.SampSharp;
+
+[Flags]
+public enum VehicleChange : uint
+{
+    None = 0,
+    Created = 1 << 0,
+    Destroyed = 1 << 1,
+    Spawned = 1 << 2,
+    Died = 1 << 3,
+    Position = 1 << 4,
+    Health = 1 << 5,
+    DamageStatus = 1 << 6,
+    Occupants = 1 << 7,
+    Appearance = 1 << 8
+}
\ No newline at end of file
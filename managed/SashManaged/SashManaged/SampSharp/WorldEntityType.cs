@@ -0,0 +1,9 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum WorldEntityType
+{
+    Object,
+    Vehicle,
+    Pickup,
+    Label
+}
\ No newline at end of file
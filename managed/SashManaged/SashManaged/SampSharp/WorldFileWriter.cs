@@ -0,0 +1,164 @@
+﻿using System.Numerics;
+using System.Text;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Writes binary world files for the <see cref="WorldLoader" />. The records are written in the order in which they
+/// were added; strings are stored once in UTF-8.
+/// </summary>
+public sealed class WorldFileWriter
+{
+    public const uint Magic = 0x46575353; // "SSWF"
+    public const ushort Version = 1;
+
+    private readonly MemoryStream _objects = new();
+    private readonly MemoryStream _materials = new();
+    private readonly MemoryStream _vehicles = new();
+    private readonly MemoryStream _pickups = new();
+    private readonly MemoryStream _labels = new();
+    private readonly MemoryStream _strings = new();
+    private readonly Dictionary<string, (uint Offset, uint Length)> _stringRanges = new();
+
+    public int ObjectCount { get; private set; }
+    public int MaterialCount { get; private set; }
+    public int VehicleCount { get; private set; }
+    public int PickupCount { get; private set; }
+    public int LabelCount { get; private set; }
+
+    /// <summary>
+    /// Adds an object and returns its index for <see cref="AddMaterial" />.
+    /// </summary>
+    public int AddObject(int model, Vector3 position, Vector3 rotation, float drawDistance = 0)
+    {
+        using var writer = new BinaryWriter(_objects, Encoding.UTF8, true);
+        writer.Write(model);
+        Write(writer, position);
+        Write(writer, rotation);
+        writer.Write(drawDistance);
+
+        return ObjectCount++;
+    }
+
+    public void AddMaterial(int objectIndex, int slot, int model, string textureLibrary, string textureName, Colour colour)
+    {
+        ArgumentOutOfRangeException.ThrowIfNegative(objectIndex);
+        ArgumentOutOfRangeException.ThrowIfGreaterThanOrEqual(objectIndex, ObjectCount);
+
+        using var writer = new BinaryWriter(_materials, Encoding.UTF8, true);
+        writer.Write((uint)objectIndex);
+        writer.Write((uint)slot);
+        writer.Write(model);
+        WriteString(writer, textureLibrary);
+        WriteString(writer, textureName);
+        Write(writer, colour);
+
+        MaterialCount++;
+    }
+
+    /// <param name="respawnDelay">The respawn delay in seconds or -1 to never respawn.</param>
+    public void AddVehicle(int model, Vector3 position, float angle, int colour1, int colour2, int respawnDelay = -1, bool siren = false, bool isStatic = true,
+        int virtualWorld = 0, int interior = 0)
+    {
+        using var writer = new BinaryWriter(_vehicles, Encoding.UTF8, true);
+        writer.Write(model);
+        Write(writer, position);
+        writer.Write(angle);
+        writer.Write(colour1);
+        writer.Write(colour2);
+        writer.Write(respawnDelay);
+        writer.Write(virtualWorld);
+        writer.Write(interior);
+        writer.Write(siren);
+        writer.Write(isStatic);
+        writer.Write((ushort)0);
+
+        VehicleCount++;
+    }
+
+    public void AddPickup(int model, byte type, Vector3 position, int virtualWorld = 0, bool isStatic = false)
+    {
+        using var writer = new BinaryWriter(_pickups, Encoding.UTF8, true);
+        writer.Write(model);
+        Write(writer, position);
+        writer.Write(virtualWorld);
+        writer.Write(type);
+        writer.Write(isStatic);
+        writer.Write((ushort)0);
+
+        PickupCount++;
+    }
+
+    public void AddLabel(string text, Colour colour, Vector3 position, float drawDistance, int virtualWorld = 0, bool testLos = false)
+    {
+        using var writer = new BinaryWriter(_labels, Encoding.UTF8, true);
+        WriteString(writer, text);
+        Write(writer, colour);
+        Write(writer, position);
+        writer.Write(drawDistance);
+        writer.Write(virtualWorld);
+        writer.Write(testLos);
+        writer.Write((byte)0);
+        writer.Write((ushort)0);
+
+        LabelCount++;
+    }
+
+    public void Write(Stream stream)
+    {
+        using var writer = new BinaryWriter(stream, Encoding.UTF8, true);
+        writer.Write(Magic);
+        writer.Write(Version);
+        writer.Write((ushort)0);
+        writer.Write((uint)ObjectCount);
+        writer.Write((uint)MaterialCount);
+        writer.Write((uint)VehicleCount);
+        writer.Write((uint)PickupCount);
+        writer.Write((uint)LabelCount);
+        writer.Write((uint)_strings.Length);
+        writer.Flush();
+
+        _objects.WriteTo(stream);
+        _materials.WriteTo(stream);
+        _vehicles.WriteTo(stream);
+        _pickups.WriteTo(stream);
+        _labels.WriteTo(stream);
+        _strings.WriteTo(stream);
+    }
+
+    public void Write(string path)
+    {
+        using var stream = File.Create(path);
+        Write(stream);
+    }
+
+    private void WriteString(BinaryWriter writer, string value)
+    {
+        if (!_stringRanges.TryGetValue(value, out var range))
+        {
+            var bytes = Encoding.UTF8.GetBytes(value);
+            range = ((uint)_strings.Length, (uint)bytes.Length);
+            _strings.Write(bytes);
+            _stringRanges.Add(value, range);
+        }
+
+        writer.Write(range.Offset);
+        writer.Write(range.Length);
+    }
+
+    private static void Write(BinaryWriter writer, Vector3 value)
+    {
+        writer.Write(value.X);
+        writer.Write(value.Y);
+        writer.Write(value.Z);
+    }
+
+    private static void Write(BinaryWriter writer, Colour value)
+    {
+        writer.Write(value.R);
+        writer.Write(value.G);
+        writer.Write(value.B);
+        writer.Write(value.A);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// The entities of a type created by a <see cref="WorldLoader" /> load.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct WorldIdRange
+{
+    /// <summary>
+    /// The lowest ID of the created entities or -1 if none were created.
+    /// </summary>
+    public readonly int First;
+
+    /// <summary>
+    /// The highest ID of the created entities or -1 if none were created.
+    /// </summary>
+    public readonly int Last;
+
+    public readonly uint Created;
+
+    /// <summary>
+    /// The number of records of which the entity could not be created, e.g. because the pool is full or the component
+    /// is not loaded.
+    /// </summary>
+    public readonly uint Failed;
+
+    public readonly ulong Nanoseconds;
+
+    /// <summary>
+    /// Gets a value indicating whether the created IDs are consecutive, in which case they are all the IDs from
+    /// <see cref="First" /> to <see cref="Last" />.
+    /// </summary>
+    public bool IsContiguous => Created > 0 && Last - First + 1 == Created;
+}
\ No newline at end of file
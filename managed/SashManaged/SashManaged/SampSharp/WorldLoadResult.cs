@@ -0,0 +1,35 @@
+﻿using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public struct WorldLoadResult
+{
+    public readonly WorldLoadStatus Status;
+
+    /// <summary>
+    /// The number of applied object materials.
+    /// </summary>
+    public readonly uint Materials;
+
+    private readonly WorldIdRanges _ranges;
+
+    /// <summary>
+    /// The time spent mapping and validating the file.
+    /// </summary>
+    public readonly ulong MapNanoseconds;
+
+    public readonly ulong TotalNanoseconds;
+
+    public readonly WorldIdRange GetRange(WorldEntityType type)
+    {
+        return _ranges[(int)type];
+    }
+
+    [InlineArray(4)]
+    private struct WorldIdRanges
+    {
+        private WorldIdRange _element0;
+    }
+}
\ No newline at end of file
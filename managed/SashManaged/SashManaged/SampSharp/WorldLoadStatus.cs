@@ -0,0 +1,21 @@
+﻿namespace SashManaged.SampSharp;
+
+public enum WorldLoadStatus
+{
+    Ok,
+
+    /// <summary>
+    /// The file does not exist, is empty or could not be mapped.
+    /// </summary>
+    OpenFailed,
+
+    /// <summary>
+    /// The file is not a world file or was written with a different version of the format.
+    /// </summary>
+    InvalidHeader,
+
+    /// <summary>
+    /// The file is smaller than the record counts of its header require.
+    /// </summary>
+    Truncated
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Creates the objects, vehicles, pickups and labels of a binary world file in a single native pass over the
+/// memory-mapped file. World files are written by the <see cref="WorldFileWriter" /> and can be converted from Pawn
+/// map scripts by the <see cref="WorldMapConverter" />. The IDs of the entities created by the last load are kept until
+/// the next load.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct WorldLoader
+{
+    public partial bool Load(string path, ref WorldLoadResult result);
+
+    public partial Size CopyIds(WorldEntityType type, nint ids, Size capacity);
+
+    public WorldLoadResult Load(string path)
+    {
+        var result = default(WorldLoadResult);
+        Load(path, ref result);
+        return result;
+    }
+
+    /// <summary>
+    /// Copies the IDs of the entities of the specified type created by the last load, in record order, and returns the
+    /// number of copied IDs.
+    /// </summary>
+    public unsafe int CopyIds(WorldEntityType type, Span<int> ids)
+    {
+        fixed (int* pointer = ids)
+        {
+            return (int)CopyIds(type, (nint)pointer, ids.Length).Value;
+        }
+    }
+}
\ No newline at end of file
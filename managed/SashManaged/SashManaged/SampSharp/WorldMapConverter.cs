@@ -0,0 +1,214 @@
+﻿using System.Globalization;
+using System.Numerics;
+using System.Text;
+using System.Text.RegularExpressions;
+using SashManaged.OpenMp;
+
+namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Converts Pawn map scripts, as exported by the common map editors, to world files. Recognized calls are
+/// <c>CreateObject</c>, <c>CreateDynamicObject</c>, <c>SetObjectMaterial</c>, <c>SetDynamicObjectMaterial</c>,
+/// <c>AddStaticVehicle</c>, <c>AddStaticVehicleEx</c>, <c>CreateVehicle</c>, <c>CreatePickup</c>,
+/// <c>AddStaticPickup</c>, <c>Create3DTextLabel</c> and <c>CreateDynamic3DTextLabel</c>; a material is applied to the
+/// object assigned to the variable passed as its first argument or, if the variable is unknown, to the last object.
+/// Other statements are counted as skipped.
+/// </summary>
+public sealed partial class WorldMapConverter(WorldFileWriter writer)
+{
+    private readonly Dictionary<string, int> _objectVariables = new();
+    private int _lastObject = -1;
+
+    public int Converted { get; private set; }
+    public int Skipped { get; private set; }
+
+    public static WorldFileWriter Convert(string path)
+    {
+        var writer = new WorldFileWriter();
+        using var reader = File.OpenText(path);
+        new WorldMapConverter(writer).Convert(reader);
+        return writer;
+    }
+
+    public void Convert(TextReader reader)
+    {
+        while (reader.ReadLine() is { } line)
+        {
+            ConvertLine(line);
+        }
+    }
+
+    public void ConvertLine(string line)
+    {
+        var match = CallRegex().Match(line);
+        if (!match.Success)
+        {
+            return;
+        }
+
+        var variable = match.Groups["variable"].Value;
+        var function = match.Groups["function"].Value;
+        var args = SplitArguments(match.Groups["arguments"].Value);
+
+        if (TryConvert(function, variable, args))
+        {
+            Converted++;
+        }
+        else
+        {
+            Skipped++;
+        }
+    }
+
+    private bool TryConvert(string function, string variable, List<string> args)
+    {
+        switch (function)
+        {
+            case "CreateObject" when args.Count >= 7:
+            case "CreateDynamicObject" when args.Count >= 7:
+            {
+                var drawDistance = function == "CreateObject"
+                    ? Float(args, 7, 0)
+                    : Float(args, 11, 0);
+
+                _lastObject = writer.AddObject(Int(args, 0), Vector(args, 1), Vector(args, 4), drawDistance);
+                if (variable.Length > 0)
+                {
+                    _objectVariables[variable] = _lastObject;
+                }
+                return true;
+            }
+            case "SetObjectMaterial" when args.Count >= 5:
+            case "SetDynamicObjectMaterial" when args.Count >= 5:
+            {
+                var objectIndex = _objectVariables.GetValueOrDefault(args[0], _lastObject);
+                if (objectIndex < 0)
+                {
+                    return false;
+                }
+
+                writer.AddMaterial(objectIndex, Int(args, 1), Int(args, 2), Unquote(args[3]), Unquote(args[4]), Argb(Int(args, 5, 0)));
+                return true;
+            }
+            case "AddStaticVehicle" when args.Count >= 7:
+                writer.AddVehicle(Int(args, 0), Vector(args, 1), Float(args, 4), Int(args, 5), Int(args, 6));
+                return true;
+            case "AddStaticVehicleEx" when args.Count >= 8:
+                writer.AddVehicle(Int(args, 0), Vector(args, 1), Float(args, 4), Int(args, 5), Int(args, 6), Int(args, 7), Int(args, 8, 0) != 0);
+                return true;
+            case "CreateVehicle" when args.Count >= 8:
+                writer.AddVehicle(Int(args, 0), Vector(args, 1), Float(args, 4), Int(args, 5), Int(args, 6), Int(args, 7), Int(args, 8, 0) != 0, false);
+                return true;
+            case "CreatePickup" when args.Count >= 5:
+            case "AddStaticPickup" when args.Count >= 5:
+                writer.AddPickup(Int(args, 0), (byte)Int(args, 1), Vector(args, 2), Int(args, 5, 0), function == "AddStaticPickup");
+                return true;
+            case "Create3DTextLabel" when args.Count >= 6:
+                writer.AddLabel(Unquote(args[0]), Rgba(Int(args, 1)), Vector(args, 2), Float(args, 5), Int(args, 6, 0), Int(args, 7, 0) != 0);
+                return true;
+            case "CreateDynamic3DTextLabel" when args.Count >= 6:
+                writer.AddLabel(Unquote(args[0]), Rgba(Int(args, 1)), Vector(args, 2), Float(args, 5), Math.Max(Int(args, 9, 0), 0), Int(args, 8, 0) != 0);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    private static List<string> SplitArguments(string arguments)
+    {
+        var result = new List<string>();
+        var current = new StringBuilder();
+        var quoted = false;
+
+        for (var i = 0; i < arguments.Length; i++)
+        {
+            var c = arguments[i];
+            if (quoted && c == '\\' && i + 1 < arguments.Length)
+            {
+                current.Append(c).Append(arguments[++i]);
+                continue;
+            }
+
+            if (c == '"')
+            {
+                quoted = !quoted;
+            }
+            else if (c == ',' && !quoted)
+            {
+                result.Add(current.ToString().Trim());
+                current.Clear();
+                continue;
+            }
+
+            current.Append(c);
+        }
+
+        if (current.Length > 0 || result.Count > 0)
+        {
+            result.Add(current.ToString().Trim());
+        }
+
+        return result;
+    }
+
+    private static string Unquote(string argument)
+    {
+        if (argument.Length < 2 || argument[0] != '"' || argument[^1] != '"')
+        {
+            return argument;
+        }
+
+        return argument[1..^1].Replace("\\\"", "\"").Replace("\\\\", "\\");
+    }
+
+    private static int Int(List<string> args, int index, int fallback)
+    {
+        return index < args.Count ? Int(args, index) : fallback;
+    }
+
+    private static int Int(List<string> args, int index)
+    {
+        var value = args[index];
+        if (value.StartsWith("0x", StringComparison.OrdinalIgnoreCase) &&
+            uint.TryParse(value.AsSpan(2), NumberStyles.HexNumber, CultureInfo.InvariantCulture, out var hex))
+        {
+            return unchecked((int)hex);
+        }
+
+        if (int.TryParse(value, NumberStyles.Integer, CultureInfo.InvariantCulture, out var integer))
+        {
+            return integer;
+        }
+
+        // floats passed to integer parameters and named constants such as INVALID_PLAYER_ID
+        return float.TryParse(value, NumberStyles.Float, CultureInfo.InvariantCulture, out var number) ? (int)number : -1;
+    }
+
+    private static float Float(List<string> args, int index, float fallback)
+    {
+        return index < args.Count ? Float(args, index) : fallback;
+    }
+
+    private static float Float(List<string> args, int index)
+    {
+        return float.TryParse(args[index], NumberStyles.Float, CultureInfo.InvariantCulture, out var value) ? value : 0;
+    }
+
+    private static Vector3 Vector(List<string> args, int index)
+    {
+        return new Vector3(Float(args, index), Float(args, index + 1), Float(args, index + 2));
+    }
+
+    private static Colour Rgba(int value)
+    {
+        return new Colour((byte)(value >> 24), (byte)(value >> 16), (byte)(value >> 8), (byte)value);
+    }
+
+    private static Colour Argb(int value)
+    {
+        return new Colour((byte)(value >> 16), (byte)(value >> 8), (byte)value, (byte)(value >> 24));
+    }
+
+    [GeneratedRegex("""^\s*(?:(?:new\s+)?(?<variable>[A-Za-z_@][\w@]*(?:\[[^\]]*\])?)\s*=\s*)?(?<function>[A-Za-z_]\w*)\s*\((?<arguments>.*)\)\s*;""")]
+    private static partial Regex CallRegex();
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+﻿namespace SashManaged.SampSharp;
+
+/// <summary>
+/// Periodic binary snapshot of the dynamic world for crash recovery and quick restarts. Vehicles with their mods, paint
+/// and damage, objects with their movement and materials, and text labels are copied on the server thread and written
+/// by a background thread to a memory-mapped file, which replaces the previous snapshot once it is complete. A snapshot
+/// is restored in a single native pass; the IDs of the restored entities can be looked up by the IDs they had when the
+/// snapshot was taken.
+/// </summary>
+[OpenMpApi2]
+public readonly partial struct WorldSnapshot
+{
+    /// <summary>
+    /// Starts writing snapshots to the file at the specified path, every <paramref name="intervalSeconds" /> seconds if
+    /// it is not 0.
+    /// </summary>
+    public partial bool Start(string path, uint intervalSeconds);
+
+    public partial void Stop();
+
+    public partial bool IsRunning();
+
+    /// <summary>
+    /// Copies the state of the world and queues it for writing. Returns <see langword="false" /> if snapshots are not
+    /// running or the previous snapshot is still being written.
+    /// </summary>
+    public partial bool Save();
+
+    /// <summary>
+    /// Creates the entities of the snapshot at the specified path. The pickup range of the result is not used.
+    /// </summary>
+    public partial bool Restore(string path, ref WorldLoadResult result);
+
+    /// <summary>
+    /// Returns the ID of the entity restored from the entity with the specified ID at the time of the snapshot, or -1.
+    /// </summary>
+    public partial int GetRestoredId(WorldEntityType type, int id);
+
+    public partial void GetStats(ref WorldSnapshotStats stats);
+
+    public WorldLoadResult Restore(string path)
+    {
+        var result = default(WorldLoadResult);
+        Restore(path, ref result);
+        return result;
+    }
+
+    public WorldSnapshotStats GetStats()
+    {
+        var stats = default(WorldSnapshotStats);
+        GetStats(ref stats);
+        return stats;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+﻿using System.Runtime.InteropServices;
+
+namespace SashManaged.SampSharp;
+
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct WorldSnapshotStats
+{
+    public readonly ulong Snapshots;
+
+    /// <summary>
+    /// The number of snapshots which could not be written.
+    /// </summary>
+    public readonly ulong Failed;
+
+    /// <summary>
+    /// The number of snapshots which were not taken because the previous snapshot was still being written.
+    /// </summary>
+    public readonly ulong Skipped;
+
+    /// <summary>
+    /// The size of the last written snapshot in bytes.
+    /// </summary>
+    public readonly ulong Bytes;
+
+    /// <summary>
+    /// The time spent copying the state on the server thread for the last snapshot.
+    /// </summary>
+    public readonly ulong CaptureNanoseconds;
+
+    /// <summary>
+    /// The time spent writing the last snapshot on the background thread.
+    /// </summary>
+    public readonly ulong WriteNanoseconds;
+
+    public readonly uint Vehicles;
+    public readonly uint Objects;
+    public readonly uint Materials;
+    public readonly uint Labels;
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+#include "mapped-file.hpp"
+
+#ifdef WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+#ifdef WIN32
+
+bool MappedFile::create(const std::string& path, size_t size)
+{
+	close();
+
+	file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file_ == INVALID_HANDLE_VALUE)
+	{
+		file_ = nullptr;
+		return false;
+	}
+
+	// the mapping grows the file to the requested size
+	const uint64_t size64 = size;
+	mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64), nullptr);
+	if (mapping_ != nullptr)
+	{
+		data_ = static_cast<uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, size));
+	}
+
+	if (data_ == nullptr)
+	{
+		close(0);
+		return false;
+	}
+
+	size_ = size;
+	writable_ = true;
+	return true;
+}
+
+bool MappedFile::open(const std::string& path)
+{
+	close();
+
+	file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file_ == INVALID_HANDLE_VALUE)
+	{
+		file_ = nullptr;
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file_, &size) && size.QuadPart > 0)
+	{
+		mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping_ != nullptr)
+		{
+			data_ = static_cast<uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+		}
+	}
+
+	if (data_ == nullptr)
+	{
+		close();
+		return false;
+	}
+
+	size_ = static_cast<size_t>(size.QuadPart);
+	return true;
+}
+
+bool MappedFile::flush()
+{
+	if (data_ == nullptr || !writable_)
+	{
+		return false;
+	}
+	return FlushViewOfFile(data_, 0) && FlushFileBuffers(file_);
+}
+
+bool MappedFile::close(size_t length)
+{
+	bool truncated = true;
+
+	// dirty pages of the view are written by the system after it is unmapped
+	if (data_ != nullptr)
+	{
+		UnmapViewOfFile(data_);
+		data_ = nullptr;
+	}
+
+	if (mapping_ != nullptr)
+	{
+		CloseHandle(mapping_);
+		mapping_ = nullptr;
+	}
+
+	if (file_ != nullptr)
+	{
+		if (writable_ && length < size_)
+		{
+			LARGE_INTEGER end;
+			end.QuadPart = static_cast<LONGLONG>(length);
+			truncated = SetFilePointerEx(file_, end, nullptr, FILE_BEGIN) && SetEndOfFile(file_);
+		}
+		CloseHandle(file_);
+		file_ = nullptr;
+	}
+
+	size_ = 0;
+	writable_ = false;
+	return truncated;
+}
+
+bool MappedFile::isOpen() const
+{
+	return data_ != nullptr;
+}
+
+#else
+
+bool MappedFile::create(const std::string& path, size_t size)
+{
+	close();
+
+	fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd_ < 0)
+	{
+		return false;
+	}
+
+	if (ftruncate(fd_, static_cast<off_t>(size)) == 0)
+	{
+		void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+		if (data != MAP_FAILED)
+		{
+			data_ = static_cast<uint8_t*>(data);
+		}
+	}
+
+	if (data_ == nullptr)
+	{
+		close();
+		return false;
+	}
+
+	size_ = size;
+	writable_ = true;
+	return true;
+}
+
+bool MappedFile::open(const std::string& path)
+{
+	close();
+
+	fd_ = ::open(path.c_str(), O_RDONLY);
+	if (fd_ < 0)
+	{
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(fd_, &info) == 0 && info.st_size > 0)
+	{
+		void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+		if (data != MAP_FAILED)
+		{
+			data_ = static_cast<uint8_t*>(data);
+			size_ = static_cast<size_t>(info.st_size);
+		}
+	}
+
+	if (data_ == nullptr)
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+bool MappedFile::flush()
+{
+	if (data_ == nullptr || !writable_)
+	{
+		return false;
+	}
+	return msync(data_, size_, MS_SYNC) == 0 && fsync(fd_) == 0;
+}
+
+bool MappedFile::close(size_t length)
+{
+	bool truncated = true;
+
+	// the write-back is scheduled without waiting for it, so closing a segment does not stall the server thread
+	if (data_ != nullptr)
+	{
+		if (writable_)
+		{
+			msync(data_, size_, MS_ASYNC);
+		}
+		munmap(data_, size_);
+		data_ = nullptr;
+	}
+
+	if (fd_ >= 0)
+	{
+		if (writable_ && length < size_)
+		{
+			truncated = ftruncate(fd_, static_cast<off_t>(length)) == 0;
+		}
+		::close(fd_);
+		fd_ = -1;
+	}
+
+	size_ = 0;
+	writable_ = false;
+	return truncated;
+}
+
+bool MappedFile::isOpen() const
+{
+	return data_ != nullptr;
+}
+
+#endif
+
+uint8_t* MappedFile::data() const
+{
+	return data_;
+}
+
+size_t MappedFile::size() const
+{
+	return size_;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// file mapped into memory, either created for writing with a fixed size or opened read-only
+class MappedFile final
+{
+private:
+	uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+	bool writable_ = false;
+
+#ifdef WIN32
+	void* file_ = nullptr;
+	void* mapping_ = nullptr;
+#else
+	int fd_ = -1;
+#endif
+
+public:
+	MappedFile() = default;
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile();
+
+	/// creates (or truncates) the file, grows it to the specified size and maps it read/write
+	bool create(const std::string& path, size_t size);
+
+	/// maps an existing file read-only
+	bool open(const std::string& path);
+
+	/// writes the pages of a file created for writing and the file itself to the disk and waits for them. returns
+	/// false if either failed
+	bool flush();
+
+	/// unmaps and closes the file. a file created for writing is truncated to the specified length if it is smaller
+	/// than the mapped size. the written pages are flushed asynchronously by the system, so closing does not wait for
+	/// the disk. returns false if the file could not be truncated
+	bool close(size_t length = SIZE_MAX);
+
+	bool isOpen() const;
+
+	uint8_t* data() const;
+
+	size_t size() const;
+};
@@ -0,0 +1,308 @@
+#include "object-animator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static Vector3 lerp(const Vector3& a, const Vector3& b, float t)
+{
+	return Vector3(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t);
+}
+
+static float distance(const Vector3& a, const Vector3& b)
+{
+	const float dx = a.x - b.x;
+	const float dy = a.y - b.y;
+	const float dz = a.z - b.z;
+	return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+static float catmullRom(float p0, float p1, float p2, float p3, float t)
+{
+	const float t2 = t * t;
+	const float t3 = t2 * t;
+	return 0.5f * (2.0f * p1 + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 + (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+static float ease(ObjectPathEasing easing, float t)
+{
+	switch (easing)
+	{
+	case ObjectPathEasing_In:
+		return t * t;
+	case ObjectPathEasing_Out:
+		return 1.0f - (1.0f - t) * (1.0f - t);
+	case ObjectPathEasing_InOut:
+		return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * (1.0f - t) * (1.0f - t);
+	default:
+		return t;
+	}
+}
+
+/// position on the segment from waypoint k to the next waypoint; the neighbours of the end points of an open path are
+/// the end points themselves
+static Vector3 interpolate(const ObjectPathWaypoint* waypoints, size_t count, size_t k, float t, ObjectPathInterpolation interpolation, bool closed)
+{
+	const size_t k1 = (k + 1) % count;
+	if (interpolation != ObjectPathInterpolation_CatmullRom)
+	{
+		return lerp(waypoints[k].position, waypoints[k1].position, t);
+	}
+
+	const size_t k0 = closed ? (k + count - 1) % count : (k == 0 ? 0 : k - 1);
+	const size_t k2 = closed ? (k + 2) % count : std::min(k + 2, count - 1);
+
+	const Vector3& p0 = waypoints[k0].position;
+	const Vector3& p1 = waypoints[k].position;
+	const Vector3& p2 = waypoints[k1].position;
+	const Vector3& p3 = waypoints[k2].position;
+
+	return Vector3(catmullRom(p0.x, p1.x, p2.x, p3.x, t), catmullRom(p0.y, p1.y, p2.y, p3.y, t), catmullRom(p0.z, p1.z, p2.z, p3.z, t));
+}
+
+ObjectAnimator::ObjectAnimator()
+	: animations_(OBJECT_POOL_SIZE)
+{
+}
+
+ObjectAnimator::~ObjectAnimator()
+{
+	detach();
+}
+
+void ObjectAnimator::attach(IComponentList* components)
+{
+	objects_ = components->queryComponent<IObjectsComponent>();
+	if (objects_ != nullptr)
+	{
+		objects_->getEventDispatcher().addEventHandler(this);
+		objects_->getPoolEventDispatcher().addEventHandler(this);
+	}
+}
+
+void ObjectAnimator::onFree(IComponent* component)
+{
+	if (component == objects_)
+	{
+		objects_ = nullptr;
+	}
+}
+
+void ObjectAnimator::detach()
+{
+	if (objects_ != nullptr)
+	{
+		objects_->getEventDispatcher().removeEventHandler(this);
+		objects_->getPoolEventDispatcher().removeEventHandler(this);
+		objects_ = nullptr;
+	}
+}
+
+void ObjectAnimator::setCompletedHandler(object_path_completed_fn handler)
+{
+	onCompleted_ = handler;
+}
+
+ObjectAnimator::Animation* ObjectAnimator::getAnimation(int id)
+{
+	if (id < 0 || static_cast<size_t>(id) >= animations_.size())
+	{
+		return nullptr;
+	}
+	return &animations_[id];
+}
+
+void ObjectAnimator::moveTo(IObject& object, const Animation& animation, size_t index, float speed)
+{
+	// a target rotation of -1000 leaves the rotation of the object unchanged
+	ObjectMoveData data;
+	data.targetPos = animation.positions[index];
+	data.targetRot = animation.rotate ? animation.rotations[index] : Vector3(-1000.0f, -1000.0f, -1000.0f);
+	data.speed = speed;
+	object.move(data);
+	stats_.moves++;
+}
+
+void ObjectAnimator::finish(IObject& object, Animation& animation)
+{
+	animation.active = false;
+	stats_.active--;
+	stats_.completed++;
+
+	// the handler may start another animation of the object
+	if (onCompleted_ != nullptr)
+	{
+		onCompleted_(object);
+	}
+}
+
+bool ObjectAnimator::animate(IObject& object, const ObjectPathWaypoint* waypoints, size_t count, const ObjectPathOptions& options)
+{
+	Animation* animation = getAnimation(object.getID());
+	if (animation == nullptr || count < 2)
+	{
+		return false;
+	}
+
+	const bool closed = options.mode == ObjectPathMode_Loop;
+
+	// every waypoint at the end of a segment needs a speed
+	for (size_t i = closed ? 0 : 1; i < count; i++)
+	{
+		if (!(waypoints[i].speed > 0.0f))
+		{
+			return false;
+		}
+	}
+
+	const size_t segments = closed ? count : count - 1;
+	const uint32_t subdivisions = options.interpolation == ObjectPathInterpolation_Linear && options.easing == ObjectPathEasing_None
+		? 1
+		: std::clamp<uint32_t>(options.subdivisions, 1, MAX_SUBDIVISIONS);
+
+	animation->positions.clear();
+	animation->rotations.clear();
+	animation->speeds.clear();
+	animation->positions.push_back(waypoints[0].position);
+	animation->rotations.push_back(waypoints[0].rotation);
+
+	Vector3 samples[MAX_SUBDIVISIONS + 1];
+	for (size_t k = 0; k < segments; k++)
+	{
+		const ObjectPathWaypoint& from = waypoints[k];
+		const ObjectPathWaypoint& to = waypoints[(k + 1) % count];
+
+		samples[0] = from.position;
+		float length = 0.0f;
+		for (uint32_t j = 1; j <= subdivisions; j++)
+		{
+			samples[j] = interpolate(waypoints, count, k, ease(options.easing, static_cast<float>(j) / subdivisions), options.interpolation, closed);
+			length += distance(samples[j - 1], samples[j]);
+		}
+
+		// every move of the segment takes the same time, so eased moves differ in speed only
+		for (uint32_t j = 1; j <= subdivisions; j++)
+		{
+			const float chord = distance(samples[j - 1], samples[j]);
+			const float speed = length > 0.0f ? chord * subdivisions * to.speed / length : to.speed;
+
+			animation->positions.push_back(samples[j]);
+			animation->rotations.push_back(lerp(from.rotation, to.rotation, ease(options.easing, static_cast<float>(j) / subdivisions)));
+			animation->speeds.push_back(std::max(speed, 0.001f));
+		}
+	}
+
+	if (!animation->active)
+	{
+		stats_.active++;
+	}
+
+	animation->active = true;
+	animation->rotate = options.rotate;
+	animation->mode = options.mode;
+	animation->direction = 1;
+
+	if (waypoints[0].speed > 0.0f)
+	{
+		animation->index = 0;
+		moveTo(object, *animation, 0, waypoints[0].speed);
+	}
+	else
+	{
+		object.setPosition(animation->positions[0]);
+		if (options.rotate)
+		{
+			object.setRotation(GTAQuat(animation->rotations[0]));
+		}
+
+		animation->index = 1;
+		moveTo(object, *animation, 1, animation->speeds[0]);
+	}
+	return true;
+}
+
+void ObjectAnimator::stop(IObject& object)
+{
+	Animation* animation = getAnimation(object.getID());
+	if (animation == nullptr || !animation->active)
+	{
+		return;
+	}
+
+	animation->active = false;
+	stats_.active--;
+	object.stop();
+}
+
+bool ObjectAnimator::isAnimating(IObject& object)
+{
+	const Animation* animation = getAnimation(object.getID());
+	return animation != nullptr && animation->active;
+}
+
+void ObjectAnimator::getStats(ObjectAnimatorStats& stats) const
+{
+	stats = stats_;
+}
+
+void ObjectAnimator::onMoved(IObject& object)
+{
+	Animation* animation = getAnimation(object.getID());
+	if (animation == nullptr || !animation->active)
+	{
+		return;
+	}
+
+	const size_t last = animation->positions.size() - 1;
+	size_t next;
+	float speed;
+
+	if (animation->direction > 0)
+	{
+		if (animation->index < last)
+		{
+			next = animation->index + 1;
+			speed = animation->speeds[animation->index];
+		}
+		else if (animation->mode == ObjectPathMode_Loop)
+		{
+			// the last point of a closed path is the first point
+			next = 1;
+			speed = animation->speeds[0];
+		}
+		else if (animation->mode == ObjectPathMode_PingPong)
+		{
+			animation->direction = -1;
+			next = last - 1;
+			speed = animation->speeds[last - 1];
+		}
+		else
+		{
+			finish(object, *animation);
+			return;
+		}
+	}
+	else if (animation->index > 0)
+	{
+		next = animation->index - 1;
+		speed = animation->speeds[next];
+	}
+	else
+	{
+		animation->direction = 1;
+		next = 1;
+		speed = animation->speeds[0];
+	}
+
+	animation->index = next;
+	moveTo(object, *animation, next, speed);
+}
+
+void ObjectAnimator::onPoolEntryDestroyed(IObject& entry)
+{
+	Animation* animation = getAnimation(entry.getID());
+	if (animation != nullptr && animation->active)
+	{
+		animation->active = false;
+		stats_.active--;
+	}
+}
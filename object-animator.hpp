@@ -0,0 +1,146 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/Objects/objects.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "dotnet/coreclr_delegates.h"
+
+using namespace Impl;
+
+enum ObjectPathInterpolation : uint8_t
+{
+	/// straight segments between the waypoints
+	ObjectPathInterpolation_Linear,
+	/// Catmull-Rom spline through the waypoints
+	ObjectPathInterpolation_CatmullRom,
+};
+
+enum ObjectPathMode : uint8_t
+{
+	/// the path is followed once
+	ObjectPathMode_Once,
+	/// the path is closed with a segment from the last to the first waypoint and repeated
+	ObjectPathMode_Loop,
+	/// the path is followed forwards and backwards
+	ObjectPathMode_PingPong,
+};
+
+enum ObjectPathEasing : uint8_t
+{
+	ObjectPathEasing_None,
+	/// every segment starts slow
+	ObjectPathEasing_In,
+	/// every segment ends slow
+	ObjectPathEasing_Out,
+	ObjectPathEasing_InOut,
+};
+
+/// waypoint of an object path. layout is shared with the managed ObjectPathWaypoint struct
+struct ObjectPathWaypoint
+{
+	Vector3 position;
+	Vector3 rotation;
+	/// speed of the segment which ends at the waypoint. the first waypoint ends the closing segment of a loop, so its
+	/// speed is only optional on an open path
+	float speed;
+};
+
+/// options of an object path. layout is shared with the managed ObjectPathOptions struct
+struct ObjectPathOptions
+{
+	ObjectPathInterpolation interpolation;
+	ObjectPathMode mode;
+	ObjectPathEasing easing;
+	/// whether the rotation of the waypoints is applied; otherwise the rotation of the object is not changed
+	bool rotate;
+	/// moves per segment of a spline or eased path
+	uint32_t subdivisions;
+};
+
+/// statistics of the object animator. layout is shared with the managed ObjectAnimatorStats struct
+struct ObjectAnimatorStats
+{
+	/// moves issued to animated objects
+	uint64_t moves;
+	/// paths which were followed to the end
+	uint64_t completed;
+	uint32_t active;
+};
+
+/// handler called when an object reached the end of a path which is followed once
+typedef void (CORECLR_DELEGATE_CALLTYPE *object_path_completed_fn)(IObject&);
+
+/// moves objects along paths of waypoints without managed code per segment. a path is compiled into a list of moves
+/// when it is started: splines and easing are approximated by subdividing every segment into moves with their own
+/// target and speed, so the time of a segment remains its length divided by its speed. the next move is issued from
+/// onMoved of the previous one. the managed onMoved handlers are still called for every move and can skip animated
+/// objects with isAnimating.
+class ObjectAnimator final
+	: public ObjectEventHandler
+	, public PoolEventHandler<IObject>
+{
+private:
+	static constexpr uint32_t MAX_SUBDIVISIONS = 64;
+
+	struct Animation
+	{
+		bool active = false;
+		bool rotate = false;
+		ObjectPathMode mode = ObjectPathMode_Once;
+		/// direction in which the points are followed; -1 while a ping-pong path is followed backwards
+		int8_t direction = 1;
+		/// point the object is moving to
+		size_t index = 0;
+		std::vector<Vector3> positions;
+		std::vector<Vector3> rotations;
+		/// speed of the move from point N to point N + 1
+		std::vector<float> speeds;
+	};
+
+	IObjectsComponent* objects_ = nullptr;
+	std::vector<Animation> animations_;
+	object_path_completed_fn onCompleted_ = nullptr;
+	ObjectAnimatorStats stats_ {};
+
+	Animation* getAnimation(int id);
+
+	/// moves the object to the point of the animation at the speed
+	void moveTo(IObject& object, const Animation& animation, size_t index, float speed);
+
+	void finish(IObject& object, Animation& animation);
+
+public:
+	ObjectAnimator();
+
+	ObjectAnimator(const ObjectAnimator&) = delete;
+	ObjectAnimator& operator=(const ObjectAnimator&) = delete;
+
+	~ObjectAnimator();
+
+	void attach(IComponentList* components);
+
+	void onFree(IComponent* component);
+
+	void detach();
+
+	void setCompletedHandler(object_path_completed_fn handler);
+
+	/// starts moving the object along the path. on an open path the object first moves to the first waypoint at its
+	/// speed, or is placed there if the speed is not positive; a loop requires a positive speed on every waypoint,
+	/// including the first. returns false if the path has less than two waypoints or a required speed is not positive
+	bool animate(IObject& object, const ObjectPathWaypoint* waypoints, size_t count, const ObjectPathOptions& options);
+
+	/// stops the animation and the movement of the object
+	void stop(IObject& object);
+
+	bool isAnimating(IObject& object);
+
+	void getStats(ObjectAnimatorStats& stats) const;
+
+	void onMoved(IObject& object) override;
+
+	void onPoolEntryDestroyed(IObject& entry) override;
+};
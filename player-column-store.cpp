@@ -0,0 +1,126 @@
+#include "player-column-store.hpp"
+
+#include <cstring>
+#include <new>
+
+PlayerColumnData::PlayerColumnData(PlayerColumnStore& store, int row)
+	: store_(store)
+	, row_(row)
+{
+}
+
+int PlayerColumnData::getRow() const
+{
+	return row_;
+}
+
+void* PlayerColumnData::getField(int column) const
+{
+	auto data = static_cast<uint8_t*>(store_.getColumn(column));
+	if (data == nullptr)
+	{
+		return nullptr;
+	}
+	return data + row_ * store_.getElementSize(column);
+}
+
+void PlayerColumnData::freeExtension()
+{
+	store_.clearRow(row_);
+	delete this;
+}
+
+void PlayerColumnData::reset()
+{
+	store_.clearRow(row_);
+}
+
+PlayerColumnStore::~PlayerColumnStore()
+{
+	detach();
+
+	for (const Column& column : columns_)
+	{
+		::operator delete(column.data, std::align_val_t { ALIGNMENT });
+	}
+}
+
+void PlayerColumnStore::attach(ICore* core)
+{
+	core_ = core;
+	core_->getPlayers().getPlayerConnectDispatcher().addEventHandler(this);
+}
+
+void PlayerColumnStore::detach()
+{
+	if (core_ != nullptr)
+	{
+		core_->getPlayers().getPlayerConnectDispatcher().removeEventHandler(this);
+		core_ = nullptr;
+	}
+}
+
+int PlayerColumnStore::addColumn(size_t element_size)
+{
+	if (element_size == 0)
+	{
+		return -1;
+	}
+
+	const size_t bytes = element_size * PLAYER_POOL_SIZE;
+	auto data = static_cast<uint8_t*>(::operator new(bytes, std::align_val_t { ALIGNMENT }));
+	memset(data, 0, bytes);
+
+	columns_.push_back(Column { data, element_size });
+	return static_cast<int>(columns_.size() - 1);
+}
+
+void* PlayerColumnStore::getColumn(int column) const
+{
+	if (column < 0 || static_cast<size_t>(column) >= columns_.size())
+	{
+		return nullptr;
+	}
+	return columns_[column].data;
+}
+
+size_t PlayerColumnStore::getElementSize(int column) const
+{
+	if (column < 0 || static_cast<size_t>(column) >= columns_.size())
+	{
+		return 0;
+	}
+	return columns_[column].elementSize;
+}
+
+size_t PlayerColumnStore::getColumnCount() const
+{
+	return columns_.size();
+}
+
+size_t PlayerColumnStore::getRowCount() const
+{
+	return PLAYER_POOL_SIZE;
+}
+
+void PlayerColumnStore::clearRow(int row)
+{
+	if (row < 0 || static_cast<size_t>(row) >= PLAYER_POOL_SIZE)
+	{
+		return;
+	}
+
+	for (const Column& column : columns_)
+	{
+		memset(column.data + row * column.elementSize, 0, column.elementSize);
+	}
+}
+
+void PlayerColumnStore::onPlayerConnect(IPlayer& player)
+{
+	const int row = player.getID();
+
+	// discard anything written to the row after the previous occupant disconnected
+	clearRow(row);
+	player.addExtension(new PlayerColumnData(*this, row), true);
+}
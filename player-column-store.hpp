@@ -0,0 +1,86 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Impl;
+
+class PlayerColumnStore;
+
+/// player extension which owns the row of the player in the column store. the row is cleared when the extension is
+/// freed (the player disconnected) or reset
+struct IPlayerColumnData : IExtension
+{
+	PROVIDE_EXT_UID(0x5A3F0B9C7E21D463);
+
+	virtual int getRow() const = 0;
+
+	/// pointer to the element of the player in the column or null if the column does not exist
+	virtual void* getField(int column) const = 0;
+};
+
+class PlayerColumnData final : public IPlayerColumnData
+{
+private:
+	PlayerColumnStore& store_;
+	int row_;
+
+public:
+	PlayerColumnData(PlayerColumnStore& store, int row);
+
+	int getRow() const override;
+
+	void* getField(int column) const override;
+
+	void freeExtension() override;
+
+	void reset() override;
+};
+
+/// structure-of-arrays storage for per-player data. every column is a contiguous, 64-byte aligned array with one
+/// element per player ID. column pointers are stable for the lifetime of the component.
+class PlayerColumnStore final
+	: public PlayerConnectEventHandler
+{
+private:
+	static constexpr size_t ALIGNMENT = 64;
+
+	struct Column
+	{
+		uint8_t* data;
+		size_t elementSize;
+	};
+
+	ICore* core_ = nullptr;
+	std::vector<Column> columns_;
+
+public:
+	PlayerColumnStore() = default;
+
+	PlayerColumnStore(const PlayerColumnStore&) = delete;
+	PlayerColumnStore& operator=(const PlayerColumnStore&) = delete;
+
+	~PlayerColumnStore();
+
+	void attach(ICore* core);
+
+	void detach();
+
+	/// adds a column with elements of the specified size and returns its index or -1 if the size is invalid
+	int addColumn(size_t element_size);
+
+	void* getColumn(int column) const;
+
+	size_t getElementSize(int column) const;
+
+	size_t getColumnCount() const;
+
+	size_t getRowCount() const;
+
+	/// zeroes the elements of the row in all columns
+	void clearRow(int row);
+
+	void onPlayerConnect(IPlayer& player) override;
+};
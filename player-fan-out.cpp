@@ -0,0 +1,186 @@
+#include "player-fan-out.hpp"
+
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static unsigned lowestBit(uint64_t bits)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+template <typename Fn>
+size_t PlayerFanOut::forEach(IPlayer* const* players, size_t count, Fn fn) const
+{
+	size_t applied = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (players[i] != nullptr)
+		{
+			fn(*players[i]);
+			applied++;
+		}
+	}
+	return applied;
+}
+
+template <typename Fn>
+size_t PlayerFanOut::forEach(const uint64_t* ids, size_t words, Fn fn) const
+{
+	if (players_ == nullptr)
+	{
+		return 0;
+	}
+
+	// IDs beyond the pool cannot resolve to a player
+	words = std::min(words, static_cast<size_t>((PLAYER_POOL_SIZE + 63) / 64));
+
+	size_t applied = 0;
+	for (size_t word = 0; word < words; word++)
+	{
+		for (uint64_t bits = ids[word]; bits != 0; bits &= bits - 1)
+		{
+			IPlayer* player = players_->get(static_cast<int>(word * 64 + lowestBit(bits)));
+			if (player != nullptr)
+			{
+				fn(*player);
+				applied++;
+			}
+		}
+	}
+	return applied;
+}
+
+void PlayerFanOut::attach(ICore* core, TextDedupeCache& textDedupeCache)
+{
+	players_ = &core->getPlayers();
+	textDedupeCache_ = &textDedupeCache;
+}
+
+void PlayerFanOut::detach()
+{
+	players_ = nullptr;
+	textDedupeCache_ = nullptr;
+}
+
+size_t PlayerFanOut::showTextDraw(ITextDraw& textDraw, IPlayer* const* players, size_t count)
+{
+	return forEach(players, count, [&](IPlayer& player) {
+		textDedupeCache_->invalidate(textDraw, player);
+		textDraw.showForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::showTextDrawForIds(ITextDraw& textDraw, const uint64_t* ids, size_t words)
+{
+	return forEach(ids, words, [&](IPlayer& player) {
+		textDedupeCache_->invalidate(textDraw, player);
+		textDraw.showForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::hideTextDraw(ITextDraw& textDraw, IPlayer* const* players, size_t count)
+{
+	return forEach(players, count, [&](IPlayer& player) {
+		textDraw.hideForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::hideTextDrawForIds(ITextDraw& textDraw, const uint64_t* ids, size_t words)
+{
+	return forEach(ids, words, [&](IPlayer& player) {
+		textDraw.hideForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::showGangZone(IBaseGangZone& gangZone, IPlayer* const* players, size_t count, const Colour& colour)
+{
+	return forEach(players, count, [&](IPlayer& player) {
+		gangZone.showForPlayer(player, colour);
+	});
+}
+
+size_t PlayerFanOut::showGangZoneForIds(IBaseGangZone& gangZone, const uint64_t* ids, size_t words, const Colour& colour)
+{
+	return forEach(ids, words, [&](IPlayer& player) {
+		gangZone.showForPlayer(player, colour);
+	});
+}
+
+size_t PlayerFanOut::hideGangZone(IBaseGangZone& gangZone, IPlayer* const* players, size_t count)
+{
+	return forEach(players, count, [&](IPlayer& player) {
+		gangZone.hideForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::hideGangZoneForIds(IBaseGangZone& gangZone, const uint64_t* ids, size_t words)
+{
+	return forEach(ids, words, [&](IPlayer& player) {
+		gangZone.hideForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::flashGangZone(IBaseGangZone& gangZone, IPlayer* const* players, size_t count, const Colour& colour)
+{
+	return forEach(players, count, [&](IPlayer& player) {
+		gangZone.flashForPlayer(player, colour);
+	});
+}
+
+size_t PlayerFanOut::flashGangZoneForIds(IBaseGangZone& gangZone, const uint64_t* ids, size_t words, const Colour& colour)
+{
+	return forEach(ids, words, [&](IPlayer& player) {
+		gangZone.flashForPlayer(player, colour);
+	});
+}
+
+size_t PlayerFanOut::stopFlashGangZone(IBaseGangZone& gangZone, IPlayer* const* players, size_t count)
+{
+	return forEach(players, count, [&](IPlayer& player) {
+		gangZone.stopFlashForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::stopFlashGangZoneForIds(IBaseGangZone& gangZone, const uint64_t* ids, size_t words)
+{
+	return forEach(ids, words, [&](IPlayer& player) {
+		gangZone.stopFlashForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::showMenu(IMenu& menu, IPlayer* const* players, size_t count)
+{
+	return forEach(players, count, [&](IPlayer& player) {
+		menu.showForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::showMenuForIds(IMenu& menu, const uint64_t* ids, size_t words)
+{
+	return forEach(ids, words, [&](IPlayer& player) {
+		menu.showForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::hideMenu(IMenu& menu, IPlayer* const* players, size_t count)
+{
+	return forEach(players, count, [&](IPlayer& player) {
+		menu.hideForPlayer(player);
+	});
+}
+
+size_t PlayerFanOut::hideMenuForIds(IMenu& menu, const uint64_t* ids, size_t words)
+{
+	return forEach(ids, words, [&](IPlayer& player) {
+		menu.hideForPlayer(player);
+	});
+}
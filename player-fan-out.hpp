@@ -0,0 +1,58 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/GangZones/gangzones.hpp>
+#include <Server/Components/Menus/menus.hpp>
+#include <Server/Components/TextDraws/textdraws.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "text-dedupe-cache.hpp"
+
+using namespace Impl;
+
+/// applies a show or hide operation of a global textdraw, gang zone or menu to many players in one native loop. players
+/// are passed either as an array of players or as a bitset of player IDs (bit n of word w is player ID w * 64 + n);
+/// unused IDs in a bitset are skipped. all operations return the number of players to which they were applied.
+class PlayerFanOut final
+{
+private:
+	IPlayerPool* players_ = nullptr;
+	TextDedupeCache* textDedupeCache_ = nullptr;
+
+	template <typename Fn>
+	size_t forEach(IPlayer* const* players, size_t count, Fn fn) const;
+
+	template <typename Fn>
+	size_t forEach(const uint64_t* ids, size_t words, Fn fn) const;
+
+public:
+	PlayerFanOut() = default;
+
+	PlayerFanOut(const PlayerFanOut&) = delete;
+	PlayerFanOut& operator=(const PlayerFanOut&) = delete;
+
+	void attach(ICore* core, TextDedupeCache& textDedupeCache);
+
+	void detach();
+
+	size_t showTextDraw(ITextDraw& textDraw, IPlayer* const* players, size_t count);
+	size_t showTextDrawForIds(ITextDraw& textDraw, const uint64_t* ids, size_t words);
+	size_t hideTextDraw(ITextDraw& textDraw, IPlayer* const* players, size_t count);
+	size_t hideTextDrawForIds(ITextDraw& textDraw, const uint64_t* ids, size_t words);
+
+	size_t showGangZone(IBaseGangZone& gangZone, IPlayer* const* players, size_t count, const Colour& colour);
+	size_t showGangZoneForIds(IBaseGangZone& gangZone, const uint64_t* ids, size_t words, const Colour& colour);
+	size_t hideGangZone(IBaseGangZone& gangZone, IPlayer* const* players, size_t count);
+	size_t hideGangZoneForIds(IBaseGangZone& gangZone, const uint64_t* ids, size_t words);
+	size_t flashGangZone(IBaseGangZone& gangZone, IPlayer* const* players, size_t count, const Colour& colour);
+	size_t flashGangZoneForIds(IBaseGangZone& gangZone, const uint64_t* ids, size_t words, const Colour& colour);
+	size_t stopFlashGangZone(IBaseGangZone& gangZone, IPlayer* const* players, size_t count);
+	size_t stopFlashGangZoneForIds(IBaseGangZone& gangZone, const uint64_t* ids, size_t words);
+
+	size_t showMenu(IMenu& menu, IPlayer* const* players, size_t count);
+	size_t showMenuForIds(IMenu& menu, const uint64_t* ids, size_t words);
+	size_t hideMenu(IMenu& menu, IPlayer* const* players, size_t count);
+	size_t hideMenuForIds(IMenu& menu, const uint64_t* ids, size_t words);
+};
@@ -0,0 +1,193 @@
+#include "player-string-table.hpp"
+
+#include <cstring>
+
+/// decodes UTF-8 into UTF-16, replacing invalid sequences with U+FFFD. the output never has more code units than the
+/// input has bytes
+static size_t transcode(const char* input, size_t length, char16_t* output)
+{
+	auto in = reinterpret_cast<const uint8_t*>(input);
+	size_t i = 0;
+	size_t n = 0;
+
+	while (i < length)
+	{
+		const uint8_t lead = in[i];
+		if (lead < 0x80)
+		{
+			output[n++] = lead;
+			i++;
+			continue;
+		}
+
+		size_t count;
+		uint32_t cp;
+		uint32_t min;
+		if ((lead & 0xE0) == 0xC0)
+		{
+			count = 1;
+			cp = lead & 0x1F;
+			min = 0x80;
+		}
+		else if ((lead & 0xF0) == 0xE0)
+		{
+			count = 2;
+			cp = lead & 0x0F;
+			min = 0x800;
+		}
+		else if ((lead & 0xF8) == 0xF0)
+		{
+			count = 3;
+			cp = lead & 0x07;
+			min = 0x10000;
+		}
+		else
+		{
+			output[n++] = 0xFFFD;
+			i++;
+			continue;
+		}
+
+		size_t j = 1;
+		for (; j <= count && i + j < length && (in[i + j] & 0xC0) == 0x80; j++)
+		{
+			cp = (cp << 6) | (in[i + j] & 0x3F);
+		}
+
+		if (j <= count || cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+		{
+			output[n++] = 0xFFFD;
+			i += j;
+			continue;
+		}
+
+		if (cp >= 0x10000)
+		{
+			cp -= 0x10000;
+			output[n++] = static_cast<char16_t>(0xD800 + (cp >> 10));
+			output[n++] = static_cast<char16_t>(0xDC00 + (cp & 0x3FF));
+		}
+		else
+		{
+			output[n++] = static_cast<char16_t>(cp);
+		}
+		i += count + 1;
+	}
+
+	return n;
+}
+
+PlayerStringTable::PlayerStringTable()
+{
+	for (size_t field = 0; field < PlayerStringField_Count; field++)
+	{
+		for (size_t player = 0; player < PLAYER_POOL_SIZE; player++)
+		{
+			PlayerString& entry = entries_[field][player];
+			entry.utf8 = utf8_[field][player];
+			entry.utf16 = utf16_[field][player];
+		}
+	}
+}
+
+void PlayerStringTable::attach(ICore* core)
+{
+	core_ = core;
+	core_->getPlayers().getPlayerConnectDispatcher().addEventHandler(this);
+	core_->getPlayers().getPlayerConnectDispatcher().addEventHandler(&disconnectHandler_, EventPriority_Lowest);
+	core_->getPlayers().getPlayerChangeDispatcher().addEventHandler(this);
+}
+
+void PlayerStringTable::detach()
+{
+	if (core_ != nullptr)
+	{
+		core_->getPlayers().getPlayerConnectDispatcher().removeEventHandler(this);
+		core_->getPlayers().getPlayerConnectDispatcher().removeEventHandler(&disconnectHandler_);
+		core_->getPlayers().getPlayerChangeDispatcher().removeEventHandler(this);
+		core_ = nullptr;
+	}
+}
+
+const PlayerString* PlayerStringTable::getEntries(PlayerStringField field) const
+{
+	if (field >= PlayerStringField_Count)
+	{
+		return nullptr;
+	}
+	return entries_[field];
+}
+
+size_t PlayerStringTable::getEntryCount() const
+{
+	return PLAYER_POOL_SIZE;
+}
+
+const PlayerString* PlayerStringTable::get(int player, PlayerStringField field) const
+{
+	if (field >= PlayerStringField_Count || player < 0 || static_cast<size_t>(player) >= PLAYER_POOL_SIZE)
+	{
+		return nullptr;
+	}
+	return &entries_[field][player];
+}
+
+void PlayerStringTable::set(PlayerStringField field, int player, StringView value)
+{
+	if (player < 0 || static_cast<size_t>(player) >= PLAYER_POOL_SIZE)
+	{
+		return;
+	}
+
+	size_t length = value.length();
+	if (length >= CAPACITY)
+	{
+		// truncate at the start of the character which does not fit
+		length = CAPACITY - 1;
+		while (length > 0 && (static_cast<uint8_t>(value.data()[length]) & 0xC0) == 0x80)
+		{
+			length--;
+		}
+	}
+
+	char* utf8 = utf8_[field][player];
+	char16_t* utf16 = utf16_[field][player];
+
+	memcpy(utf8, value.data(), length);
+	utf8[length] = '\0';
+
+	const size_t utf16_length = transcode(utf8, length, utf16);
+	utf16[utf16_length] = u'\0';
+
+	PlayerString& entry = entries_[field][player];
+	entry.utf8Length = static_cast<uint32_t>(length);
+	entry.utf16Length = static_cast<uint32_t>(utf16_length);
+	entry.version++;
+}
+
+void PlayerStringTable::clear(int player)
+{
+	for (size_t field = 0; field < PlayerStringField_Count; field++)
+	{
+		set(static_cast<PlayerStringField>(field), player, StringView());
+	}
+}
+
+void PlayerStringTable::onPlayerConnect(IPlayer& player)
+{
+	const int id = player.getID();
+
+	// the address stays empty if it cannot be formatted
+	PeerAddress::AddressString ip;
+	PeerAddress::ToString(player.getNetworkData().networkID.address, ip);
+
+	set(PlayerStringField_Name, id, player.getName());
+	set(PlayerStringField_Serial, id, player.getSerial());
+	set(PlayerStringField_Ip, id, StringView(ip.data(), ip.length()));
+	set(PlayerStringField_ClientVersion, id, player.getClientVersionName());
+}
+
+void PlayerStringTable::onPlayerNameChange(IPlayer& player, StringView oldName)
+{
+	set(PlayerStringField_Name, player.getID(), player.getName());
+}
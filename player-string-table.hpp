@@ -0,0 +1,91 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <cstdint>
+
+using namespace Impl;
+
+enum PlayerStringField : uint8_t
+{
+	PlayerStringField_Name,
+	PlayerStringField_Serial,
+	PlayerStringField_Ip,
+	PlayerStringField_ClientVersion,
+	PlayerStringField_Count,
+};
+
+/// string of a player in UTF-8 and UTF-16. both forms are null terminated and point into memory which is stable for the
+/// lifetime of the component. layout is shared with the managed PlayerString struct
+struct PlayerString
+{
+	const char* utf8;
+	const char16_t* utf16;
+	uint32_t utf8Length;
+	uint32_t utf16Length;
+	/// incremented every time the string changes, including when the strings of a disconnected player are cleared
+	/// after the disconnect handlers ran
+	uint32_t version;
+	uint32_t reserved;
+};
+
+/// interned strings of the connected players. the strings are copied and transcoded once when a player connects or
+/// changes their name, so managed code can wrap them without calling into the player or decoding them again. every
+/// field has a table of entries indexed by player ID; the entries of disconnected players are empty. the entries are
+/// only cleared after every other disconnect handler, including the managed ones, so they can still be read there.
+class PlayerStringTable final
+	: public PlayerConnectEventHandler
+	, public PlayerChangeEventHandler
+{
+private:
+	/// capacity of a string including the null terminator. longer strings are truncated at a character boundary
+	static constexpr size_t CAPACITY = 64;
+
+	/// clears the strings of a disconnecting player at the lowest priority
+	struct DisconnectHandler final : PlayerConnectEventHandler
+	{
+		PlayerStringTable& table;
+
+		explicit DisconnectHandler(PlayerStringTable& table)
+			: table(table)
+		{
+		}
+
+		void onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason) override
+		{
+			table.clear(player.getID());
+		}
+	};
+
+	ICore* core_ = nullptr;
+	DisconnectHandler disconnectHandler_ { *this };
+	PlayerString entries_[PlayerStringField_Count][PLAYER_POOL_SIZE] {};
+	char utf8_[PlayerStringField_Count][PLAYER_POOL_SIZE][CAPACITY] {};
+	char16_t utf16_[PlayerStringField_Count][PLAYER_POOL_SIZE][CAPACITY] {};
+
+	void set(PlayerStringField field, int player, StringView value);
+
+	void clear(int player);
+
+public:
+	PlayerStringTable();
+
+	PlayerStringTable(const PlayerStringTable&) = delete;
+	PlayerStringTable& operator=(const PlayerStringTable&) = delete;
+
+	void attach(ICore* core);
+
+	void detach();
+
+	/// entries of the field indexed by player ID or null if the field is invalid
+	const PlayerString* getEntries(PlayerStringField field) const;
+
+	size_t getEntryCount() const;
+
+	/// entry of the field of the player or null if the field or ID is invalid
+	const PlayerString* get(int player, PlayerStringField field) const;
+
+	void onPlayerConnect(IPlayer& player) override;
+
+	void onPlayerNameChange(IPlayer& player, StringView oldName) override;
+};
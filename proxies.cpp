@@ -1,6 +1,7 @@
 #include <sdk.hpp>
 #include <stdbool.h>
 #include <stdbool.h>
+#include <new>
 #include <Server/Components/Actors/actors.hpp>
 #include <Server/Components/Checkpoints/checkpoints.hpp>
 #include <Server/Components/Classes/classes.hpp>
@@ -19,6 +20,7 @@
 #include <Server/Components/Vehicles/vehicles.hpp>
 
 #include "dotnet/coreclr_delegates.h"
+#include "sampsharp-component.hpp"
 
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
@@ -97,6 +99,22 @@
 /// proxy function macro for an overload. output is similar to PROXY macro, except the function name is post-fixed by overload argument
 #define PROXY_OVERLOAD(type_subject, type_return, method, overload, ...) __PROXY_IMPL(type_subject, type_return, method, type_subject##_##method##overload, __VA_ARGS__)
 
+#define __PROXY_OUT_IMPL(type_subject, type_return, method, proxy_name, ...) \
+    extern "C" SDK_EXPORT void __CDECL \
+    proxy_name(type_subject * subject __VA_OPT__(, _EXPAND_PARAM(,,__VA_ARGS__)), type_return * result) \
+    { \
+        new (result) type_return(subject -> method ( \
+            __VA_OPT__(_EXPAND_ARG(,__VA_ARGS__)) \
+        )); \
+    }
+
+/// proxy function macro for methods returning large structs. in addition to the PROXY function, a variant is exported
+/// which constructs the result in memory provided by the caller. e.g. PROXY_OUT(subj, T, foo, bool) -> void
+/// subj_foo_out(subj * x, bool _1, T * result) { new (result) T(x->foo(_1)); }
+#define PROXY_OUT(type_subject, type_return, method, ...) \
+    PROXY(type_subject, type_return, method, __VA_ARGS__); \
+    __PROXY_OUT_IMPL(type_subject, type_return, method, type_subject##_##method##_out, __VA_ARGS__)
+
 #define __PROXY_EVENT_DISPATCHER_IMPL(handler_name, handler_type) \
     __PROXY_IMPL(IEventDispatcher<handler_type>, bool, addEventHandler, IEventDispatcher_##handler_name##_addEventHandler, handler_type *, event_order_t); \
     __PROXY_IMPL(IEventDispatcher<handler_type>, bool, removeEventHandler, IEventDispatcher_##handler_name##_removeEventHandler, handler_type *); \
@@ -124,9 +142,12 @@
 	PROXY(type_subject, IIndexedEventDispatcher<type_handler>&, method); \
 	__PROXY_INDEXED_EVENT_DISPATCHER_IMPL(type_handler, type_handler)
 
-/// start of event handler proxy class 
+/// start of event handler proxy class. instances are registered as targets of replayed bridge recordings
 #define PROXY_EVENT_HANDLER_BEGIN(handler_type) \
-    class handler_type##Impl final : handler_type {
+    class handler_type##Impl final : handler_type { \
+    using self_type = handler_type##Impl; \
+    static constexpr const char* bridge_handler_ = #handler_type; \
+    BridgeTarget bridge_target_ { this, bridge_handler_ };
 
 /// end of event handler proxy class + functions for creating/destroying proxy
 #define PROXY_EVENT_HANDLER_END(handler_type, ...) \
@@ -143,14 +164,48 @@
         delete handler; \
     }
 
-/// event handler function in event handler proxy class
+/// event handler function in event handler proxy class. the event is passed to the bridge recorder while recording
 #define PROXY_EVENT_HANDLER_EVENT(type_return, name, ...) \
     private: \
     typedef type_return(CORECLR_DELEGATE_CALLTYPE * name##_fn)(_EXPAND_PARAM(, , __VA_ARGS__)); \
     void** name##_ = nullptr; \
+    static bool name##_replay_(BridgeReader& reader, void* const* targets, size_t count) \
+    { \
+        return BridgeInvoker<name##_fn>::replay(reader, targets, count, [](void* target) { return (name##_fn)static_cast<self_type*>(target)->name##_; }); \
+    } \
+    static inline const BridgeEvent name##_event_ { bridge_handler_, #name, &name##_replay_ }; \
     public: \
     type_return name(_EXPAND_PARAM(, , __VA_ARGS__)) override \
     { \
+        if (BridgeRecorder* recorder = BridgeRecorder::getActive()) \
+        { \
+            recorder->record(name##_event_, _EXPAND_ARG(,__VA_ARGS__)); \
+        } \
+        return ((name##_fn)name##_)(_EXPAND_ARG(,__VA_ARGS__)); \
+    }
+
+/// event handler function in event handler proxy class for an event which is rate limited. events dropped by the rate
+/// limiter are neither recorded nor passed to the managed handler. player is the numbered parameter of the player
+#define PROXY_EVENT_HANDLER_LIMITED_EVENT(type_return, name, event, player, ...) \
+    private: \
+    typedef type_return(CORECLR_DELEGATE_CALLTYPE * name##_fn)(_EXPAND_PARAM(, , __VA_ARGS__)); \
+    void** name##_ = nullptr; \
+    static bool name##_replay_(BridgeReader& reader, void* const* targets, size_t count) \
+    { \
+        return BridgeInvoker<name##_fn>::replay(reader, targets, count, [](void* target) { return (name##_fn)static_cast<self_type*>(target)->name##_; }); \
+    } \
+    static inline const BridgeEvent name##_event_ { bridge_handler_, #name, &name##_replay_ }; \
+    public: \
+    type_return name(_EXPAND_PARAM(, , __VA_ARGS__)) override \
+    { \
+        if (RateLimiter* limiter = RateLimiter::getActive(); limiter != nullptr && limiter->isLimited(event, player)) \
+        { \
+            return type_return(); \
+        } \
+        if (BridgeRecorder* recorder = BridgeRecorder::getActive()) \
+        { \
+            recorder->record(name##_event_, _EXPAND_ARG(,__VA_ARGS__)); \
+        } \
         return ((name##_fn)name##_)(_EXPAND_ARG(,__VA_ARGS__)); \
     }
 
@@ -259,7 +314,7 @@ PROXY_EVENT_HANDLER_BEGIN(PlayerModelsEventHandler)
 PROXY_EVENT_HANDLER_END(PlayerModelsEventHandler, onPlayerFinishedDownloading, onPlayerRequestDownload)
 
 // include/Server/Components/Databases
-// @skip
+// @skip: managed code uses the DatabaseExecutor
 
 // include/Server/Components/Dialogs
 PROXY(IPlayerDialogData, void, hide, IPlayer&);
@@ -269,7 +324,7 @@ PROXY(IPlayerDialogData, int, getActiveID)
 
 PROXY_EVENT_DISPATCHER(IDialogsComponent, PlayerDialogEventHandler, getEventDispatcher);
 PROXY_EVENT_HANDLER_BEGIN(PlayerDialogEventHandler)
-    PROXY_EVENT_HANDLER_EVENT(void, onDialogResponse, IPlayer&, int, DialogResponse, int, StringView)
+    PROXY_EVENT_HANDLER_LIMITED_EVENT(void, onDialogResponse, RateLimitedEvent_DialogResponse, _5, IPlayer&, int, DialogResponse, int, StringView)
 PROXY_EVENT_HANDLER_END(PlayerDialogEventHandler, onDialogResponse)
 
 // include/Server/Components/Fixes
@@ -455,9 +510,21 @@ PROXY(IPlayerRecordingData, void, start, PlayerRecordingType, StringView);
 PROXY(IPlayerRecordingData, void, stop);
 
 // include/Server/Components/TextDraws
+// text updates pass through the text dedupe cache; showing or changing a textdraw invalidates the cached text
+static TextDedupeCache& getTextDedupeCache()
+{
+	return SampSharpComponent::getInstance()->getTextDedupeCache();
+}
+
 PROXY(ITextDrawBase, Vector2, getPosition);
 PROXY(ITextDrawBase, ITextDrawBase&, setPosition, Vector2);
-PROXY(ITextDrawBase, void, setText, StringView);
+
+extern "C" SDK_EXPORT void __CDECL ITextDrawBase_setText(ITextDrawBase* subject, StringView text)
+{
+	getTextDedupeCache().invalidate(*subject);
+	subject->setText(text);
+}
+
 PROXY(ITextDrawBase, StringView, getText);
 PROXY(ITextDrawBase, ITextDrawBase&, setLetterSize, Vector2);
 PROXY(ITextDrawBase, Vector2, getLetterSize);
@@ -491,12 +558,29 @@ PROXY(ITextDrawBase, ITextDrawBase&, setPreviewVehicleColour, int, int);
 PROXY(ITextDrawBase, IntPair, getPreviewVehicleColour);
 PROXY(ITextDrawBase, ITextDrawBase&, setPreviewZoom, float);
 PROXY(ITextDrawBase, float, getPreviewZoom);
-PROXY(ITextDrawBase, void, restream);
 
-PROXY(ITextDraw, void, showForPlayer, IPlayer&);
+extern "C" SDK_EXPORT void __CDECL ITextDrawBase_restream(ITextDrawBase* subject)
+{
+	getTextDedupeCache().invalidate(*subject);
+	subject->restream();
+}
+
+extern "C" SDK_EXPORT void __CDECL ITextDraw_showForPlayer(ITextDraw* subject, IPlayer& player)
+{
+	getTextDedupeCache().invalidate(*subject, player);
+	subject->showForPlayer(player);
+}
+
 PROXY(ITextDraw, void, hideForPlayer, IPlayer&);
 PROXY(ITextDraw, bool, isShownForPlayer, const IPlayer&);
-PROXY(ITextDraw, void, setTextForPlayer, IPlayer&, StringView);
+
+extern "C" SDK_EXPORT void __CDECL ITextDraw_setTextForPlayer(ITextDraw* subject, IPlayer& player, StringView text)
+{
+	if (getTextDedupeCache().shouldSend(*subject, player, text))
+	{
+		subject->setTextForPlayer(player, text);
+	}
+}
 
 PROXY(IPlayerTextDraw, void, show);
 PROXY(IPlayerTextDraw, void, hide);
@@ -506,7 +590,7 @@ PROXY(ITextDrawsComponent, ITextDraw*, create, Vector2, StringView);
 PROXY_OVERLOAD(ITextDrawsComponent, ITextDraw*, create, _model, Vector2, int);
 PROXY_EVENT_DISPATCHER(ITextDrawsComponent, TextDrawEventHandler, getEventDispatcher);
 PROXY_EVENT_HANDLER_BEGIN(TextDrawEventHandler)
-    PROXY_EVENT_HANDLER_EVENT(void, onPlayerClickTextDraw, IPlayer&, ITextDraw&)
+    PROXY_EVENT_HANDLER_LIMITED_EVENT(void, onPlayerClickTextDraw, RateLimitedEvent_ClickTextDraw, _2, IPlayer&, ITextDraw&)
     PROXY_EVENT_HANDLER_EVENT(void, onPlayerClickPlayerTextDraw, IPlayer&, IPlayerTextDraw&)
     PROXY_EVENT_HANDLER_EVENT(bool, onPlayerCancelTextDrawSelection, IPlayer&)
     PROXY_EVENT_HANDLER_EVENT(bool, onPlayerCancelPlayerTextDrawSelection, IPlayer&)
@@ -519,7 +603,14 @@ PROXY(IPlayerTextDrawData, IPlayerTextDraw*, create, Vector2, StringView);
 PROXY_OVERLOAD(IPlayerTextDrawData, IPlayerTextDraw*, create, _model, Vector2, int);
 
 // include/Server/Components/TextLabels
-PROXY(ITextLabelBase, void, setText, StringView);
+extern "C" SDK_EXPORT void __CDECL ITextLabelBase_setText(ITextLabelBase* subject, StringView text)
+{
+	if (getTextDedupeCache().shouldSet(*subject, text))
+	{
+		subject->setText(text);
+	}
+}
+
 PROXY(ITextLabelBase, StringView, getText);
 PROXY(ITextLabelBase, void, setColour, Colour);
 PROXY(ITextLabelBase, Colour, getColour);
@@ -558,7 +649,7 @@ PROXY_OVERLOAD(IPlayerTextLabelData, IPlayerTextLabel*, create, _vehicle, String
 // include/Server/Components/Vehicles
 
 PROXY(IVehicle, void, setSpawnData, VehicleSpawnData&);
-PROXY(IVehicle, VehicleSpawnData, getSpawnData);
+PROXY_OUT(IVehicle, VehicleSpawnData, getSpawnData);
 PROXY(IVehicle, bool, isStreamedInForPlayer, IPlayer&);
 PROXY(IVehicle, void, streamInForPlayer, IPlayer&);
 PROXY(IVehicle, void, streamOutForPlayer, IPlayer&);
@@ -664,18 +755,49 @@ PROXY(IConfig, size_t, getStringsCount, StringView);
 PROXY(IConfig, ConfigOptionType, getType, StringView);
 PROXY(IConfig, size_t, getBansCount);
 PROXY(IConfig, const BanEntry&, getBan, size_t);
-PROXY(IConfig, void, addBan, BanEntry&);
-PROXY_OVERLOAD(IConfig, void, removeBan, _index, size_t);
-PROXY(IConfig, void, removeBan, BanEntry&);
 PROXY(IConfig, void, writeBans);
-PROXY(IConfig, void, reloadBans);
-PROXY(IConfig, void, clearBans);
 PROXY(IConfig, bool, isBanned, BanEntry&);
-PROXY(IConfig, BoolStringPair, getNameFromAlias, StringView);
+PROXY_OUT(IConfig, BoolStringPair, getNameFromAlias, StringView);
 PROXY(IConfig, void, enumOptions, OptionEnumeratorCallback&);
 PROXY(IConfig, bool*, getBool, StringView);
 
-// @skip: ILogger due to varargs; need to write a wrapper w/a vararg
+// changes of the bans are applied to the ban index
+static BanIndex& getBanIndex()
+{
+	return SampSharpComponent::getInstance()->getBanIndex();
+}
+
+extern "C" SDK_EXPORT void __CDECL IConfig_addBan(IConfig* subject, BanEntry& entry)
+{
+	subject->addBan(entry);
+	getBanIndex().added();
+}
+
+extern "C" SDK_EXPORT void __CDECL IConfig_removeBan_index(IConfig* subject, size_t index)
+{
+	subject->removeBan(index);
+	getBanIndex().rebuild();
+}
+
+extern "C" SDK_EXPORT void __CDECL IConfig_removeBan(IConfig* subject, BanEntry& entry)
+{
+	subject->removeBan(entry);
+	getBanIndex().rebuild();
+}
+
+extern "C" SDK_EXPORT void __CDECL IConfig_reloadBans(IConfig* subject)
+{
+	subject->reloadBans();
+	getBanIndex().rebuild();
+}
+
+extern "C" SDK_EXPORT void __CDECL IConfig_clearBans(IConfig* subject)
+{
+	subject->clearBans();
+	getBanIndex().rebuild();
+}
+
+// @skip: ILogger due to varargs; need to write a wrapper w/a vararg. managed code logs through the AsyncLogger
 
 PROXY(ICore, SemanticVersion, getVersion);
 PROXY(ICore, int, getNetworkBitStreamVersion);
@@ -749,7 +871,7 @@ PROXY(INetwork, bool, sendPacket, IPlayer&, Span<uint8_t>, int, bool);
 PROXY(INetwork, bool, broadcastPacket, Span<uint8_t>, int, const IPlayer* , bool);
 PROXY(INetwork, bool, sendRPC, IPlayer&, int, Span<uint8_t>, int, bool);
 PROXY(INetwork, bool, broadcastRPC, int, Span<uint8_t>, int, IPlayer*, bool);
-PROXY(INetwork, NetworkStats, getStatistics, IPlayer*);
+PROXY_OUT(INetwork, NetworkStats, getStatistics, IPlayer*);
 PROXY(INetwork, unsigned, getPing, IPlayer&);
 PROXY(INetwork, void, disconnect, IPlayer&);
 PROXY(INetwork, void, ban, BanEntry&, Milliseconds);
@@ -766,7 +888,7 @@ PROXY(INetworkQueryExtension, bool, isValidRule, StringView)
 PROXY(IPlayer, void, kick);
 PROXY(IPlayer, void, ban, StringView);
 PROXY(IPlayer, bool, isBot);
-PROXY(IPlayer, PeerNetworkData,  getNetworkData);
+PROXY_OUT(IPlayer, PeerNetworkData, getNetworkData);
 PROXY(IPlayer, unsigned, getPing);
 PROXY(IPlayer, bool, sendPacket, Span<uint8_t>, int, bool);
 PROXY(IPlayer, bool, sendRPC, int, Span<uint8_t>, int, bool);
@@ -792,7 +914,7 @@ PROXY(IPlayer, StringView, getSerial);
 PROXY(IPlayer, void, giveWeapon, WeaponSlotData);
 PROXY(IPlayer, void, removeWeapon, uint8_t);
 PROXY(IPlayer, void, setWeaponAmmo, WeaponSlotData);
-PROXY(IPlayer, WeaponSlots, getWeapons);
+PROXY_OUT(IPlayer, WeaponSlots, getWeapons);
 PROXY(IPlayer, WeaponSlotData, getWeaponSlot, int);
 PROXY(IPlayer, void, resetWeapons);
 PROXY(IPlayer, void, setArmedWeapon, uint32_t);
@@ -849,7 +971,7 @@ PROXY(IPlayer, void, setWorldTime, Hours);
 PROXY(IPlayer, void, applyAnimation, const AnimationData&, PlayerAnimationSyncType);
 PROXY(IPlayer, void, clearAnimations, PlayerAnimationSyncType);
 PROXY(IPlayer, PlayerAnimationData, getAnimationData);
-PROXY(IPlayer, PlayerSurfingData, getSurfingData);
+PROXY_OUT(IPlayer, PlayerSurfingData, getSurfingData);
 PROXY(IPlayer, void, streamInForPlayer, IPlayer&);
 PROXY(IPlayer, bool, isStreamedInForPlayer, const IPlayer&);
 PROXY(IPlayer, void, streamOutForPlayer, IPlayer&);
@@ -882,7 +1004,7 @@ PROXY(IPlayer, void, setInterior, unsigned);
 PROXY(IPlayer, unsigned, getInterior);
 PROXY(IPlayer, PlayerKeyData,  getKeyData);
 PROXY(IPlayer, const SkillsArray&, getSkillLevels);
-PROXY(IPlayer, PlayerAimData,  getAimData);
+PROXY_OUT(IPlayer, PlayerAimData, getAimData);
 PROXY(IPlayer, PlayerBulletData,  getBulletData);
 PROXY(IPlayer, void, useCameraTargeting, bool);
 PROXY(IPlayer, bool, hasCameraTargeting);
@@ -937,7 +1059,7 @@ PROXY_EVENT_HANDLER_END(PlayerSpawnEventHandler, onPlayerRequestSpawn, onPlayerS
 
 PROXY_EVENT_DISPATCHER(IPlayerPool, PlayerConnectEventHandler, getPlayerConnectDispatcher);
 PROXY_EVENT_HANDLER_BEGIN(PlayerConnectEventHandler)
-	PROXY_EVENT_HANDLER_EVENT(void, onIncomingConnection, IPlayer&, StringView, unsigned short)
+	PROXY_EVENT_HANDLER_LIMITED_EVENT(void, onIncomingConnection, RateLimitedEvent_IncomingConnection, _3, IPlayer&, StringView, unsigned short)
 	PROXY_EVENT_HANDLER_EVENT(void, onPlayerConnect, IPlayer&)
 	PROXY_EVENT_HANDLER_EVENT(void, onPlayerDisconnect, IPlayer&, PeerDisconnectReason)
 	PROXY_EVENT_HANDLER_EVENT(void, onPlayerClientInit, IPlayer&)
@@ -951,8 +1073,8 @@ PROXY_EVENT_HANDLER_END(PlayerStreamEventHandler, onPlayerStreamIn, onPlayerStre
 
 PROXY_EVENT_DISPATCHER(IPlayerPool, PlayerTextEventHandler, getPlayerTextDispatcher);
 PROXY_EVENT_HANDLER_BEGIN(PlayerTextEventHandler)
-	PROXY_EVENT_HANDLER_EVENT(bool, onPlayerText, IPlayer&, StringView)
-	PROXY_EVENT_HANDLER_EVENT(bool, onPlayerCommandText, IPlayer&, StringView)
+	PROXY_EVENT_HANDLER_LIMITED_EVENT(bool, onPlayerText, RateLimitedEvent_Text, _2, IPlayer&, StringView)
+	PROXY_EVENT_HANDLER_LIMITED_EVENT(bool, onPlayerCommandText, RateLimitedEvent_CommandText, _2, IPlayer&, StringView)
 PROXY_EVENT_HANDLER_END(PlayerTextEventHandler, onPlayerText ,onPlayerCommandText)
 
 PROXY_EVENT_DISPATCHER(IPlayerPool, PlayerShotEventHandler, getPlayerShotDispatcher);
@@ -982,7 +1104,7 @@ PROXY_EVENT_HANDLER_END(PlayerDamageEventHandler, onPlayerDeath, onPlayerTakeDam
 
 PROXY_EVENT_DISPATCHER(IPlayerPool, PlayerClickEventHandler, getPlayerClickDispatcher);
 PROXY_EVENT_HANDLER_BEGIN(PlayerClickEventHandler)
-	PROXY_EVENT_HANDLER_EVENT(void, onPlayerClickMap, IPlayer&, Vector3)
+	PROXY_EVENT_HANDLER_LIMITED_EVENT(void, onPlayerClickMap, RateLimitedEvent_ClickMap, _2, IPlayer&, Vector3)
 	PROXY_EVENT_HANDLER_EVENT(void, onPlayerClickPlayer, IPlayer&, IPlayer&, PlayerClickSource)
 PROXY_EVENT_HANDLER_END(PlayerClickEventHandler, onPlayerClickMap, onPlayerClickPlayer)
 
@@ -998,6 +1120,225 @@ PROXY_EVENT_HANDLER_END(PlayerUpdateEventHandler, onPlayerUpdate)
 
 PROXY_EVENT_DISPATCHER_TYPE(IPlayerPool, PoolEventHandler<IPlayer>, PoolEventHandler, getPoolEventDispatcher);
 
+// sampsharp
+PROXY(ISampSharpComponent, TickQueue&, getTickQueue);
+PROXY(ISampSharpComponent, EntityTable*, getEntityTable, EntityTableType);
+PROXY(ISampSharpComponent, PlayerColumnStore&, getPlayerColumnStore);
+PROXY(ISampSharpComponent, SyncValidator&, getSyncValidator);
+PROXY(ISampSharpComponent, HitValidator&, getHitValidator);
+PROXY(ISampSharpComponent, BridgeRecorder&, getBridgeRecorder);
+PROXY(ISampSharpComponent, BridgeReplayer&, getBridgeReplayer);
+PROXY(ISampSharpComponent, CommandRouter&, getCommandRouter);
+PROXY(ISampSharpComponent, TextDrawStyler&, getTextDrawStyler);
+PROXY(ISampSharpComponent, TextDedupeCache&, getTextDedupeCache);
+PROXY(ISampSharpComponent, WorldLoader&, getWorldLoader);
+PROXY(ISampSharpComponent, PlayerFanOut&, getPlayerFanOut);
+PROXY(ISampSharpComponent, AsyncLogger&, getAsyncLogger);
+PROXY(ISampSharpComponent, DatabaseExecutor*, getDatabaseExecutor);
+PROXY(ISampSharpComponent, TickArena&, getTickArena);
+PROXY(ISampSharpComponent, PlayerStringTable&, getPlayerStringTable);
+PROXY(ISampSharpComponent, BitStreamCodec&, getBitStreamCodec);
+PROXY(ISampSharpComponent, ChangeFeed&, getChangeFeed);
+PROXY(ISampSharpComponent, StreamMatrix&, getStreamMatrix);
+PROXY(ISampSharpComponent, TickPacer&, getTickPacer);
+PROXY(ISampSharpComponent, GcCoordinator&, getGcCoordinator);
+PROXY(ISampSharpComponent, WorldSnapshot&, getWorldSnapshot);
+PROXY(ISampSharpComponent, ObjectAnimator&, getObjectAnimator);
+PROXY(ISampSharpComponent, RateLimiter&, getRateLimiter);
+PROXY(ISampSharpComponent, BanIndex&, getBanIndex);
+
+PROXY(TickQueue, bool, enqueue, tick_queue_fn, void*);
+PROXY(TickQueue, size_t, depth);
+PROXY(TickQueue, size_t, capacity);
+PROXY(TickQueue, void, getStats, TickQueueStats&);
+PROXY(TickQueue, void, resetStats);
+
+PROXY(EntityTable, EntityTableSlot*, slots);
+PROXY(EntityTable, int32_t*, ids);
+PROXY(EntityTable, size_t, capacity);
+PROXY(EntityTable, size_t, count);
+PROXY(EntityTable, void*, get, int);
+PROXY(EntityTable, uint64_t, getHandle, int);
+PROXY(EntityTable, void*, resolve, uint64_t);
+
+PROXY(PlayerColumnStore, int, addColumn, size_t);
+PROXY(PlayerColumnStore, void*, getColumn, int);
+PROXY(PlayerColumnStore, size_t, getElementSize, int);
+PROXY(PlayerColumnStore, size_t, getColumnCount);
+PROXY(PlayerColumnStore, size_t, getRowCount);
+PROXY(PlayerColumnStore, void, clearRow, int);
+
+PROXY(IPlayerColumnData, int, getRow);
+PROXY(IPlayerColumnData, void*, getField, int);
+
+PROXY(SyncValidator, void, setConfig, SyncValidatorConfig&);
+PROXY(SyncValidator, void, getConfig, SyncValidatorConfig&);
+PROXY(SyncValidator, void, setMaxVehicleSpeed, int, float);
+PROXY(SyncValidator, float, getMaxVehicleSpeed, int);
+PROXY(SyncValidator, void, setViolationHandler, sync_violation_fn);
+PROXY(SyncValidator, void, setHealth, IPlayer&, float);
+PROXY(SyncValidator, void, setArmour, IPlayer&, float);
+PROXY(SyncValidator, void, setPosition, IPlayer&, Vector3);
+PROXY(SyncValidator, void, giveWeapon, IPlayer&, WeaponSlotData);
+PROXY(SyncValidator, void, setWeaponAmmo, IPlayer&, WeaponSlotData);
+PROXY(SyncValidator, void, resetPlayer, IPlayer&);
+PROXY(SyncValidator, uint64_t, getViolationCount);
+PROXY(SyncValidator, uint64_t, getRejectedCount);
+
+PROXY(HitValidator, void, setConfig, HitValidatorConfig&);
+PROXY(HitValidator, void, getConfig, HitValidatorConfig&);
+PROXY(HitValidator, bool, rewind, IPlayer&, uint32_t, Vector3&, GTAQuat&);
+PROXY(HitValidator, bool, validate, IPlayer&, IPlayer&, PlayerBulletData&, HitVerdict&);
+PROXY(HitValidator, bool, getLastVerdict, IPlayer&, HitVerdict&);
+PROXY(HitValidator, void, clearHistory, IPlayer&);
+PROXY(HitValidator, uint64_t, getRejectedCount);
+
+PROXY(BridgeRecorder, bool, start, StringView);
+PROXY(BridgeRecorder, void, stop);
+PROXY(BridgeRecorder, bool, isRecording);
+PROXY(BridgeRecorder, void, getStats, BridgeRecorderStats&);
+
+PROXY(BridgeReplayer, bool, start, StringView, BridgeReplayMode);
+PROXY(BridgeReplayer, void, stop);
+PROXY(BridgeReplayer, bool, isReplaying);
+PROXY(BridgeReplayer, void, getStats, BridgeReplayStats&);
+
+PROXY(CommandRouter, void, setHandler, command_handler_fn);
+PROXY(CommandRouter, bool, addCommand, StringView, int);
+PROXY(CommandRouter, bool, addAlias, StringView, StringView);
+PROXY(CommandRouter, bool, removeName, StringView);
+PROXY(CommandRouter, void, removeCommand, int);
+PROXY(CommandRouter, void, clear);
+PROXY(CommandRouter, int, find, StringView);
+PROXY(CommandRouter, void, setDefaultReply, StringView, Colour);
+PROXY(CommandRouter, void, getStats, CommandRouterStats&);
+
+PROXY(TextDrawStyler, bool, apply, ITextDrawBase&, const TextDrawAppearance&);
+PROXY(TextDrawStyler, size_t, applyBatch, ITextDrawBase* const*, size_t, const TextDrawAppearance&);
+PROXY(TextDrawStyler, uint64_t, getAppliedCount);
+PROXY(TextDrawStyler, uint64_t, getRestreamedCount);
+
+PROXY(TextDedupeCache, void, setEnabled, bool);
+PROXY(TextDedupeCache, bool, isEnabled);
+PROXY(TextDedupeCache, void, getStats, TextDedupeStats&);
+PROXY(TextDedupeCache, void, resetStats);
+
+PROXY(WorldLoader, bool, load, StringView, WorldLoadResult&);
+PROXY(WorldLoader, size_t, copyIds, WorldEntityType, int*, size_t);
+
+PROXY(PlayerFanOut, size_t, showTextDraw, ITextDraw&, IPlayer* const*, size_t);
+PROXY(PlayerFanOut, size_t, showTextDrawForIds, ITextDraw&, const uint64_t*, size_t);
+PROXY(PlayerFanOut, size_t, hideTextDraw, ITextDraw&, IPlayer* const*, size_t);
+PROXY(PlayerFanOut, size_t, hideTextDrawForIds, ITextDraw&, const uint64_t*, size_t);
+PROXY(PlayerFanOut, size_t, showGangZone, IBaseGangZone&, IPlayer* const*, size_t, Colour&);
+PROXY(PlayerFanOut, size_t, showGangZoneForIds, IBaseGangZone&, const uint64_t*, size_t, Colour&);
+PROXY(PlayerFanOut, size_t, hideGangZone, IBaseGangZone&, IPlayer* const*, size_t);
+PROXY(PlayerFanOut, size_t, hideGangZoneForIds, IBaseGangZone&, const uint64_t*, size_t);
+PROXY(PlayerFanOut, size_t, flashGangZone, IBaseGangZone&, IPlayer* const*, size_t, Colour&);
+PROXY(PlayerFanOut, size_t, flashGangZoneForIds, IBaseGangZone&, const uint64_t*, size_t, Colour&);
+PROXY(PlayerFanOut, size_t, stopFlashGangZone, IBaseGangZone&, IPlayer* const*, size_t);
+PROXY(PlayerFanOut, size_t, stopFlashGangZoneForIds, IBaseGangZone&, const uint64_t*, size_t);
+PROXY(PlayerFanOut, size_t, showMenu, IMenu&, IPlayer* const*, size_t);
+PROXY(PlayerFanOut, size_t, showMenuForIds, IMenu&, const uint64_t*, size_t);
+PROXY(PlayerFanOut, size_t, hideMenu, IMenu&, IPlayer* const*, size_t);
+PROXY(PlayerFanOut, size_t, hideMenuForIds, IMenu&, const uint64_t*, size_t);
+
+PROXY(AsyncLogger, bool, log, LogLevel, StringView);
+PROXY(AsyncLogger, bool, isEnabled, LogLevel);
+PROXY(AsyncLogger, void, setMinLevel, LogLevel);
+PROXY(AsyncLogger, LogLevel, getMinLevel);
+PROXY(AsyncLogger, bool, isRunning);
+PROXY(AsyncLogger, size_t, depth);
+PROXY(AsyncLogger, size_t, capacity);
+PROXY(AsyncLogger, void, getStats, AsyncLoggerStats&);
+PROXY(AsyncLogger, void, resetStats);
+
+#ifdef SAMPSHARP_DATABASE
+PROXY(DatabaseExecutor, int, open, StringView);
+PROXY(DatabaseExecutor, bool, close, int);
+PROXY(DatabaseExecutor, uint64_t, prepare, int, StringView, database_callback_fn, void*);
+PROXY(DatabaseExecutor, bool, finalize, int);
+PROXY(DatabaseExecutor, StringView, getLastError);
+PROXY(DatabaseExecutor, uint64_t, execute, int, StringView, const DatabaseValue*, size_t, database_callback_fn, void*);
+PROXY(DatabaseExecutor, uint64_t, executeStatement, int, const DatabaseValue*, size_t, database_callback_fn, void*);
+PROXY(DatabaseExecutor, void, getStats, DatabaseExecutorStats&);
+PROXY(DatabaseExecutor, void, resetStats);
+#endif
+
+PROXY(TickArena, uint8_t*, allocate, size_t);
+PROXY(TickArena, bool, commit, size_t);
+PROXY(TickArena, void, getStats, TickArenaStats&);
+PROXY(TickArena, void, resetStats);
+
+PROXY(PlayerStringTable, const PlayerString*, getEntries, PlayerStringField);
+PROXY(PlayerStringTable, size_t, getEntryCount);
+PROXY(PlayerStringTable, const PlayerString*, get, int, PlayerStringField);
+
+PROXY(BitStreamCodec, int, addSchema, const BitStreamField*, size_t, size_t);
+PROXY(BitStreamCodec, size_t, getSchemaCount);
+PROXY(BitStreamCodec, bool, decode, int, NetworkBitStream&, void*, size_t);
+PROXY(BitStreamCodec, bool, decodeBytes, int, const uint8_t*, size_t, size_t&, void*, size_t);
+PROXY(BitStreamCodec, bool, encode, int, const void*, size_t);
+PROXY(BitStreamCodec, const uint8_t*, getData);
+PROXY(BitStreamCodec, size_t, getLength);
+PROXY(BitStreamCodec, size_t, getBitLength);
+PROXY(BitStreamCodec, bool, sendRPC, IPlayer&, int, int, const void*, size_t, int);
+PROXY(BitStreamCodec, bool, sendPacket, IPlayer&, int, const void*, size_t, int);
+
+PROXY(ChangeFeed, const EntityChange*, getChanges, EntityTableType);
+PROXY(ChangeFeed, size_t, getChangeCount, EntityTableType);
+PROXY(ChangeFeed, uint32_t, getMask, EntityTableType, int);
+
+PROXY(StreamMatrix, const uint64_t*, getBits, StreamEntityType);
+PROXY(StreamMatrix, size_t, getRowWords, StreamEntityType);
+PROXY(StreamMatrix, const uint64_t*, getRow, StreamEntityType, int);
+PROXY(StreamMatrix, bool, isStreamedIn, StreamEntityType, int, int);
+PROXY(StreamMatrix, size_t, getViewers, StreamEntityType, int, uint64_t*, size_t);
+PROXY(StreamMatrix, const StreamChange*, getChanges, StreamEntityType);
+PROXY(StreamMatrix, size_t, getChangeCount, StreamEntityType);
+
+PROXY(TickPacer, void, setConfig, const TickPacerConfig&);
+PROXY(TickPacer, void, getConfig, TickPacerConfig&);
+PROXY(TickPacer, void, getStats, TickPacerStats&);
+
+PROXY(GcCoordinator, void, setConfig, const GcCoordinatorConfig&);
+PROXY(GcCoordinator, void, getConfig, GcCoordinatorConfig&);
+PROXY(GcCoordinator, void, getStats, GcCoordinatorStats&);
+PROXY(GcCoordinator, void, setHandler, gc_handler_fn);
+PROXY(GcCoordinator, void, beginCritical, uint32_t);
+PROXY(GcCoordinator, void, endCritical);
+PROXY(GcCoordinator, bool, isCritical);
+
+PROXY(WorldSnapshot, bool, start, StringView, uint32_t);
+PROXY(WorldSnapshot, void, stop);
+PROXY(WorldSnapshot, bool, isRunning);
+PROXY(WorldSnapshot, bool, save);
+PROXY(WorldSnapshot, bool, restore, StringView, WorldLoadResult&);
+PROXY(WorldSnapshot, int, getRestoredId, WorldEntityType, int);
+PROXY(WorldSnapshot, void, getStats, WorldSnapshotStats&);
+
+PROXY(ObjectAnimator, void, setCompletedHandler, object_path_completed_fn);
+PROXY(ObjectAnimator, bool, animate, IObject&, const ObjectPathWaypoint*, size_t, const ObjectPathOptions&);
+PROXY(ObjectAnimator, void, stop, IObject&);
+PROXY(ObjectAnimator, bool, isAnimating, IObject&);
+PROXY(ObjectAnimator, void, getStats, ObjectAnimatorStats&);
+
+PROXY(RateLimiter, void, setEnabled, bool);
+PROXY(RateLimiter, bool, isEnabled);
+PROXY(RateLimiter, void, setConfig, RateLimitedEvent, const RateLimitConfig&);
+PROXY(RateLimiter, void, getConfig, RateLimitedEvent, RateLimitConfig&);
+PROXY(RateLimiter, void, setReply, StringView, Colour);
+PROXY(RateLimiter, void, setHandler, rate_limit_fn);
+PROXY(RateLimiter, void, getStats, RateLimiterStats&);
+
+PROXY(BanIndex, void, rebuild);
+PROXY(BanIndex, bool, addSerial, StringView);
+PROXY(BanIndex, bool, removeSerial, StringView);
+PROXY(BanIndex, void, clearSerials);
+PROXY(BanIndex, bool, check, StringView, StringView, StringView, BanVerdict&);
+PROXY(BanIndex, bool, checkPlayer, IPlayer&, BanVerdict&);
+PROXY(BanIndex, void, getStats, BanIndexStats&);
+
 class PoolEventHandlerImpl final : PoolEventHandler<void*>
 {
     typedef void(CORECLR_DELEGATE_CALLTYPE * handle_fn)(void*&);
@@ -0,0 +1,344 @@
+#include "rate-limiter.hpp"
+
+#include <algorithm>
+
+RateLimiter* RateLimiter::active_ = nullptr;
+
+bool RateLimiter::Bucket::take(float rate, float burst, TimePoint now)
+{
+	// a new bucket starts full
+	if (!used)
+	{
+		used = true;
+		tokens = burst;
+	}
+	else
+	{
+		const float elapsed = std::chrono::duration<float>(now - updated).count();
+		tokens = std::min(burst, tokens + std::max(elapsed, 0.0f) * rate);
+	}
+	updated = now;
+
+	if (tokens < 1.0f)
+	{
+		return false;
+	}
+
+	tokens -= 1.0f;
+	return true;
+}
+
+bool RateLimiter::Window::drop(uint32_t milliseconds, TimePoint now)
+{
+	dropped++;
+
+	if (start != TimePoint() && now - start < std::chrono::milliseconds(milliseconds))
+	{
+		return false;
+	}
+
+	start = now;
+	return true;
+}
+
+RateLimiter::RateLimiter()
+	: players_(PLAYER_POOL_SIZE)
+{
+	std::fill(std::begin(limited_), std::end(limited_), -1);
+
+	config_[RateLimitedEvent_Text] = { 2.0f, 6.0f, 0.0f, 0.0f, 5000, false };
+	config_[RateLimitedEvent_CommandText] = { 2.0f, 6.0f, 0.0f, 0.0f, 5000, false };
+	config_[RateLimitedEvent_DialogResponse] = { 4.0f, 12.0f, 0.0f, 0.0f, 5000, false };
+	config_[RateLimitedEvent_ClickTextDraw] = { 8.0f, 24.0f, 0.0f, 0.0f, 5000, false };
+	config_[RateLimitedEvent_ClickMap] = { 1.0f, 3.0f, 0.0f, 0.0f, 5000, false };
+	config_[RateLimitedEvent_IncomingConnection] = { 0.0f, 0.0f, 0.2f, 3.0f, 5000, false };
+}
+
+RateLimiter::~RateLimiter()
+{
+	detach();
+}
+
+void RateLimiter::attach(ICore* core, IComponentList* components)
+{
+	core_ = core;
+	active_ = this;
+
+	// run before any other handler so dropped events reach neither native nor managed handlers of text and commands
+	IPlayerPool& players = core_->getPlayers();
+	players.getPlayerTextDispatcher().addEventHandler(this, EventPriority_Highest);
+	players.getPlayerConnectDispatcher().addEventHandler(this, EventPriority_Highest);
+	players.getPlayerClickDispatcher().addEventHandler(this, EventPriority_Highest);
+
+	dialogs_ = components->queryComponent<IDialogsComponent>();
+	if (dialogs_ != nullptr)
+	{
+		dialogs_->getEventDispatcher().addEventHandler(this, EventPriority_Highest);
+	}
+
+	textDraws_ = components->queryComponent<ITextDrawsComponent>();
+	if (textDraws_ != nullptr)
+	{
+		textDraws_->getEventDispatcher().addEventHandler(this, EventPriority_Highest);
+	}
+}
+
+void RateLimiter::onFree(IComponent* component)
+{
+	if (component == dialogs_)
+	{
+		dialogs_ = nullptr;
+	}
+	if (component == textDraws_)
+	{
+		textDraws_ = nullptr;
+	}
+}
+
+void RateLimiter::detach()
+{
+	if (dialogs_ != nullptr)
+	{
+		dialogs_->getEventDispatcher().removeEventHandler(this);
+		dialogs_ = nullptr;
+	}
+	if (textDraws_ != nullptr)
+	{
+		textDraws_->getEventDispatcher().removeEventHandler(this);
+		textDraws_ = nullptr;
+	}
+	if (core_ != nullptr)
+	{
+		IPlayerPool& players = core_->getPlayers();
+		players.getPlayerTextDispatcher().removeEventHandler(this);
+		players.getPlayerConnectDispatcher().removeEventHandler(this);
+		players.getPlayerClickDispatcher().removeEventHandler(this);
+		core_ = nullptr;
+	}
+	if (active_ == this)
+	{
+		active_ = nullptr;
+	}
+	handler_ = nullptr;
+}
+
+void RateLimiter::setEnabled(bool enabled)
+{
+	enabled_ = enabled;
+	std::fill(std::begin(limited_), std::end(limited_), -1);
+}
+
+bool RateLimiter::isEnabled() const
+{
+	return enabled_;
+}
+
+void RateLimiter::setConfig(RateLimitedEvent event, const RateLimitConfig& config)
+{
+	if (event < RateLimitedEvent_Count)
+	{
+		config_[event] = config;
+	}
+}
+
+void RateLimiter::getConfig(RateLimitedEvent event, RateLimitConfig& config) const
+{
+	if (event < RateLimitedEvent_Count)
+	{
+		config = config_[event];
+	}
+}
+
+void RateLimiter::setReply(StringView message, Colour colour)
+{
+	reply_ = message.to_string();
+	replyColour_ = colour;
+}
+
+void RateLimiter::setHandler(rate_limit_fn handler)
+{
+	handler_ = handler;
+}
+
+void RateLimiter::getStats(RateLimiterStats& stats) const
+{
+	stats = stats_;
+	stats.addresses = static_cast<uint32_t>(addresses_.size());
+}
+
+RateLimiter::PlayerState* RateLimiter::getPlayer(int id)
+{
+	if (id < 0 || static_cast<size_t>(id) >= players_.size())
+	{
+		return nullptr;
+	}
+	return &players_[id];
+}
+
+bool RateLimiter::take(IPlayer& player, RateLimitedEvent event)
+{
+	limited_[event] = -1;
+
+	PlayerState* state = getPlayer(player.getID());
+	if (!enabled_ || state == nullptr || player.isBot())
+	{
+		return true;
+	}
+
+	const RateLimitConfig& config = config_[event];
+	const TimePoint now = std::chrono::steady_clock::now();
+
+	// a token is only taken from the bucket of the address if the bucket of the player has one
+	const bool passed = config.rate <= 0.0f || state->buckets[event].take(config.rate, config.burst, now);
+	const bool ipPassed = !passed || state->address == nullptr || config.ipRate <= 0.0f || state->address->buckets[event].take(config.ipRate, config.ipBurst, now);
+
+	if (passed && ipPassed)
+	{
+		stats_.passed++;
+		return true;
+	}
+
+	if (!passed)
+	{
+		stats_.limited++;
+	}
+	else
+	{
+		stats_.ipLimited++;
+	}
+
+	limited_[event] = player.getID();
+
+	Window& window = state->windows[event];
+	if (!window.drop(config.windowMilliseconds, now))
+	{
+		return false;
+	}
+
+	if (!reply_.empty())
+	{
+		player.sendClientMessage(replyColour_, reply_);
+		stats_.replied++;
+	}
+
+	if (config.escalate && handler_ != nullptr)
+	{
+		const uint32_t dropped = window.dropped;
+		window.dropped = 0;
+		stats_.escalated++;
+		handler_(player, event, dropped);
+	}
+	return false;
+}
+
+void RateLimiter::release(PlayerState& state)
+{
+	if (state.address != nullptr)
+	{
+		state.address->players--;
+		state.address->used = std::chrono::steady_clock::now();
+	}
+	state = PlayerState();
+}
+
+void RateLimiter::tick(TimePoint now)
+{
+	if (now - pruned_ < PRUNE_AFTER)
+	{
+		return;
+	}
+	pruned_ = now;
+
+	for (auto it = addresses_.begin(); it != addresses_.end();)
+	{
+		if (it->second.players == 0 && now - it->second.used >= PRUNE_AFTER)
+		{
+			it = addresses_.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+bool RateLimiter::onPlayerText(IPlayer& player, StringView message)
+{
+	// returning false stops the dispatch and the message is not sent to the other players
+	return take(player, RateLimitedEvent_Text);
+}
+
+bool RateLimiter::onPlayerCommandText(IPlayer& player, StringView message)
+{
+	// a dropped command is handled, so the player does not receive the unknown command message
+	return !take(player, RateLimitedEvent_CommandText);
+}
+
+void RateLimiter::onIncomingConnection(IPlayer& player, StringView ipAddress, unsigned short port)
+{
+	limited_[RateLimitedEvent_IncomingConnection] = -1;
+
+	PlayerState* state = getPlayer(player.getID());
+	if (state == nullptr)
+	{
+		return;
+	}
+
+	// the slot may still hold the state of a player whose disconnect was not seen
+	release(*state);
+
+	if (!enabled_ || player.isBot())
+	{
+		return;
+	}
+
+	const TimePoint now = std::chrono::steady_clock::now();
+	Address& address = addresses_[ipAddress.to_string()];
+	address.players++;
+	address.used = now;
+	state->address = &address;
+
+	const RateLimitConfig& config = config_[RateLimitedEvent_IncomingConnection];
+	if (config.ipRate <= 0.0f || address.buckets[RateLimitedEvent_IncomingConnection].take(config.ipRate, config.ipBurst, now))
+	{
+		stats_.passed++;
+		return;
+	}
+
+	stats_.ipLimited++;
+	limited_[RateLimitedEvent_IncomingConnection] = player.getID();
+
+	if (address.connections.drop(config.windowMilliseconds, now) && config.escalate && handler_ != nullptr)
+	{
+		const uint32_t dropped = address.connections.dropped;
+		address.connections.dropped = 0;
+		stats_.escalated++;
+		handler_(player, RateLimitedEvent_IncomingConnection, dropped);
+	}
+
+	stats_.kicked++;
+	player.kick();
+}
+
+void RateLimiter::onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason)
+{
+	if (PlayerState* state = getPlayer(player.getID()))
+	{
+		release(*state);
+	}
+}
+
+void RateLimiter::onPlayerClickMap(IPlayer& player, Vector3 pos)
+{
+	take(player, RateLimitedEvent_ClickMap);
+}
+
+void RateLimiter::onDialogResponse(IPlayer& player, int dialogId, DialogResponse response, int listItem, StringView inputText)
+{
+	take(player, RateLimitedEvent_DialogResponse);
+}
+
+void RateLimiter::onPlayerClickTextDraw(IPlayer& player, ITextDraw& td)
+{
+	take(player, RateLimitedEvent_ClickTextDraw);
+}
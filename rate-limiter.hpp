@@ -0,0 +1,203 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/Dialogs/dialogs.hpp>
+#include <Server/Components/TextDraws/textdraws.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dotnet/coreclr_delegates.h"
+
+using namespace Impl;
+
+enum RateLimitedEvent : uint8_t
+{
+	RateLimitedEvent_Text,
+	RateLimitedEvent_CommandText,
+	RateLimitedEvent_DialogResponse,
+	RateLimitedEvent_ClickTextDraw,
+	RateLimitedEvent_ClickMap,
+	RateLimitedEvent_IncomingConnection,
+	RateLimitedEvent_Count,
+};
+
+/// token buckets of an event. layout is shared with the managed RateLimitConfig struct
+struct RateLimitConfig
+{
+	/// tokens added to the bucket of a player per second; 0 disables the bucket
+	float rate;
+	/// capacity of the bucket of a player
+	float burst;
+	/// tokens added to the bucket of an address per second, which is shared by the players connected from it; 0
+	/// disables the bucket
+	float ipRate;
+	float ipBurst;
+	/// minimum time between two escalations of the event for a player
+	uint32_t windowMilliseconds;
+	/// whether the escalation handler is called for the event
+	bool escalate;
+};
+
+/// statistics of the rate limiter. layout is shared with the managed RateLimiterStats struct
+struct RateLimiterStats
+{
+	/// events which were passed on
+	uint64_t passed;
+	/// events which were dropped by the bucket of a player
+	uint64_t limited;
+	/// events which were dropped by the bucket of an address
+	uint64_t ipLimited;
+	/// calls of the escalation handler
+	uint64_t escalated;
+	/// default replies sent to players
+	uint64_t replied;
+	/// connections kicked by the bucket of their address
+	uint64_t kicked;
+	/// addresses with buckets
+	uint32_t addresses;
+};
+
+/// handler called for a player whose events are dropped, at most once per window. dropped is the number of events
+/// dropped since the previous call
+typedef void (CORECLR_DELEGATE_CALLTYPE *rate_limit_fn)(IPlayer&, RateLimitedEvent event, uint32_t dropped);
+
+/// token buckets for inbound player events which are cheap to send and expensive to handle in managed code. the
+/// limiter handles the events before any other handler and decides whether the event is passed on; text and commands
+/// are stopped in the dispatcher, the other events are only hidden from the managed handlers, which check isLimited in
+/// their proxies. the native response to a dropped event is the default reply to the player or, for connections,
+/// kicking the player. the escalation handler is optional.
+class RateLimiter final
+	: public PlayerTextEventHandler
+	, public PlayerConnectEventHandler
+	, public PlayerClickEventHandler
+	, public PlayerDialogEventHandler
+	, public TextDrawEventHandler
+{
+private:
+	/// idle time after which the buckets of an address without players are removed
+	static constexpr Seconds PRUNE_AFTER { 60 };
+
+	static RateLimiter* active_;
+
+	struct Bucket
+	{
+		float tokens = 0.0f;
+		TimePoint updated {};
+		bool used = false;
+
+		/// refills the bucket and takes a token. returns false if the bucket is exhausted
+		bool take(float rate, float burst, TimePoint now);
+	};
+
+	struct Window
+	{
+		TimePoint start {};
+		uint32_t dropped = 0;
+
+		/// counts a dropped event. returns true if a new window starts
+		bool drop(uint32_t milliseconds, TimePoint now);
+	};
+
+	struct Address
+	{
+		Bucket buckets[RateLimitedEvent_Count];
+		Window connections;
+		uint32_t players = 0;
+		TimePoint used {};
+	};
+
+	struct PlayerState
+	{
+		Bucket buckets[RateLimitedEvent_Count];
+		Window windows[RateLimitedEvent_Count];
+		/// address of the player, or null before the connection was accepted
+		Address* address = nullptr;
+	};
+
+	ICore* core_ = nullptr;
+	IDialogsComponent* dialogs_ = nullptr;
+	ITextDrawsComponent* textDraws_ = nullptr;
+
+	bool enabled_ = false;
+	RateLimitConfig config_[RateLimitedEvent_Count] {};
+	std::vector<PlayerState> players_;
+	std::unordered_map<std::string, Address> addresses_;
+	TimePoint pruned_ {};
+
+	/// ID of the player whose current event was dropped, per event
+	int limited_[RateLimitedEvent_Count];
+
+	std::string reply_;
+	Colour replyColour_ {};
+	rate_limit_fn handler_ = nullptr;
+	RateLimiterStats stats_ {};
+
+	PlayerState* getPlayer(int id);
+
+	/// takes a token for the event of the player and answers a dropped event. returns false if the event is dropped
+	bool take(IPlayer& player, RateLimitedEvent event);
+
+	void release(PlayerState& state);
+
+public:
+	RateLimiter();
+
+	RateLimiter(const RateLimiter&) = delete;
+	RateLimiter& operator=(const RateLimiter&) = delete;
+
+	~RateLimiter();
+
+	/// the limiter which is attached or null
+	static RateLimiter* getActive()
+	{
+		return active_;
+	}
+
+	void attach(ICore* core, IComponentList* components);
+
+	void onFree(IComponent* component);
+
+	void detach();
+
+	void setEnabled(bool enabled);
+
+	bool isEnabled() const;
+
+	void setConfig(RateLimitedEvent event, const RateLimitConfig& config);
+
+	void getConfig(RateLimitedEvent event, RateLimitConfig& config) const;
+
+	/// sets the message sent to players once per window when their events are dropped. an empty message drops events
+	/// silently
+	void setReply(StringView message, Colour colour);
+
+	void setHandler(rate_limit_fn handler);
+
+	/// whether the event which is being dispatched for the player was dropped
+	bool isLimited(RateLimitedEvent event, IPlayer& player) const
+	{
+		return limited_[event] == player.getID();
+	}
+
+	void getStats(RateLimiterStats& stats) const;
+
+	/// removes the buckets of idle addresses. must be called from the tick of the component
+	void tick(TimePoint now);
+
+	bool onPlayerText(IPlayer& player, StringView message) override;
+
+	bool onPlayerCommandText(IPlayer& player, StringView message) override;
+
+	void onIncomingConnection(IPlayer& player, StringView ipAddress, unsigned short port) override;
+
+	void onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason) override;
+
+	void onPlayerClickMap(IPlayer& player, Vector3 pos) override;
+
+	void onDialogResponse(IPlayer& player, int dialogId, DialogResponse response, int listItem, StringView inputText) override;
+
+	void onPlayerClickTextDraw(IPlayer& player, ITextDraw& td) override;
+};
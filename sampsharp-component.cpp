@@ -1,5 +1,8 @@
 #include "sampsharp-component.hpp"
 
+#include <algorithm>
+#include <ctime>
+
 StringView SampSharpComponent::componentName() const
 {
 	return "SampSharp";
@@ -28,6 +31,70 @@ void SampSharpComponent::provideConfiguration(ILogger& logger, IEarlyConfig& con
 	initConfigString("sampsharp.assembly", "GameMode");
 	initConfigString("sampsharp.entry_point_type", "SashManaged.Interop");
 	initConfigString("sampsharp.entry_point_method", "OnInit");
+	initConfigString("sampsharp.bridge_recorder.path", "");
+	initConfigString("sampsharp.logger.path", "");
+
+    #define initConfigInt(key, value) \
+        if(defaults) { \
+            config.setInt(key, value); } \
+        else if (config.getType(key) == ConfigOptionType_None) { \
+            config.setInt(key, value); \
+        }
+
+    #define initConfigBool(key, value) \
+        if(defaults) { \
+            config.setBool(key, value); } \
+        else if (config.getType(key) == ConfigOptionType_None) { \
+            config.setBool(key, value); \
+        }
+
+	initConfigInt("sampsharp.tick_queue.capacity", 4096);
+	initConfigInt("sampsharp.tick_queue.max_per_tick", 0);
+	initConfigInt("sampsharp.bridge_recorder.segment_size", 64);
+	initConfigInt("sampsharp.logger.capacity", 8192);
+	initConfigInt("sampsharp.logger.level", LogLevel_Message);
+	initConfigInt("sampsharp.logger.max_file_size", 16);
+	initConfigInt("sampsharp.logger.max_files", 5);
+#ifdef SAMPSHARP_DATABASE
+	initConfigInt("sampsharp.database.workers", 2);
+	initConfigInt("sampsharp.database.queue_capacity", 1024);
+#endif
+	initConfigInt("sampsharp.tick_arena.chunk_size", 256);
+	initConfigInt("sampsharp.tick_pacer.target_rate", 0);
+	initConfigInt("sampsharp.tick_pacer.idle_rate", 20);
+	initConfigInt("sampsharp.tick_pacer.min_sleep", 500);
+	initConfigInt("sampsharp.tick_pacer.max_sleep", 50000);
+	initConfigInt("sampsharp.tick_pacer.deadband", 250);
+	initConfigInt("sampsharp.tick_pacer.backlog_threshold", 512);
+	initConfigInt("sampsharp.tick_pacer.idle_ticks", 200);
+	initConfigInt("sampsharp.gc.budget", 20000);
+	initConfigInt("sampsharp.gc.sleep", 5000);
+	initConfigInt("sampsharp.gc.min_slack", 4000);
+	initConfigInt("sampsharp.gc.full_slack", 15000);
+	initConfigInt("sampsharp.gc.min_interval", 50);
+	initConfigBool("sampsharp.gc.blocking_full", false);
+	initConfigInt("sampsharp.gc.allocation_threshold", 16384);
+	initConfigInt("sampsharp.gc.full_allocation_threshold", 262144);
+	initConfigInt("sampsharp.gc.no_gc_region_size", 16384);
+	initConfigString("sampsharp.snapshot.path", "");
+	initConfigInt("sampsharp.snapshot.interval", 60);
+	initConfigBool("sampsharp.snapshot.restore", false);
+	initConfigBool("sampsharp.rate_limit.enabled", false);
+	initConfigString("sampsharp.rate_limit.reply", "");
+	initConfigBool("sampsharp.rate_limit.escalate", false);
+	initConfigInt("sampsharp.rate_limit.window", 5000);
+	initConfigInt("sampsharp.rate_limit.text", 2000);
+	initConfigInt("sampsharp.rate_limit.command", 2000);
+	initConfigInt("sampsharp.rate_limit.dialog", 4000);
+	initConfigInt("sampsharp.rate_limit.click_textdraw", 8000);
+	initConfigInt("sampsharp.rate_limit.click_map", 1000);
+	initConfigInt("sampsharp.rate_limit.ip_text", 0);
+	initConfigInt("sampsharp.rate_limit.ip_command", 0);
+	initConfigInt("sampsharp.rate_limit.ip_dialog", 0);
+	initConfigInt("sampsharp.rate_limit.ip_click_textdraw", 0);
+	initConfigInt("sampsharp.rate_limit.ip_click_map", 0);
+	initConfigInt("sampsharp.rate_limit.ip_connection", 200);
+	initConfigBool("sampsharp.text_dedupe", false);
 }
 
 std::wstring widen(std::string const &in)
@@ -51,15 +118,158 @@ std::wstring widen(std::string const &in)
     return out;
 }
 
+static size_t getConfigSize(IConfig& config, StringView key, int fallback)
+{
+	const int* value = config.getInt(key);
+	const int result = value ? *value : fallback;
+	return result > 0 ? static_cast<size_t>(result) : 0;
+}
+
 void SampSharpComponent::onInit(IComponentList* components)
 {
-	const IConfig& config = core_->getConfig();
+	IConfig& config = core_->getConfig();
 
 	auto folder = config.getString("sampsharp.folder");
 	auto assembly = config.getString("sampsharp.assembly");
 	auto entry_point_type = config.getString("sampsharp.entry_point_type");
 	auto entry_point_method = config.getString("sampsharp.entry_point_method");
 
+	tick_queue_ = std::make_unique<TickQueue>(
+		getConfigSize(config, "sampsharp.tick_queue.capacity", 4096),
+		getConfigSize(config, "sampsharp.tick_queue.max_per_tick", 0));
+
+	// chunk size is configured in kilobytes
+	tick_arena_ = std::make_unique<TickArena>(getConfigSize(config, "sampsharp.tick_arena.chunk_size", 256) * 1024);
+
+	// segment size is configured in megabytes
+	bridge_recorder_ = std::make_unique<BridgeRecorder>(getConfigSize(config, "sampsharp.bridge_recorder.segment_size", 64) * 1024 * 1024);
+
+	// the logger is started before the managed code is loaded so it can log during its initialization. file sizes are
+	// configured in megabytes
+	async_logger_ = std::make_unique<AsyncLogger>(getConfigSize(config, "sampsharp.logger.capacity", 8192));
+	async_logger_->setMinLevel(static_cast<LogLevel>(getConfigSize(config, "sampsharp.logger.level", LogLevel_Message)));
+
+	auto logger_path = config.getString("sampsharp.logger.path");
+	if (!async_logger_->start(core_, logger_path, getConfigSize(config, "sampsharp.logger.max_file_size", 16) * 1024 * 1024,
+			static_cast<uint32_t>(getConfigSize(config, "sampsharp.logger.max_files", 5))))
+	{
+		core_->printLn("failed to start the logger with %s", logger_path.to_string().c_str());
+	}
+
+#ifdef SAMPSHARP_DATABASE
+	database_executor_.start(
+		getConfigSize(config, "sampsharp.database.workers", 2),
+		getConfigSize(config, "sampsharp.database.queue_capacity", 1024));
+#endif
+
+	core_->getEventDispatcher().addEventHandler(this);
+
+	entity_tables_.attach(core_, components);
+	player_column_store_.attach(core_);
+	sync_validator_.attach(core_);
+	change_feed_.attach(core_, components);
+	stream_matrix_.attach(core_, components);
+	hit_validator_.attach(core_);
+	bridge_replayer_.attach(core_, components);
+	command_router_.attach(core_);
+	text_dedupe_cache_.attach(core_, components);
+	player_string_table_.attach(core_);
+	player_fan_out_.attach(core_, text_dedupe_cache_);
+	world_loader_.attach(components);
+	world_snapshot_.attach(components);
+	object_animator_.attach(components);
+	rate_limiter_.attach(core_, components);
+	ban_index_.attach(core_);
+
+	// sleep times are configured in microseconds; a target rate of 0 leaves the sleep of the core alone
+	TickPacerConfig tick_pacer_config;
+	tick_pacer_config.targetRate = static_cast<uint32_t>(getConfigSize(config, "sampsharp.tick_pacer.target_rate", 0));
+	tick_pacer_config.idleRate = static_cast<uint32_t>(getConfigSize(config, "sampsharp.tick_pacer.idle_rate", 20));
+	tick_pacer_config.minSleepMicroseconds = static_cast<uint32_t>(getConfigSize(config, "sampsharp.tick_pacer.min_sleep", 500));
+	tick_pacer_config.maxSleepMicroseconds = static_cast<uint32_t>(getConfigSize(config, "sampsharp.tick_pacer.max_sleep", 50000));
+	tick_pacer_config.deadbandMicroseconds = static_cast<uint32_t>(getConfigSize(config, "sampsharp.tick_pacer.deadband", 250));
+	tick_pacer_config.backlogThreshold = static_cast<uint32_t>(getConfigSize(config, "sampsharp.tick_pacer.backlog_threshold", 512));
+	tick_pacer_config.idleTicks = static_cast<uint32_t>(getConfigSize(config, "sampsharp.tick_pacer.idle_ticks", 200));
+	tick_pacer_.attach(core_);
+	tick_pacer_.setConfig(tick_pacer_config);
+
+	// thresholds and region sizes are configured in KB
+	GcCoordinatorConfig gc_config;
+	gc_config.budgetMicroseconds = static_cast<uint32_t>(getConfigSize(config, "sampsharp.gc.budget", 20000));
+	gc_config.sleepMicroseconds = static_cast<uint32_t>(getConfigSize(config, "sampsharp.gc.sleep", 5000));
+	gc_config.minSlackMicroseconds = static_cast<uint32_t>(getConfigSize(config, "sampsharp.gc.min_slack", 4000));
+	gc_config.fullSlackMicroseconds = static_cast<uint32_t>(getConfigSize(config, "sampsharp.gc.full_slack", 15000));
+	gc_config.minIntervalTicks = static_cast<uint32_t>(getConfigSize(config, "sampsharp.gc.min_interval", 50));
+	const bool* gc_blocking_full = config.getBool("sampsharp.gc.blocking_full");
+	gc_config.blockingFull = gc_blocking_full != nullptr && *gc_blocking_full;
+	gc_config.allocationThreshold = getConfigSize(config, "sampsharp.gc.allocation_threshold", 16384) * 1024;
+	gc_config.fullAllocationThreshold = getConfigSize(config, "sampsharp.gc.full_allocation_threshold", 262144) * 1024;
+	gc_config.noGcRegionSize = getConfigSize(config, "sampsharp.gc.no_gc_region_size", 16384) * 1024;
+	gc_coordinator_.attach(tick_pacer_);
+	gc_coordinator_.setConfig(gc_config);
+
+	// the interval is configured in seconds; 0 only takes snapshots on request
+	auto snapshot_path = config.getString("sampsharp.snapshot.path");
+	if (!snapshot_path.empty() && !world_snapshot_.start(snapshot_path, static_cast<uint32_t>(getConfigSize(config, "sampsharp.snapshot.interval", 60))))
+	{
+		core_->printLn("failed to start world snapshots to %s", snapshot_path.to_string().c_str());
+	}
+
+	// rates are configured in events per 1000 seconds for every player or address, and a bucket holds the events of three
+	// seconds of the rate but at least three events; a rate of 0 disables the bucket
+	static constexpr struct
+	{
+		RateLimitedEvent event;
+		const char* rate;
+		const char* ipRate;
+	} rate_limit_keys[] = {
+		{ RateLimitedEvent_Text, "sampsharp.rate_limit.text", "sampsharp.rate_limit.ip_text" },
+		{ RateLimitedEvent_CommandText, "sampsharp.rate_limit.command", "sampsharp.rate_limit.ip_command" },
+		{ RateLimitedEvent_DialogResponse, "sampsharp.rate_limit.dialog", "sampsharp.rate_limit.ip_dialog" },
+		{ RateLimitedEvent_ClickTextDraw, "sampsharp.rate_limit.click_textdraw", "sampsharp.rate_limit.ip_click_textdraw" },
+		{ RateLimitedEvent_ClickMap, "sampsharp.rate_limit.click_map", "sampsharp.rate_limit.ip_click_map" },
+		{ RateLimitedEvent_IncomingConnection, nullptr, "sampsharp.rate_limit.ip_connection" },
+	};
+	const bool* rate_limit_escalate = config.getBool("sampsharp.rate_limit.escalate");
+	const uint32_t rate_limit_window = static_cast<uint32_t>(getConfigSize(config, "sampsharp.rate_limit.window", 5000));
+	for (const auto& keys : rate_limit_keys)
+	{
+		RateLimitConfig rate_limit_config;
+		rate_limiter_.getConfig(keys.event, rate_limit_config);
+		if (keys.rate != nullptr)
+		{
+			rate_limit_config.rate = getConfigSize(config, keys.rate, 0) / 1000.0f;
+			rate_limit_config.burst = std::max(rate_limit_config.rate * 3.0f, 3.0f);
+		}
+		rate_limit_config.ipRate = getConfigSize(config, keys.ipRate, 0) / 1000.0f;
+		rate_limit_config.ipBurst = std::max(rate_limit_config.ipRate * 3.0f, 3.0f);
+		rate_limit_config.windowMilliseconds = rate_limit_window;
+		rate_limit_config.escalate = rate_limit_escalate != nullptr && *rate_limit_escalate;
+		rate_limiter_.setConfig(keys.event, rate_limit_config);
+	}
+	rate_limiter_.setReply(config.getString("sampsharp.rate_limit.reply"), Colour(0xFF, 0x63, 0x47, 0xFF));
+	const bool* rate_limit_enabled = config.getBool("sampsharp.rate_limit.enabled");
+	rate_limiter_.setEnabled(rate_limit_enabled != nullptr && *rate_limit_enabled);
+
+	const bool* text_dedupe = config.getBool("sampsharp.text_dedupe");
+	text_dedupe_cache_.setEnabled(text_dedupe != nullptr && *text_dedupe);
+
+	// recording starts before the managed code is loaded so the recording includes all events passed to it. the start
+	// time is appended to the configured path so restarts do not overwrite earlier recordings
+	auto bridge_recording = config.getString("sampsharp.bridge_recorder.path");
+	if (!bridge_recording.empty())
+	{
+		char timestamp[32];
+		const std::time_t time = std::time(nullptr);
+		std::strftime(timestamp, sizeof(timestamp), "-%Y%m%d-%H%M%S", std::localtime(&time));
+
+		const std::string prefix = bridge_recording.to_string() + timestamp;
+		if (!bridge_recorder_->start(prefix))
+		{
+			core_->printLn("failed to start bridge recording %s", prefix.c_str());
+		}
+	}
+
 	auto full_entry_point = entry_point_type.to_string() + ", " + assembly.to_string(); // namespace.class, assembly
 
 	// TODO: this is windows-only
@@ -77,6 +287,68 @@ void SampSharpComponent::onInit(IComponentList* components)
 
 void SampSharpComponent::onReady()
 {
+	// the world is restored once every component is initialised so the entities can be created
+	IConfig& config = core_->getConfig();
+	const bool* snapshot_restore = config.getBool("sampsharp.snapshot.restore");
+	auto snapshot_path = config.getString("sampsharp.snapshot.path");
+
+	if (snapshot_restore != nullptr && *snapshot_restore && !snapshot_path.empty())
+	{
+		WorldLoadResult result;
+		if (world_snapshot_.restore(snapshot_path, result))
+		{
+			core_->printLn("restored %u vehicles, %u objects and %u labels from %s", result.ranges[WorldEntityType_Vehicle].created,
+				result.ranges[WorldEntityType_Object].created, result.ranges[WorldEntityType_Label].created, snapshot_path.to_string().c_str());
+		}
+		else if (result.status != WorldLoadStatus_OpenFailed)
+		{
+			core_->printLn("failed to restore the world snapshot %s", snapshot_path.to_string().c_str());
+		}
+	}
+}
+
+void SampSharpComponent::onFree(IComponent* component)
+{
+	entity_tables_.onFree(component);
+	text_dedupe_cache_.onFree(component);
+	world_loader_.onFree(component);
+	change_feed_.onFree(component);
+	stream_matrix_.onFree(component);
+	world_snapshot_.onFree(component);
+	object_animator_.onFree(component);
+	rate_limiter_.onFree(component);
+	bridge_replayer_.onFree(component);
+}
+
+void SampSharpComponent::onTick(Microseconds elapsed, TimePoint now)
+{
+	// the interval is measured before the component does any work of its own
+	tick_pacer_.tick(elapsed);
+	gc_coordinator_.tick(elapsed);
+
+	// changes gathered since the previous tick are published first so every handler of this tick sees the same list
+	change_feed_.publish();
+	stream_matrix_.publish();
+
+	// items posted by worker threads run before anything else in the tick of the component
+	tick_queue_->drain();
+
+#ifdef SAMPSHARP_DATABASE
+	database_executor_.dispatch();
+#endif
+
+	bridge_replayer_.tick();
+
+	rate_limiter_.tick(now);
+
+	// the snapshot is copied after the work of the tick and written in the background
+	world_snapshot_.tick(now);
+
+	// memory handed to managed code is valid until the end of the tick
+	tick_arena_->reset();
+
+	// collections are induced once the component is done with the tick
+	gc_coordinator_.collect();
 }
 
 void SampSharpComponent::free()
@@ -88,6 +360,135 @@ void SampSharpComponent::reset()
 {
 }
 
+TickQueue& SampSharpComponent::getTickQueue()
+{
+	return *tick_queue_;
+}
+
+EntityTable* SampSharpComponent::getEntityTable(EntityTableType type)
+{
+	return entity_tables_.get(type);
+}
+
+PlayerColumnStore& SampSharpComponent::getPlayerColumnStore()
+{
+	return player_column_store_;
+}
+
+SyncValidator& SampSharpComponent::getSyncValidator()
+{
+	return sync_validator_;
+}
+
+HitValidator& SampSharpComponent::getHitValidator()
+{
+	return hit_validator_;
+}
+
+BridgeRecorder& SampSharpComponent::getBridgeRecorder()
+{
+	return *bridge_recorder_;
+}
+
+BridgeReplayer& SampSharpComponent::getBridgeReplayer()
+{
+	return bridge_replayer_;
+}
+
+CommandRouter& SampSharpComponent::getCommandRouter()
+{
+	return command_router_;
+}
+
+TextDrawStyler& SampSharpComponent::getTextDrawStyler()
+{
+	return text_draw_styler_;
+}
+
+TextDedupeCache& SampSharpComponent::getTextDedupeCache()
+{
+	return text_dedupe_cache_;
+}
+
+WorldLoader& SampSharpComponent::getWorldLoader()
+{
+	return world_loader_;
+}
+
+PlayerFanOut& SampSharpComponent::getPlayerFanOut()
+{
+	return player_fan_out_;
+}
+
+AsyncLogger& SampSharpComponent::getAsyncLogger()
+{
+	return *async_logger_;
+}
+
+DatabaseExecutor* SampSharpComponent::getDatabaseExecutor()
+{
+#ifdef SAMPSHARP_DATABASE
+	return &database_executor_;
+#else
+	return nullptr;
+#endif
+}
+
+TickArena& SampSharpComponent::getTickArena()
+{
+	return *tick_arena_;
+}
+
+PlayerStringTable& SampSharpComponent::getPlayerStringTable()
+{
+	return player_string_table_;
+}
+
+BitStreamCodec& SampSharpComponent::getBitStreamCodec()
+{
+	return bit_stream_codec_;
+}
+
+ChangeFeed& SampSharpComponent::getChangeFeed()
+{
+	return change_feed_;
+}
+
+StreamMatrix& SampSharpComponent::getStreamMatrix()
+{
+	return stream_matrix_;
+}
+
+TickPacer& SampSharpComponent::getTickPacer()
+{
+	return tick_pacer_;
+}
+
+GcCoordinator& SampSharpComponent::getGcCoordinator()
+{
+	return gc_coordinator_;
+}
+
+WorldSnapshot& SampSharpComponent::getWorldSnapshot()
+{
+	return world_snapshot_;
+}
+
+ObjectAnimator& SampSharpComponent::getObjectAnimator()
+{
+	return object_animator_;
+}
+
+RateLimiter& SampSharpComponent::getRateLimiter()
+{
+	return rate_limiter_;
+}
+
+BanIndex& SampSharpComponent::getBanIndex()
+{
+	return ban_index_;
+}
+
 SampSharpComponent* SampSharpComponent::getInstance()
 {
 	if (instance_ == nullptr)
@@ -96,3 +497,43 @@ SampSharpComponent* SampSharpComponent::getInstance()
 	}
 	return instance_;
 }
+
+SampSharpComponent::~SampSharpComponent()
+{
+	entity_tables_.detachAll();
+	player_column_store_.detach();
+	sync_validator_.detach();
+	hit_validator_.detach();
+	bridge_replayer_.detach();
+	command_router_.detach();
+	text_dedupe_cache_.detach();
+	world_loader_.detach();
+	player_fan_out_.detach();
+	player_string_table_.detach();
+	change_feed_.detach();
+	stream_matrix_.detach();
+#ifdef SAMPSHARP_DATABASE
+	database_executor_.stop();
+#endif
+	tick_pacer_.detach();
+	gc_coordinator_.detach();
+	world_snapshot_.detach();
+	object_animator_.detach();
+	rate_limiter_.detach();
+	ban_index_.detach();
+
+	if (bridge_recorder_)
+	{
+		bridge_recorder_->stop();
+	}
+
+	if (async_logger_)
+	{
+		async_logger_->stop();
+	}
+
+	if (core_ != nullptr)
+	{
+		core_->getEventDispatcher().removeEventHandler(this);
+	}
+}
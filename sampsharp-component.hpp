@@ -2,7 +2,34 @@
 
 #include <sdk.hpp>
 
+#include <memory>
+
+#include "async-logger.hpp"
+#include "ban-index.hpp"
+#include "bit-stream-codec.hpp"
+#include "bridge-recorder.hpp"
+#include "bridge-replayer.hpp"
+#include "change-feed.hpp"
+#include "command-router.hpp"
+#include "database-executor.hpp"
+#include "entity-table.hpp"
+#include "gc-coordinator.hpp"
+#include "hit-validator.hpp"
 #include "managed-host.hpp"
+#include "object-animator.hpp"
+#include "player-column-store.hpp"
+#include "player-fan-out.hpp"
+#include "player-string-table.hpp"
+#include "rate-limiter.hpp"
+#include "stream-matrix.hpp"
+#include "sync-validator.hpp"
+#include "text-dedupe-cache.hpp"
+#include "text-draw-styler.hpp"
+#include "tick-arena.hpp"
+#include "tick-pacer.hpp"
+#include "tick-queue.hpp"
+#include "world-loader.hpp"
+#include "world-snapshot.hpp"
 
 using namespace Impl;
 
@@ -11,16 +38,120 @@ typedef void (CORECLR_DELEGATE_CALLTYPE *on_init_fn)(ICore *, IComponentList*);
 struct ISampSharpComponent : IComponent
 {
 	PROVIDE_UID(0x0B61929D1E94A319);
+
+	/// queue of items posted from any thread to be invoked on the server thread during the tick
+	virtual TickQueue& getTickQueue() = 0;
+
+	/// dense table of the entries of a pool indexed by ID or null if the pool is not available
+	virtual EntityTable* getEntityTable(EntityTableType type) = 0;
+
+	/// structure-of-arrays storage for per-player data of the game mode
+	virtual PlayerColumnStore& getPlayerColumnStore() = 0;
+
+	/// native validation of player and driver sync
+	virtual SyncValidator& getSyncValidator() = 0;
+
+	/// lag-compensated validation of player-on-player shots
+	virtual HitValidator& getHitValidator() = 0;
+
+	/// recorder of the events passed to managed event handlers
+	virtual BridgeRecorder& getBridgeRecorder() = 0;
+
+	/// replays recordings of the bridge recorder into the managed event handlers
+	virtual BridgeReplayer& getBridgeReplayer() = 0;
+
+	/// native routing of player commands by name
+	virtual CommandRouter& getCommandRouter() = 0;
+
+	/// batched application of textdraw appearances
+	virtual TextDrawStyler& getTextDrawStyler() = 0;
+
+	/// suppression of text updates which do not change the text shown to players
+	virtual TextDedupeCache& getTextDedupeCache() = 0;
+
+	/// memory-mapped bulk loader of world entities
+	virtual WorldLoader& getWorldLoader() = 0;
+
+	/// show and hide operations applied to many players in one native loop
+	virtual PlayerFanOut& getPlayerFanOut() = 0;
+
+	/// logging sink written by a background thread
+	virtual AsyncLogger& getAsyncLogger() = 0;
+
+	/// SQLite queries executed on worker threads with completions delivered during the tick; null if the component was
+	/// built without SAMPSHARP_DATABASE
+	virtual DatabaseExecutor* getDatabaseExecutor() = 0;
+
+	/// bump allocator for native copies of managed data which are valid until the end of the tick
+	virtual TickArena& getTickArena() = 0;
+
+	/// interned UTF-8 and UTF-16 strings of the connected players
+	virtual PlayerStringTable& getPlayerStringTable() = 0;
+
+	/// schema-driven decoding and encoding of network bit streams
+	virtual BitStreamCodec& getBitStreamCodec() = 0;
+
+	/// per-tick list of the players and vehicles whose properties changed
+	virtual ChangeFeed& getChangeFeed() = 0;
+
+	/// bitsets of the players, vehicles and actors streamed in for every player
+	virtual StreamMatrix& getStreamMatrix() = 0;
+
+	/// adjustment of the thread sleep of the core to the load of the server
+	virtual TickPacer& getTickPacer() = 0;
+
+	/// scheduling of managed collections into the slack of the tick loop
+	virtual GcCoordinator& getGcCoordinator() = 0;
+
+	/// periodic binary snapshot of the dynamic world for crash recovery
+	virtual WorldSnapshot& getWorldSnapshot() = 0;
+
+	/// movement of objects along paths of waypoints without managed code per segment
+	virtual ObjectAnimator& getObjectAnimator() = 0;
+
+	/// token buckets for inbound player events before they reach managed code
+	virtual RateLimiter& getRateLimiter() = 0;
+
+	/// indexed lookup of the bans of the config by address, range, name and serial
+	virtual BanIndex& getBanIndex() = 0;
 };
 
 class SampSharpComponent final
 	: public ISampSharpComponent
+	, public CoreEventHandler
 {
 private:
 	ICore* core_ = nullptr;
 	ManagedHost managed_host_;
 	inline static SampSharpComponent* instance_ = nullptr;
 	on_init_fn on_init_ = nullptr;
+	std::unique_ptr<TickQueue> tick_queue_;
+	EntityTables entity_tables_;
+	PlayerColumnStore player_column_store_;
+	SyncValidator sync_validator_;
+	HitValidator hit_validator_;
+	std::unique_ptr<BridgeRecorder> bridge_recorder_;
+	BridgeReplayer bridge_replayer_;
+	CommandRouter command_router_;
+	TextDrawStyler text_draw_styler_;
+	TextDedupeCache text_dedupe_cache_;
+	WorldLoader world_loader_;
+	PlayerFanOut player_fan_out_;
+	std::unique_ptr<AsyncLogger> async_logger_;
+#ifdef SAMPSHARP_DATABASE
+	DatabaseExecutor database_executor_;
+#endif
+	std::unique_ptr<TickArena> tick_arena_;
+	PlayerStringTable player_string_table_;
+	BitStreamCodec bit_stream_codec_;
+	ChangeFeed change_feed_;
+	StreamMatrix stream_matrix_;
+	TickPacer tick_pacer_;
+	GcCoordinator gc_coordinator_;
+	WorldSnapshot world_snapshot_;
+	ObjectAnimator object_animator_;
+	RateLimiter rate_limiter_;
+	BanIndex ban_index_;
 
 public:
 	StringView componentName() const override;
@@ -35,11 +166,65 @@ public:
 
 	void onReady() override;
 
+	void onFree(IComponent* component) override;
+
+	void onTick(Microseconds elapsed, TimePoint now) override;
+
 	void free() override;
 
 	void reset() override;
+
+	TickQueue& getTickQueue() override;
+
+	EntityTable* getEntityTable(EntityTableType type) override;
+
+	PlayerColumnStore& getPlayerColumnStore() override;
+
+	SyncValidator& getSyncValidator() override;
+
+	HitValidator& getHitValidator() override;
+
+	BridgeRecorder& getBridgeRecorder() override;
+
+	BridgeReplayer& getBridgeReplayer() override;
+
+	CommandRouter& getCommandRouter() override;
+
+	TextDrawStyler& getTextDrawStyler() override;
+
+	TextDedupeCache& getTextDedupeCache() override;
+
+	WorldLoader& getWorldLoader() override;
+
+	PlayerFanOut& getPlayerFanOut() override;
+
+	AsyncLogger& getAsyncLogger() override;
+
+	DatabaseExecutor* getDatabaseExecutor() override;
+
+	TickArena& getTickArena() override;
+
+	PlayerStringTable& getPlayerStringTable() override;
+
+	BitStreamCodec& getBitStreamCodec() override;
+
+	ChangeFeed& getChangeFeed() override;
+
+	StreamMatrix& getStreamMatrix() override;
+
+	TickPacer& getTickPacer() override;
+
+	GcCoordinator& getGcCoordinator() override;
+
+	WorldSnapshot& getWorldSnapshot() override;
+
+	ObjectAnimator& getObjectAnimator() override;
+
+	RateLimiter& getRateLimiter() override;
+
+	BanIndex& getBanIndex() override;
 	
 	static SampSharpComponent* getInstance();
 
-	~SampSharpComponent() = default;
+	~SampSharpComponent();
 };
@@ -0,0 +1,296 @@
+#include "stream-matrix.hpp"
+
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+static unsigned lowestBit(uint64_t bits)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctzll(bits));
+#endif
+}
+
+static size_t wordsFor(size_t bits)
+{
+	return (bits + 63) / 64;
+}
+
+StreamMatrix::StreamMatrix()
+{
+	const size_t entities[StreamEntityType_Count] = { PLAYER_POOL_SIZE, VEHICLE_POOL_SIZE, ACTOR_POOL_SIZE };
+
+	for (size_t type = 0; type < StreamEntityType_Count; type++)
+	{
+		Matrix& matrix = matrices_[type];
+		matrix.entities = entities[type];
+		matrix.words = wordsFor(entities[type]);
+		matrix.bits.assign(matrix.words * PLAYER_POOL_SIZE, 0);
+	}
+}
+
+StreamMatrix::~StreamMatrix()
+{
+	detach();
+}
+
+void StreamMatrix::attach(ICore* core, IComponentList* components)
+{
+	core_ = core;
+	core_->getPlayers().getPlayerConnectDispatcher().addEventHandler(this);
+	core_->getPlayers().getPlayerStreamDispatcher().addEventHandler(this);
+
+	vehicles_ = components->queryComponent<IVehiclesComponent>();
+	if (vehicles_ != nullptr)
+	{
+		vehicles_->getEventDispatcher().addEventHandler(this);
+		vehicles_->getPoolEventDispatcher().addEventHandler(this);
+	}
+
+	actors_ = components->queryComponent<IActorsComponent>();
+	if (actors_ != nullptr)
+	{
+		actors_->getEventDispatcher().addEventHandler(this);
+		actors_->getPoolEventDispatcher().addEventHandler(this);
+	}
+}
+
+void StreamMatrix::onFree(IComponent* component)
+{
+	if (component == vehicles_)
+	{
+		vehicles_ = nullptr;
+	}
+	else if (component == actors_)
+	{
+		actors_ = nullptr;
+	}
+}
+
+void StreamMatrix::detach()
+{
+	if (vehicles_ != nullptr)
+	{
+		vehicles_->getEventDispatcher().removeEventHandler(this);
+		vehicles_->getPoolEventDispatcher().removeEventHandler(this);
+		vehicles_ = nullptr;
+	}
+
+	if (actors_ != nullptr)
+	{
+		actors_->getEventDispatcher().removeEventHandler(this);
+		actors_->getPoolEventDispatcher().removeEventHandler(this);
+		actors_ = nullptr;
+	}
+
+	if (core_ != nullptr)
+	{
+		core_->getPlayers().getPlayerConnectDispatcher().removeEventHandler(this);
+		core_->getPlayers().getPlayerStreamDispatcher().removeEventHandler(this);
+		core_ = nullptr;
+	}
+}
+
+StreamMatrix::Matrix* StreamMatrix::getMatrix(StreamEntityType type)
+{
+	return type < StreamEntityType_Count ? &matrices_[type] : nullptr;
+}
+
+const StreamMatrix::Matrix* StreamMatrix::getMatrix(StreamEntityType type) const
+{
+	return type < StreamEntityType_Count ? &matrices_[type] : nullptr;
+}
+
+void StreamMatrix::set(StreamEntityType type, int player, int entity, bool streamedIn)
+{
+	Matrix& matrix = matrices_[type];
+	if (player < 0 || static_cast<size_t>(player) >= PLAYER_POOL_SIZE || entity < 0 || static_cast<size_t>(entity) >= matrix.entities)
+	{
+		return;
+	}
+
+	uint64_t& word = matrix.bits[player * matrix.words + entity / 64];
+	const uint64_t bit = 1ull << (entity % 64);
+
+	// repeated events do not change the state and are not reported
+	if (((word & bit) != 0) == streamedIn)
+	{
+		return;
+	}
+
+	word ^= bit;
+	matrix.pending.push_back(StreamChange { player, entity, streamedIn });
+}
+
+void StreamMatrix::clearEntity(StreamEntityType type, int entity)
+{
+	const Matrix& matrix = matrices_[type];
+	if (entity < 0 || static_cast<size_t>(entity) >= matrix.entities)
+	{
+		return;
+	}
+
+	const size_t index = entity / 64;
+	const uint64_t bit = 1ull << (entity % 64);
+
+	for (size_t player = 0; player < PLAYER_POOL_SIZE; player++)
+	{
+		if (matrix.bits[player * matrix.words + index] & bit)
+		{
+			set(type, static_cast<int>(player), entity, false);
+		}
+	}
+}
+
+void StreamMatrix::publish()
+{
+	for (Matrix& matrix : matrices_)
+	{
+		matrix.changes.swap(matrix.pending);
+		matrix.pending.clear();
+	}
+}
+
+const uint64_t* StreamMatrix::getBits(StreamEntityType type) const
+{
+	const Matrix* matrix = getMatrix(type);
+	return matrix ? matrix->bits.data() : nullptr;
+}
+
+size_t StreamMatrix::getRowWords(StreamEntityType type) const
+{
+	const Matrix* matrix = getMatrix(type);
+	return matrix ? matrix->words : 0;
+}
+
+const uint64_t* StreamMatrix::getRow(StreamEntityType type, int player) const
+{
+	const Matrix* matrix = getMatrix(type);
+	if (matrix == nullptr || player < 0 || static_cast<size_t>(player) >= PLAYER_POOL_SIZE)
+	{
+		return nullptr;
+	}
+	return matrix->bits.data() + player * matrix->words;
+}
+
+bool StreamMatrix::isStreamedIn(StreamEntityType type, int player, int entity) const
+{
+	const uint64_t* row = getRow(type, player);
+	if (row == nullptr || entity < 0 || static_cast<size_t>(entity) >= getMatrix(type)->entities)
+	{
+		return false;
+	}
+	return (row[entity / 64] >> (entity % 64)) & 1;
+}
+
+size_t StreamMatrix::getViewers(StreamEntityType type, int entity, uint64_t* output, size_t words) const
+{
+	memset(output, 0, words * sizeof(uint64_t));
+
+	const Matrix* matrix = getMatrix(type);
+	if (matrix == nullptr || entity < 0 || static_cast<size_t>(entity) >= matrix->entities)
+	{
+		return 0;
+	}
+
+	const size_t index = entity / 64;
+	const uint64_t bit = 1ull << (entity % 64);
+	const size_t players = words * 64 < PLAYER_POOL_SIZE ? words * 64 : PLAYER_POOL_SIZE;
+	size_t count = 0;
+
+	for (size_t player = 0; player < players; player++)
+	{
+		if (matrix->bits[player * matrix->words + index] & bit)
+		{
+			output[player / 64] |= 1ull << (player % 64);
+			count++;
+		}
+	}
+	return count;
+}
+
+const StreamChange* StreamMatrix::getChanges(StreamEntityType type) const
+{
+	const Matrix* matrix = getMatrix(type);
+	return matrix ? matrix->changes.data() : nullptr;
+}
+
+size_t StreamMatrix::getChangeCount(StreamEntityType type) const
+{
+	const Matrix* matrix = getMatrix(type);
+	return matrix ? matrix->changes.size() : 0;
+}
+
+void StreamMatrix::onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason)
+{
+	const int id = player.getID();
+	if (id < 0 || static_cast<size_t>(id) >= PLAYER_POOL_SIZE)
+	{
+		return;
+	}
+
+	// everything streamed in for the player is streamed out, and the player is streamed out for everyone
+	for (size_t type = 0; type < StreamEntityType_Count; type++)
+	{
+		Matrix& matrix = matrices_[type];
+		uint64_t* row = matrix.bits.data() + id * matrix.words;
+
+		for (size_t i = 0; i < matrix.words; i++)
+		{
+			while (row[i] != 0)
+			{
+				const int entity = static_cast<int>(i * 64 + lowestBit(row[i]));
+				set(static_cast<StreamEntityType>(type), id, entity, false);
+			}
+		}
+	}
+
+	clearEntity(StreamEntityType_Player, id);
+}
+
+void StreamMatrix::onPlayerStreamIn(IPlayer& player, IPlayer& forPlayer)
+{
+	set(StreamEntityType_Player, forPlayer.getID(), player.getID(), true);
+}
+
+void StreamMatrix::onPlayerStreamOut(IPlayer& player, IPlayer& forPlayer)
+{
+	set(StreamEntityType_Player, forPlayer.getID(), player.getID(), false);
+}
+
+void StreamMatrix::onVehicleStreamIn(IVehicle& vehicle, IPlayer& player)
+{
+	set(StreamEntityType_Vehicle, player.getID(), vehicle.getID(), true);
+}
+
+void StreamMatrix::onVehicleStreamOut(IVehicle& vehicle, IPlayer& player)
+{
+	set(StreamEntityType_Vehicle, player.getID(), vehicle.getID(), false);
+}
+
+void StreamMatrix::onActorStreamIn(IActor& actor, IPlayer& forPlayer)
+{
+	set(StreamEntityType_Actor, forPlayer.getID(), actor.getID(), true);
+}
+
+void StreamMatrix::onActorStreamOut(IActor& actor, IPlayer& forPlayer)
+{
+	set(StreamEntityType_Actor, forPlayer.getID(), actor.getID(), false);
+}
+
+void StreamMatrix::onPoolEntryDestroyed(IVehicle& entry)
+{
+	// destroyed entities are not always streamed out through an event
+	clearEntity(StreamEntityType_Vehicle, entry.getID());
+}
+
+void StreamMatrix::onPoolEntryDestroyed(IActor& entry)
+{
+	clearEntity(StreamEntityType_Actor, entry.getID());
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/Actors/actors.hpp>
+#include <Server/Components/Vehicles/vehicles.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Impl;
+
+enum StreamEntityType : uint8_t
+{
+	StreamEntityType_Player,
+	StreamEntityType_Vehicle,
+	StreamEntityType_Actor,
+	StreamEntityType_Count,
+};
+
+/// entity streamed in or out for a player. layout is shared with the managed StreamChange struct
+struct StreamChange
+{
+	int32_t player;
+	int32_t entity;
+	bool streamedIn;
+};
+
+/// bitsets of the players, vehicles and actors streamed in for every player, maintained from the stream events. every
+/// entity type has a matrix of one row of 64-bit words per player in which bit N of the row is set if the entity with
+/// ID N is streamed in for the player; the memory of the matrices never moves. stream events are also collected into a
+/// list of changes per entity type which is published at the start of the tick of the component.
+class StreamMatrix final
+	: public PlayerConnectEventHandler
+	, public PlayerStreamEventHandler
+	, public VehicleEventHandler
+	, public ActorEventHandler
+	, public PoolEventHandler<IVehicle>
+	, public PoolEventHandler<IActor>
+{
+private:
+	struct Matrix
+	{
+		size_t entities;
+		size_t words;
+		std::vector<uint64_t> bits;
+		std::vector<StreamChange> pending;
+		std::vector<StreamChange> changes;
+	};
+
+	ICore* core_ = nullptr;
+	IVehiclesComponent* vehicles_ = nullptr;
+	IActorsComponent* actors_ = nullptr;
+	Matrix matrices_[StreamEntityType_Count];
+
+	Matrix* getMatrix(StreamEntityType type);
+
+	const Matrix* getMatrix(StreamEntityType type) const;
+
+	void set(StreamEntityType type, int player, int entity, bool streamedIn);
+
+	/// streams the entity out for every player for which it is streamed in
+	void clearEntity(StreamEntityType type, int entity);
+
+public:
+	StreamMatrix();
+
+	StreamMatrix(const StreamMatrix&) = delete;
+	StreamMatrix& operator=(const StreamMatrix&) = delete;
+
+	~StreamMatrix();
+
+	void attach(ICore* core, IComponentList* components);
+
+	void onFree(IComponent* component);
+
+	void detach();
+
+	/// publishes the changes collected since the previous call. must be called from the tick of the component
+	void publish();
+
+	/// matrix of the entity type or null if the type is invalid
+	const uint64_t* getBits(StreamEntityType type) const;
+
+	/// number of words in a row of the matrix
+	size_t getRowWords(StreamEntityType type) const;
+
+	/// row of the player or null if the type or player is invalid
+	const uint64_t* getRow(StreamEntityType type, int player) const;
+
+	bool isStreamedIn(StreamEntityType type, int player, int entity) const;
+
+	/// writes the bitset of the players for which the entity is streamed in, in the format accepted by the player
+	/// fan-out. returns the number of players
+	size_t getViewers(StreamEntityType type, int entity, uint64_t* output, size_t words) const;
+
+	/// changes of the entity type published at the start of the current tick in the order of the events
+	const StreamChange* getChanges(StreamEntityType type) const;
+
+	size_t getChangeCount(StreamEntityType type) const;
+
+	void onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason) override;
+
+	void onPlayerStreamIn(IPlayer& player, IPlayer& forPlayer) override;
+
+	void onPlayerStreamOut(IPlayer& player, IPlayer& forPlayer) override;
+
+	void onVehicleStreamIn(IVehicle& vehicle, IPlayer& player) override;
+
+	void onVehicleStreamOut(IVehicle& vehicle, IPlayer& player) override;
+
+	void onActorStreamIn(IActor& actor, IPlayer& forPlayer) override;
+
+	void onActorStreamOut(IActor& actor, IPlayer& forPlayer) override;
+
+	void onPoolEntryDestroyed(IVehicle& entry) override;
+
+	void onPoolEntryDestroyed(IActor& entry) override;
+};
@@ -0,0 +1,278 @@
+#include "sync-validator.hpp"
+
+#include <cmath>
+
+static float distance(const Vector3& a, const Vector3& b)
+{
+	const float x = a.x - b.x;
+	const float y = a.y - b.y;
+	const float z = a.z - b.z;
+	return std::sqrt(x * x + y * y + z * z);
+}
+
+static float length(const Vector3& v)
+{
+	return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+}
+
+SyncValidator::SyncValidator()
+{
+	config_.enabledRules = 0;
+	config_.rejectRules = 0;
+	config_.teleportDistance = 100.0f;
+	config_.teleportIntervalMilliseconds = 1000;
+	config_.healthTolerance = 0.0f;
+}
+
+SyncValidator::~SyncValidator()
+{
+	detach();
+}
+
+void SyncValidator::attach(ICore* core)
+{
+	core_ = core;
+
+	// run before any (managed) handler so dropped updates never reach them
+	core_->getPlayers().getPlayerUpdateDispatcher().addEventHandler(this, EventPriority_FairlyHigh);
+	core_->getPlayers().getPlayerSpawnDispatcher().addEventHandler(this);
+}
+
+void SyncValidator::detach()
+{
+	if (core_ != nullptr)
+	{
+		core_->getPlayers().getPlayerUpdateDispatcher().removeEventHandler(this);
+		core_->getPlayers().getPlayerSpawnDispatcher().removeEventHandler(this);
+		core_ = nullptr;
+	}
+}
+
+void SyncValidator::setConfig(const SyncValidatorConfig& config)
+{
+	config_ = config;
+}
+
+void SyncValidator::getConfig(SyncValidatorConfig& config) const
+{
+	config = config_;
+}
+
+void SyncValidator::setMaxVehicleSpeed(int model, float speed)
+{
+	const int index = model - MIN_VEHICLE_MODEL;
+	if (index >= 0 && index < MAX_VEHICLE_MODELS)
+	{
+		maxVehicleSpeed_[index] = speed;
+	}
+}
+
+float SyncValidator::getMaxVehicleSpeed(int model) const
+{
+	const int index = model - MIN_VEHICLE_MODEL;
+	if (index >= 0 && index < MAX_VEHICLE_MODELS)
+	{
+		return maxVehicleSpeed_[index];
+	}
+	return 0.0f;
+}
+
+void SyncValidator::setViolationHandler(sync_violation_fn handler)
+{
+	onViolation_ = handler;
+}
+
+SyncValidator::TrackedPlayer* SyncValidator::getTracked(int id)
+{
+	if (id < 0 || static_cast<size_t>(id) >= PLAYER_POOL_SIZE)
+	{
+		return nullptr;
+	}
+	return &players_[id];
+}
+
+void SyncValidator::setHealth(IPlayer& player, float health)
+{
+	if (TrackedPlayer* tracked = getTracked(player.getID()))
+	{
+		tracked->health = health;
+	}
+	player.setHealth(health);
+}
+
+void SyncValidator::setArmour(IPlayer& player, float armour)
+{
+	if (TrackedPlayer* tracked = getTracked(player.getID()))
+	{
+		tracked->armour = armour;
+	}
+	player.setArmour(armour);
+}
+
+void SyncValidator::setPosition(IPlayer& player, Vector3 position)
+{
+	if (TrackedPlayer* tracked = getTracked(player.getID()))
+	{
+		tracked->teleportGranted = true;
+	}
+	player.setPosition(position);
+}
+
+void SyncValidator::giveWeapon(IPlayer& player, WeaponSlotData weapon)
+{
+	if (TrackedPlayer* tracked = getTracked(player.getID()))
+	{
+		tracked->ammoGranted = true;
+	}
+	player.giveWeapon(weapon);
+}
+
+void SyncValidator::setWeaponAmmo(IPlayer& player, WeaponSlotData weapon)
+{
+	if (TrackedPlayer* tracked = getTracked(player.getID()))
+	{
+		tracked->ammoGranted = true;
+	}
+	player.setWeaponAmmo(weapon);
+}
+
+void SyncValidator::resetPlayer(IPlayer& player)
+{
+	if (TrackedPlayer* tracked = getTracked(player.getID()))
+	{
+		tracked->valid = false;
+	}
+}
+
+uint64_t SyncValidator::getViolationCount() const
+{
+	return violations_;
+}
+
+uint64_t SyncValidator::getRejectedCount() const
+{
+	return rejected_;
+}
+
+bool SyncValidator::report(IPlayer& player, SyncRule rule, int vehicleModel, int weapon, float observed, float limit)
+{
+	violations_++;
+
+	if (onViolation_ != nullptr)
+	{
+		const SyncViolation violation { player.getID(), rule, vehicleModel, weapon, observed, limit };
+		onViolation_(player, violation);
+	}
+
+	return (config_.rejectRules & rule) != 0;
+}
+
+bool SyncValidator::onPlayerUpdate(IPlayer& player, TimePoint now)
+{
+	const uint32_t rules = config_.enabledRules;
+	if (rules == 0)
+	{
+		return true;
+	}
+
+	TrackedPlayer* tracked = getTracked(player.getID());
+	if (tracked == nullptr)
+	{
+		return true;
+	}
+
+	const Vector3 position = player.getPosition();
+	const float health = player.getHealth();
+	const float armour = player.getArmour();
+	const uint8_t weapon = static_cast<uint8_t>(player.getArmedWeapon());
+	const uint32_t ammo = player.getArmedWeaponAmmo();
+
+	if (!tracked->valid)
+	{
+		*tracked = TrackedPlayer { true, position, now, health, armour, weapon, ammo, false, false };
+		return true;
+	}
+
+	bool reject = false;
+	int model = 0;
+
+	if ((rules & SyncRule_VehicleSpeed) && player.getState() == PlayerState_Driver)
+	{
+		IPlayerVehicleData* data = queryExtension<IPlayerVehicleData>(player);
+		IVehicle* vehicle = data ? data->getVehicle() : nullptr;
+
+		if (vehicle != nullptr)
+		{
+			model = vehicle->getModel();
+			const float limit = getMaxVehicleSpeed(model);
+			const float speed = length(vehicle->getVelocity());
+
+			if (limit > 0.0f && speed > limit)
+			{
+				reject |= report(player, SyncRule_VehicleSpeed, model, weapon, speed, limit);
+			}
+		}
+	}
+
+	if ((rules & SyncRule_Teleport) && !tracked->teleportGranted)
+	{
+		const auto elapsed = std::chrono::duration_cast<Milliseconds>(now - tracked->time).count();
+		const float moved = distance(position, tracked->position);
+
+		if (elapsed <= config_.teleportIntervalMilliseconds && moved > config_.teleportDistance)
+		{
+			reject |= report(player, SyncRule_Teleport, model, weapon, moved, config_.teleportDistance);
+		}
+	}
+
+	if ((rules & SyncRule_Weapon) && weapon != 0)
+	{
+		const WeaponSlots& slots = player.getWeapons();
+		bool owned = false;
+
+		for (const WeaponSlotData& slot : slots)
+		{
+			if (slot.id == weapon)
+			{
+				owned = true;
+				break;
+			}
+		}
+
+		if (!owned)
+		{
+			reject |= report(player, SyncRule_Weapon, model, weapon, static_cast<float>(weapon), 0.0f);
+		}
+	}
+
+	if ((rules & SyncRule_Ammo) && !tracked->ammoGranted && weapon == tracked->weapon && ammo > tracked->ammo)
+	{
+		reject |= report(player, SyncRule_Ammo, model, weapon, static_cast<float>(ammo), static_cast<float>(tracked->ammo));
+	}
+
+	if ((rules & SyncRule_Health) && health > tracked->health + config_.healthTolerance)
+	{
+		reject |= report(player, SyncRule_Health, model, weapon, health, tracked->health);
+	}
+
+	if ((rules & SyncRule_Armour) && armour > tracked->armour + config_.healthTolerance)
+	{
+		reject |= report(player, SyncRule_Armour, model, weapon, armour, tracked->armour);
+	}
+
+	if (reject)
+	{
+		rejected_++;
+		tracked->time = now;
+		return false;
+	}
+
+	*tracked = TrackedPlayer { true, position, now, health, armour, weapon, ammo, false, false };
+	return true;
+}
+
+void SyncValidator::onPlayerSpawn(IPlayer& player)
+{
+	// spawning restores health and weapons and moves the player
+	resetPlayer(player);
+}
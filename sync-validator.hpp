@@ -0,0 +1,128 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/Vehicles/vehicles.hpp>
+
+#include <cstdint>
+
+#include "dotnet/coreclr_delegates.h"
+
+using namespace Impl;
+
+enum SyncRule : uint32_t
+{
+	SyncRule_VehicleSpeed = 1 << 0,
+	SyncRule_Teleport = 1 << 1,
+	SyncRule_Weapon = 1 << 2,
+	SyncRule_Ammo = 1 << 3,
+	SyncRule_Health = 1 << 4,
+	SyncRule_Armour = 1 << 5,
+};
+
+/// configuration of the sync validator. layout is shared with the managed SyncValidatorConfig struct
+struct SyncValidatorConfig
+{
+	/// rules which are checked
+	uint32_t enabledRules;
+	/// rules of which a violation causes the update to be dropped
+	uint32_t rejectRules;
+	/// maximum distance a player may move between two updates within teleportInterval
+	float teleportDistance;
+	uint32_t teleportIntervalMilliseconds;
+	/// health/armour a client may gain without a server-side cause (e.g. vending machines)
+	float healthTolerance;
+};
+
+/// violation escalated to managed code. layout is shared with the managed SyncViolation struct
+struct SyncViolation
+{
+	int playerId;
+	SyncRule rule;
+	int vehicleModel;
+	int weapon;
+	float observed;
+	float limit;
+};
+
+typedef void (CORECLR_DELEGATE_CALLTYPE *sync_violation_fn)(IPlayer&, const SyncViolation&);
+
+/// validates player and driver sync natively on every player update. only violations are escalated to managed code.
+/// server-side causes of health, armour, ammo and position changes must be routed through the validator (set* and
+/// give* functions) so they are not reported.
+class SyncValidator final
+	: public PlayerUpdateEventHandler
+	, public PlayerSpawnEventHandler
+{
+private:
+	static constexpr int MIN_VEHICLE_MODEL = 400;
+
+	struct TrackedPlayer
+	{
+		bool valid;
+		Vector3 position;
+		TimePoint time;
+		float health;
+		float armour;
+		uint8_t weapon;
+		uint32_t ammo;
+		bool teleportGranted;
+		bool ammoGranted;
+	};
+
+	ICore* core_ = nullptr;
+	SyncValidatorConfig config_;
+	float maxVehicleSpeed_[MAX_VEHICLE_MODELS] {};
+	TrackedPlayer players_[PLAYER_POOL_SIZE] {};
+	sync_violation_fn onViolation_ = nullptr;
+	uint64_t violations_ = 0;
+	uint64_t rejected_ = 0;
+
+	/// reports a violation; returns true if the update should be dropped
+	bool report(IPlayer& player, SyncRule rule, int vehicleModel, int weapon, float observed, float limit);
+
+	TrackedPlayer* getTracked(int id);
+
+public:
+	SyncValidator();
+
+	SyncValidator(const SyncValidator&) = delete;
+	SyncValidator& operator=(const SyncValidator&) = delete;
+
+	~SyncValidator();
+
+	void attach(ICore* core);
+
+	void detach();
+
+	void setConfig(const SyncValidatorConfig& config);
+
+	void getConfig(SyncValidatorConfig& config) const;
+
+	/// sets the maximum velocity magnitude of a vehicle model. a speed of 0 disables the check for the model
+	void setMaxVehicleSpeed(int model, float speed);
+
+	float getMaxVehicleSpeed(int model) const;
+
+	void setViolationHandler(sync_violation_fn handler);
+
+	void setHealth(IPlayer& player, float health);
+
+	void setArmour(IPlayer& player, float armour);
+
+	void setPosition(IPlayer& player, Vector3 position);
+
+	void giveWeapon(IPlayer& player, WeaponSlotData weapon);
+
+	void setWeaponAmmo(IPlayer& player, WeaponSlotData weapon);
+
+	/// discards the tracked state of the player; the next update becomes the new baseline
+	void resetPlayer(IPlayer& player);
+
+	uint64_t getViolationCount() const;
+
+	uint64_t getRejectedCount() const;
+
+	bool onPlayerUpdate(IPlayer& player, TimePoint now) override;
+
+	void onPlayerSpawn(IPlayer& player) override;
+};
@@ -0,0 +1,198 @@
+#include "text-dedupe-cache.hpp"
+
+#include <algorithm>
+
+/// 64-bit FNV-1a hash of the text; never returns the unknown hash
+static uint64_t hashText(StringView text)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < text.size(); i++)
+	{
+		hash ^= static_cast<uint8_t>(text[i]);
+		hash *= 1099511628211ull;
+	}
+	return hash == 0 ? 1 : hash;
+}
+
+TextDedupeCache::~TextDedupeCache()
+{
+	detach();
+}
+
+void TextDedupeCache::attach(ICore* core, IComponentList* components)
+{
+	core_ = core;
+	core_->getPlayers().getPlayerConnectDispatcher().addEventHandler(this);
+
+	textDraws_ = components->queryComponent<ITextDrawsComponent>();
+	if (textDraws_ != nullptr)
+	{
+		textDraws_->getPoolEventDispatcher().addEventHandler(this);
+	}
+}
+
+void TextDedupeCache::onFree(IComponent* component)
+{
+	if (component == textDraws_)
+	{
+		textDraws_ = nullptr;
+		clear();
+	}
+}
+
+void TextDedupeCache::detach()
+{
+	if (core_ != nullptr)
+	{
+		core_->getPlayers().getPlayerConnectDispatcher().removeEventHandler(this);
+		core_ = nullptr;
+	}
+
+	if (textDraws_ != nullptr)
+	{
+		textDraws_->getPoolEventDispatcher().removeEventHandler(this);
+		textDraws_ = nullptr;
+	}
+
+	clear();
+}
+
+void TextDedupeCache::clear()
+{
+	for (auto& sent : sent_)
+	{
+		sent.reset();
+	}
+}
+
+void TextDedupeCache::setEnabled(bool enabled)
+{
+	if (!enabled)
+	{
+		clear();
+	}
+	enabled_ = enabled;
+}
+
+bool TextDedupeCache::isEnabled() const
+{
+	return enabled_;
+}
+
+int TextDedupeCache::getGlobalID(ITextDrawBase& textDraw) const
+{
+	if (textDraws_ == nullptr)
+	{
+		return -1;
+	}
+
+	// player textdraws share IDs with global textdraws; only the pool entry itself is a global textdraw
+	const int id = textDraw.getID();
+	ITextDraw* global = textDraws_->get(id);
+	return global != nullptr && static_cast<ITextDrawBase*>(global) == &textDraw ? id : -1;
+}
+
+bool TextDedupeCache::shouldSend(ITextDraw& textDraw, IPlayer& player, StringView text)
+{
+	if (!enabled_)
+	{
+		return true;
+	}
+
+	const int id = textDraw.getID();
+	const int playerId = player.getID();
+	if (id < 0 || id >= static_cast<int>(TEXTDRAW_POOL_SIZE) || playerId < 0 || playerId >= static_cast<int>(PLAYER_POOL_SIZE))
+	{
+		return true;
+	}
+
+	std::unique_ptr<uint64_t[]>& sent = sent_[id];
+	if (!sent)
+	{
+		sent.reset(new uint64_t[PLAYER_POOL_SIZE]());
+	}
+
+	const uint64_t hash = hashText(text);
+	if (sent[playerId] == hash)
+	{
+		stats_.textDrawsSuppressed++;
+		return false;
+	}
+
+	sent[playerId] = hash;
+	stats_.textDrawsSent++;
+	return true;
+}
+
+bool TextDedupeCache::shouldSet(ITextLabelBase& label, StringView text)
+{
+	if (!enabled_)
+	{
+		return true;
+	}
+
+	if (label.getText() == text)
+	{
+		stats_.labelsSuppressed++;
+		return false;
+	}
+
+	stats_.labelsSent++;
+	return true;
+}
+
+void TextDedupeCache::invalidate(ITextDraw& textDraw, IPlayer& player)
+{
+	const int id = textDraw.getID();
+	const int playerId = player.getID();
+	if (id >= 0 && id < static_cast<int>(TEXTDRAW_POOL_SIZE) && playerId >= 0 && playerId < static_cast<int>(PLAYER_POOL_SIZE) && sent_[id])
+	{
+		sent_[id][playerId] = UNKNOWN;
+	}
+}
+
+void TextDedupeCache::invalidate(ITextDrawBase& textDraw)
+{
+	const int id = getGlobalID(textDraw);
+	if (id >= 0 && id < static_cast<int>(TEXTDRAW_POOL_SIZE) && sent_[id])
+	{
+		std::fill_n(sent_[id].get(), PLAYER_POOL_SIZE, UNKNOWN);
+	}
+}
+
+void TextDedupeCache::getStats(TextDedupeStats& stats) const
+{
+	stats = stats_;
+}
+
+void TextDedupeCache::resetStats()
+{
+	stats_ = TextDedupeStats {};
+}
+
+void TextDedupeCache::onPoolEntryDestroyed(ITextDraw& textDraw)
+{
+	const int id = textDraw.getID();
+	if (id >= 0 && id < static_cast<int>(TEXTDRAW_POOL_SIZE))
+	{
+		// the ID is reused by the next textdraw
+		sent_[id].reset();
+	}
+}
+
+void TextDedupeCache::onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason)
+{
+	const int playerId = player.getID();
+	if (playerId < 0 || playerId >= static_cast<int>(PLAYER_POOL_SIZE))
+	{
+		return;
+	}
+
+	for (auto& sent : sent_)
+	{
+		if (sent)
+		{
+			sent[playerId] = UNKNOWN;
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/TextDraws/textdraws.hpp>
+#include <Server/Components/TextLabels/textlabels.hpp>
+
+#include <cstdint>
+#include <memory>
+
+using namespace Impl;
+
+/// statistics of the text dedupe cache. layout is shared with the managed TextDedupeStats struct
+struct TextDedupeStats
+{
+	uint64_t textDrawsSent;
+	uint64_t textDrawsSuppressed;
+	uint64_t labelsSent;
+	uint64_t labelsSuppressed;
+};
+
+/// suppresses text updates which would not change the text shown to a player. per-player textdraw text is not stored
+/// by the server, so a hash of the text last sent to each player is kept; it is invalidated when the textdraw is shown,
+/// restreamed, changed globally or destroyed. text labels store their text, so label updates are compared to the current
+/// text and clients streaming a label in always receive it. the cache is disabled by default.
+class TextDedupeCache final
+	: public PoolEventHandler<ITextDraw>
+	, public PlayerConnectEventHandler
+{
+private:
+	/// hash of a textdraw without a known per-player text
+	static constexpr uint64_t UNKNOWN = 0;
+
+	ICore* core_ = nullptr;
+	ITextDrawsComponent* textDraws_ = nullptr;
+	bool enabled_ = false;
+	/// per textdraw ID, the hash of the text last sent to each player ID; allocated on first use
+	std::unique_ptr<uint64_t[]> sent_[TEXTDRAW_POOL_SIZE];
+	TextDedupeStats stats_ {};
+
+	/// returns the ID of the textdraw if it is in the global pool, otherwise -1
+	int getGlobalID(ITextDrawBase& textDraw) const;
+
+	void clear();
+
+public:
+	TextDedupeCache() = default;
+
+	TextDedupeCache(const TextDedupeCache&) = delete;
+	TextDedupeCache& operator=(const TextDedupeCache&) = delete;
+
+	~TextDedupeCache();
+
+	void attach(ICore* core, IComponentList* components);
+
+	void onFree(IComponent* component);
+
+	void detach();
+
+	void setEnabled(bool enabled);
+
+	bool isEnabled() const;
+
+	/// returns true if the text must be sent to the player. records the text as sent
+	bool shouldSend(ITextDraw& textDraw, IPlayer& player, StringView text);
+
+	/// returns true if the text differs from the current text of the label
+	bool shouldSet(ITextLabelBase& label, StringView text);
+
+	/// forgets the text sent to the player; the next text is always sent
+	void invalidate(ITextDraw& textDraw, IPlayer& player);
+
+	/// forgets the text sent to all players if the textdraw is a global textdraw
+	void invalidate(ITextDrawBase& textDraw);
+
+	void getStats(TextDedupeStats& stats) const;
+
+	void resetStats();
+
+	void onPoolEntryDestroyed(ITextDraw& textDraw) override;
+
+	void onPlayerDisconnect(IPlayer& player, PeerDisconnectReason reason) override;
+};
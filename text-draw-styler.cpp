@@ -0,0 +1,166 @@
+#include "text-draw-styler.hpp"
+#include "sampsharp-component.hpp"
+
+static bool equals(const Vector2& a, const Vector2& b)
+{
+	return a.x == b.x && a.y == b.y;
+}
+
+static bool equals(const Vector3& a, const Vector3& b)
+{
+	return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+static bool equals(const Colour& a, const Colour& b)
+{
+	return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+bool TextDrawStyler::apply(ITextDrawBase& textDraw, const TextDrawAppearance& appearance)
+{
+	const uint32_t fields = appearance.fields;
+	bool changed = false;
+
+	if ((fields & TextDrawField_Position) && !equals(textDraw.getPosition(), appearance.position))
+	{
+		textDraw.setPosition(appearance.position);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_LetterSize) && !equals(textDraw.getLetterSize(), appearance.letterSize))
+	{
+		textDraw.setLetterSize(appearance.letterSize);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_TextSize) && !equals(textDraw.getTextSize(), appearance.textSize))
+	{
+		textDraw.setTextSize(appearance.textSize);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_Alignment) && textDraw.getAlignment() != appearance.alignment)
+	{
+		textDraw.setAlignment(static_cast<TextDrawAlignmentTypes>(appearance.alignment));
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_LetterColour) && !equals(textDraw.getLetterColour(), appearance.letterColour))
+	{
+		textDraw.setColour(appearance.letterColour);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_Box) && textDraw.hasBox() != appearance.box)
+	{
+		textDraw.useBox(appearance.box);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_BoxColour) && !equals(textDraw.getBoxColour(), appearance.boxColour))
+	{
+		textDraw.setBoxColour(appearance.boxColour);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_Shadow) && textDraw.getShadow() != appearance.shadow)
+	{
+		textDraw.setShadow(appearance.shadow);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_Outline) && textDraw.getOutline() != appearance.outline)
+	{
+		textDraw.setOutline(appearance.outline);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_BackgroundColour) && !equals(textDraw.getBackgroundColour(), appearance.backgroundColour))
+	{
+		textDraw.setBackgroundColour(appearance.backgroundColour);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_Style) && textDraw.getStyle() != appearance.style)
+	{
+		textDraw.setStyle(static_cast<TextDrawStyle>(appearance.style));
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_Proportional) && textDraw.isProportional() != appearance.proportional)
+	{
+		textDraw.setProportional(appearance.proportional);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_Selectable) && textDraw.isSelectable() != appearance.selectable)
+	{
+		textDraw.setSelectable(appearance.selectable);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_PreviewModel) && textDraw.getPreviewModel() != appearance.previewModel)
+	{
+		textDraw.setPreviewModel(appearance.previewModel);
+		changed = true;
+	}
+
+	if ((fields & TextDrawField_PreviewRotation) && !equals(textDraw.getPreviewRotation(), appearance.previewRotation))
+	{
+		textDraw.setPreviewRotation(appearance.previewRotation);
+		changed = true;
+	}
+
+	if (fields & TextDrawField_PreviewVehicleColour)
+	{
+		const Pair<int, int> colours = textDraw.getPreviewVehicleColour();
+		if (colours.first != appearance.previewVehicleColour1 || colours.second != appearance.previewVehicleColour2)
+		{
+			textDraw.setPreviewVehicleColour(appearance.previewVehicleColour1, appearance.previewVehicleColour2);
+			changed = true;
+		}
+	}
+
+	if ((fields & TextDrawField_PreviewZoom) && textDraw.getPreviewZoom() != appearance.previewZoom)
+	{
+		textDraw.setPreviewZoom(appearance.previewZoom);
+		changed = true;
+	}
+
+	applied_++;
+
+	if (!changed)
+	{
+		return false;
+	}
+
+	// the setters only update the server-side state; clients see the changes when the textdraw is shown again
+	// the restream resends the text, so the text cached by the dedupe cache is no longer what the clients show
+	textDraw.restream();
+	SampSharpComponent::getInstance()->getTextDedupeCache().invalidate(textDraw);
+	restreamed_++;
+	return true;
+}
+
+size_t TextDrawStyler::applyBatch(ITextDrawBase* const* textDraws, size_t count, const TextDrawAppearance& appearance)
+{
+	size_t restreamed = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (textDraws[i] != nullptr && apply(*textDraws[i], appearance))
+		{
+			restreamed++;
+		}
+	}
+	return restreamed;
+}
+
+uint64_t TextDrawStyler::getAppliedCount() const
+{
+	return applied_;
+}
+
+uint64_t TextDrawStyler::getRestreamedCount() const
+{
+	return restreamed_;
+}
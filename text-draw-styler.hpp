@@ -0,0 +1,77 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/TextDraws/textdraws.hpp>
+
+#include <cstdint>
+
+using namespace Impl;
+
+enum TextDrawField : uint32_t
+{
+	TextDrawField_Position = 1 << 0,
+	TextDrawField_LetterSize = 1 << 1,
+	TextDrawField_TextSize = 1 << 2,
+	TextDrawField_Alignment = 1 << 3,
+	TextDrawField_LetterColour = 1 << 4,
+	TextDrawField_Box = 1 << 5,
+	TextDrawField_BoxColour = 1 << 6,
+	TextDrawField_Shadow = 1 << 7,
+	TextDrawField_Outline = 1 << 8,
+	TextDrawField_BackgroundColour = 1 << 9,
+	TextDrawField_Style = 1 << 10,
+	TextDrawField_Proportional = 1 << 11,
+	TextDrawField_Selectable = 1 << 12,
+	TextDrawField_PreviewModel = 1 << 13,
+	TextDrawField_PreviewRotation = 1 << 14,
+	TextDrawField_PreviewVehicleColour = 1 << 15,
+	TextDrawField_PreviewZoom = 1 << 16,
+};
+
+/// packed appearance of a textdraw; only the fields in the mask are applied. layout is shared with the managed
+/// TextDrawAppearance struct
+struct TextDrawAppearance
+{
+	/// TextDrawField flags of the fields to apply
+	uint32_t fields;
+	Vector2 position;
+	Vector2 letterSize;
+	Vector2 textSize;
+	Colour letterColour;
+	Colour boxColour;
+	Colour backgroundColour;
+	Vector3 previewRotation;
+	float previewZoom;
+	int alignment;
+	int shadow;
+	int outline;
+	int style;
+	int previewModel;
+	int previewVehicleColour1;
+	int previewVehicleColour2;
+	bool box;
+	bool proportional;
+	bool selectable;
+};
+
+/// applies the appearance of textdraws in a single call. textdraws are restreamed once, and only if an applied field
+/// differs from the current value.
+class TextDrawStyler final
+{
+private:
+	uint64_t applied_ = 0;
+	uint64_t restreamed_ = 0;
+
+public:
+	/// applies the appearance to the textdraw. returns true if the textdraw was restreamed
+	bool apply(ITextDrawBase& textDraw, const TextDrawAppearance& appearance);
+
+	/// applies the appearance to each of the textdraws. returns the number of restreamed textdraws
+	size_t applyBatch(ITextDrawBase* const* textDraws, size_t count, const TextDrawAppearance& appearance);
+
+	/// number of textdraws the appearance was applied to
+	uint64_t getAppliedCount() const;
+
+	/// number of textdraws restreamed by an applied appearance
+	uint64_t getRestreamedCount() const;
+};
@@ -0,0 +1,98 @@
+#include "tick-arena.hpp"
+
+#include <algorithm>
+
+static size_t alignUp(size_t size, size_t alignment)
+{
+	return (size + alignment - 1) & ~(alignment - 1);
+}
+
+TickArena::TickArena(size_t chunk_size)
+	: chunkSize_(alignUp(std::max(chunk_size, static_cast<size_t>(4096)), ALIGNMENT))
+{
+}
+
+uint8_t* TickArena::allocate(size_t size)
+{
+	const size_t aligned = alignUp(std::max(size, static_cast<size_t>(1)), ALIGNMENT);
+	stats_.allocations++;
+	stats_.used += aligned;
+	stats_.peakUsed = std::max(stats_.peakUsed, stats_.used);
+
+	if (aligned > chunkSize_ / 2)
+	{
+		// large allocations would waste most of a chunk; they are not shrunk by commit
+		large_.push_back({ std::make_unique<uint8_t[]>(aligned), aligned });
+		stats_.largeAllocations++;
+		stats_.reserved += aligned;
+		last_ = nullptr;
+		return large_.back().data.get();
+	}
+
+	if (chunk_ < chunks_.size() && offset_ + aligned > chunks_[chunk_].size)
+	{
+		chunk_++;
+		offset_ = 0;
+	}
+
+	if (chunk_ == chunks_.size())
+	{
+		chunks_.push_back({ std::make_unique<uint8_t[]>(chunkSize_), chunkSize_ });
+		stats_.reserved += chunkSize_;
+		offset_ = 0;
+	}
+
+	uint8_t* data = chunks_[chunk_].data.get() + offset_;
+	offset_ += aligned;
+	last_ = data;
+	lastSize_ = aligned;
+	return data;
+}
+
+bool TickArena::commit(size_t used)
+{
+	if (last_ == nullptr)
+	{
+		return false;
+	}
+
+	const size_t aligned = alignUp(used, ALIGNMENT);
+	if (aligned > lastSize_)
+	{
+		return false;
+	}
+
+	offset_ -= lastSize_ - aligned;
+	stats_.used -= lastSize_ - aligned;
+	lastSize_ = aligned;
+	return true;
+}
+
+void TickArena::reset()
+{
+	for (const Chunk& chunk : large_)
+	{
+		stats_.reserved -= chunk.size;
+	}
+	large_.clear();
+
+	chunk_ = 0;
+	offset_ = 0;
+	last_ = nullptr;
+	lastSize_ = 0;
+	stats_.used = 0;
+	stats_.resets++;
+}
+
+void TickArena::getStats(TickArenaStats& stats) const
+{
+	stats = stats_;
+}
+
+void TickArena::resetStats()
+{
+	stats_.allocations = 0;
+	stats_.largeAllocations = 0;
+	stats_.peakUsed = stats_.used;
+	stats_.resets = 0;
+}
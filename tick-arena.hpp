@@ -0,0 +1,69 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace Impl;
+
+/// statistics of the tick arena. layout is shared with the managed TickArenaStats struct
+struct TickArenaStats
+{
+	uint64_t allocations;
+	/// allocations which did not fit in a chunk and were given a chunk of their own
+	uint64_t largeAllocations;
+	/// bytes allocated since the last reset
+	uint64_t used;
+	uint64_t peakUsed;
+	/// bytes of memory held by the arena
+	uint64_t reserved;
+	uint64_t resets;
+};
+
+/// bump allocator for short-lived native copies of managed data such as strings. memory allocated from the arena is
+/// valid until the arena is reset at the end of the tick of the component, so managed code can encode text directly
+/// into native memory instead of allocating and pinning a buffer per call. chunks are kept across ticks; chunks given to
+/// large allocations are released on reset. must only be used from the server thread.
+class TickArena final
+{
+private:
+	static constexpr size_t ALIGNMENT = 16;
+
+	struct Chunk
+	{
+		std::unique_ptr<uint8_t[]> data;
+		size_t size;
+	};
+
+	size_t chunkSize_;
+	std::vector<Chunk> chunks_;
+	std::vector<Chunk> large_;
+	size_t chunk_ = 0;
+	size_t offset_ = 0;
+	/// start and size of the most recent allocation, which may be shrunk by commit
+	uint8_t* last_ = nullptr;
+	size_t lastSize_ = 0;
+	TickArenaStats stats_ {};
+
+public:
+	explicit TickArena(size_t chunk_size);
+
+	TickArena(const TickArena&) = delete;
+	TickArena& operator=(const TickArena&) = delete;
+
+	/// returns size bytes of memory valid until the next reset, aligned to 16 bytes
+	uint8_t* allocate(size_t size);
+
+	/// shrinks the most recent allocation to used bytes; lets text be encoded into an allocation of its maximum encoded
+	/// size. returns false if used is larger than the allocation
+	bool commit(size_t used);
+
+	/// releases all allocations. called at the end of the tick of the component
+	void reset();
+
+	void getStats(TickArenaStats& stats) const;
+
+	void resetStats();
+};
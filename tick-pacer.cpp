@@ -0,0 +1,192 @@
+#include "tick-pacer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static uint32_t getInterval(uint32_t rate)
+{
+	return rate > 0 ? 1000000 / rate : 0;
+}
+
+TickPacer::TickPacer()
+{
+	config_.targetRate = 0;
+	config_.idleRate = 20;
+	config_.minSleepMicroseconds = 500;
+	config_.maxSleepMicroseconds = 50000;
+	config_.deadbandMicroseconds = 250;
+	config_.backlogThreshold = 512;
+	config_.idleTicks = 200;
+}
+
+/// the sleep of the core in microseconds, which is configured in milliseconds
+static uint32_t getConfiguredSleep(IConfig& config)
+{
+	const float* sleep = config.getFloat("sleep");
+	return sleep != nullptr && *sleep > 0.0f ? static_cast<uint32_t>(std::lround(*sleep * 1000.0f)) : 5000;
+}
+
+void TickPacer::attach(ICore* core)
+{
+	core_ = core;
+
+	// the work of the first ticks is measured against the sleep the core actually uses. the sleep and dynamic ticks
+	// of the core are saved once so disabling the pacer restores them rather than a sleep the pacer chose
+	IConfig& config = core_->getConfig();
+	const bool* dynTicks = config.getBool("use_dyn_ticks");
+	originalSleep_ = getConfiguredSleep(config);
+	originalDynTicks_ = dynTicks == nullptr || *dynTicks;
+	stats_.sleepMicroseconds = originalSleep_;
+}
+
+void TickPacer::detach()
+{
+	core_ = nullptr;
+}
+
+void TickPacer::setConfig(const TickPacerConfig& config)
+{
+	const uint32_t previous = config_.targetRate;
+	config_ = config;
+
+	if (config_.maxSleepMicroseconds < config_.minSleepMicroseconds)
+	{
+		config_.maxSleepMicroseconds = config_.minSleepMicroseconds;
+	}
+
+	if (core_ == nullptr)
+	{
+		return;
+	}
+
+	if (config_.targetRate == 0)
+	{
+		if (previous != 0)
+		{
+			core_->useDynTicks(originalDynTicks_);
+			core_->setThreadSleep(Microseconds(originalSleep_));
+			stats_.sleepMicroseconds = originalSleep_;
+		}
+		stats_.mode = TickPacerMode_Disabled;
+		return;
+	}
+
+	if (previous == 0)
+	{
+		core_->useDynTicks(false);
+		stats_.mode = TickPacerMode_Active;
+		idleCount_ = 0;
+		sampled_ = false;
+	}
+}
+
+void TickPacer::getConfig(TickPacerConfig& config) const
+{
+	config = config_;
+}
+
+void TickPacer::getStats(TickPacerStats& stats) const
+{
+	stats = stats_;
+}
+
+uint32_t TickPacer::sampleBacklog() const
+{
+	uint64_t backlog = 0;
+	for (INetwork* network : core_->getNetworks())
+	{
+		const NetworkStats stats = network->getStatistics();
+		backlog += stats.messageSendBuffer + stats.messagesOnResendQueue;
+	}
+	return static_cast<uint32_t>(std::min<uint64_t>(backlog, UINT32_MAX));
+}
+
+void TickPacer::apply(uint32_t sleep)
+{
+	core_->setThreadSleep(Microseconds(sleep));
+	stats_.sleepMicroseconds = sleep;
+	stats_.adjustments++;
+}
+
+void TickPacer::tick(Microseconds elapsed)
+{
+	if (core_ == nullptr || config_.targetRate == 0)
+	{
+		return;
+	}
+
+	stats_.ticks++;
+
+	const float interval = static_cast<float>(elapsed.count());
+	const float work = std::max(0.0f, interval - stats_.sleepMicroseconds);
+
+	if (!sampled_)
+	{
+		stats_.intervalMicroseconds = interval;
+		stats_.workMicroseconds = work;
+		stats_.backlog = sampleBacklog();
+		sampled_ = true;
+	}
+	else
+	{
+		stats_.intervalMicroseconds += (interval - stats_.intervalMicroseconds) * SMOOTHING;
+		stats_.workMicroseconds += (work - stats_.workMicroseconds) * SMOOTHING;
+
+		// network statistics are collected from every peer, so the backlog is not sampled every tick
+		if (stats_.ticks % BACKLOG_SAMPLE_TICKS == 0)
+		{
+			stats_.backlog = sampleBacklog();
+		}
+	}
+
+	const TickPacerMode previous = stats_.mode;
+	TickPacerMode mode = previous == TickPacerMode_Disabled ? TickPacerMode_Active : previous;
+
+	// boosting starts above the threshold and only ends below half of it
+	const uint32_t threshold = config_.backlogThreshold;
+	if (threshold != 0 && stats_.backlog > threshold)
+	{
+		mode = TickPacerMode_Boost;
+	}
+	else if (mode == TickPacerMode_Boost && (threshold == 0 || stats_.backlog < threshold / 2))
+	{
+		mode = TickPacerMode_Active;
+	}
+
+	// idling starts after a number of idle ticks and ends as soon as anything happens
+	const bool idle = stats_.backlog == 0 && core_->getPlayers().entries().empty();
+	idleCount_ = idle ? idleCount_ + 1 : 0;
+	if (mode != TickPacerMode_Boost)
+	{
+		mode = idleCount_ > config_.idleTicks ? TickPacerMode_Idle : TickPacerMode_Active;
+	}
+
+	if (mode != previous)
+	{
+		if (mode == TickPacerMode_Idle)
+		{
+			stats_.idleTransitions++;
+		}
+		else if (mode == TickPacerMode_Boost)
+		{
+			stats_.boostTransitions++;
+		}
+	}
+	stats_.mode = mode;
+
+	const uint32_t target = getInterval(mode == TickPacerMode_Idle ? config_.idleRate : config_.targetRate);
+	stats_.targetIntervalMicroseconds = target;
+
+	uint32_t desired = config_.minSleepMicroseconds;
+	if (mode != TickPacerMode_Boost)
+	{
+		const float remainder = static_cast<float>(target) - stats_.workMicroseconds;
+		desired = static_cast<uint32_t>(std::clamp(remainder, static_cast<float>(config_.minSleepMicroseconds), static_cast<float>(config_.maxSleepMicroseconds)));
+	}
+
+	const uint32_t difference = desired > stats_.sleepMicroseconds ? desired - stats_.sleepMicroseconds : stats_.sleepMicroseconds - desired;
+	if (mode != previous || difference > config_.deadbandMicroseconds)
+	{
+		apply(desired);
+	}
+}
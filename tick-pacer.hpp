@@ -0,0 +1,99 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <cstdint>
+
+using namespace Impl;
+
+enum TickPacerMode : uint32_t
+{
+	TickPacerMode_Disabled,
+	/// the sleep is adjusted to hold the target rate
+	TickPacerMode_Active,
+	/// no players are connected and no messages are queued; the sleep is adjusted to hold the idle rate
+	TickPacerMode_Idle,
+	/// the network backlog exceeds the threshold; the minimum sleep is used
+	TickPacerMode_Boost,
+};
+
+/// configuration of the tick pacer. layout is shared with the managed TickPacerConfig struct
+struct TickPacerConfig
+{
+	/// ticks per second to hold while the server is not idle; 0 disables the pacer
+	uint32_t targetRate;
+	/// ticks per second to hold while the server is idle
+	uint32_t idleRate;
+	uint32_t minSleepMicroseconds;
+	uint32_t maxSleepMicroseconds;
+	/// the sleep is only changed if it differs more than this from the desired sleep
+	uint32_t deadbandMicroseconds;
+	/// queued network messages above which the pacer boosts until the backlog falls below half of it; 0 disables
+	/// boosting
+	uint32_t backlogThreshold;
+	/// consecutive idle ticks before the pacer switches to the idle rate
+	uint32_t idleTicks;
+};
+
+/// decisions of the tick pacer. layout is shared with the managed TickPacerStats struct
+struct TickPacerStats
+{
+	uint64_t ticks;
+	/// number of times the sleep was changed
+	uint64_t adjustments;
+	uint64_t idleTransitions;
+	uint64_t boostTransitions;
+	TickPacerMode mode;
+	uint32_t sleepMicroseconds;
+	uint32_t targetIntervalMicroseconds;
+	/// queued network messages at the last sample
+	uint32_t backlog;
+	/// smoothed time between ticks
+	float intervalMicroseconds;
+	/// smoothed time between ticks minus the sleep
+	float workMicroseconds;
+};
+
+/// adjusts the thread sleep of the core to the load of the server. the time between ticks minus the sleep estimates
+/// the work of a tick; the sleep is set to the remainder of the target interval within the configured bounds. a
+/// deadband, an idle delay and a boost which lasts until the backlog halves keep the sleep from oscillating. dynamic
+/// ticks are disabled while the pacer is enabled because it compensates for the work itself.
+class TickPacer final
+{
+private:
+	static constexpr float SMOOTHING = 0.1f;
+	static constexpr uint64_t BACKLOG_SAMPLE_TICKS = 16;
+
+	ICore* core_ = nullptr;
+	TickPacerConfig config_;
+	TickPacerStats stats_ {};
+	uint32_t idleCount_ = 0;
+	bool sampled_ = false;
+	/// sleep and dynamic ticks of the core before the pacer changed them
+	uint32_t originalSleep_ = 0;
+	bool originalDynTicks_ = true;
+
+	uint32_t sampleBacklog() const;
+
+	void apply(uint32_t sleep);
+
+public:
+	TickPacer();
+
+	TickPacer(const TickPacer&) = delete;
+	TickPacer& operator=(const TickPacer&) = delete;
+
+	void attach(ICore* core);
+
+	void detach();
+
+	/// applies the configuration. disabling the pacer restores the sleep and dynamic ticks of the core configuration
+	void setConfig(const TickPacerConfig& config);
+
+	void getConfig(TickPacerConfig& config) const;
+
+	void getStats(TickPacerStats& stats) const;
+
+	/// measures the tick and adjusts the sleep. must be called from the tick of the component
+	void tick(Microseconds elapsed);
+};
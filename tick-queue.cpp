@@ -0,0 +1,151 @@
+#include "tick-queue.hpp"
+
+#include <chrono>
+
+int64_t TickQueue::now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TickQueue::TickQueue(size_t capacity, size_t max_per_tick)
+	: maxPerTick_(max_per_tick)
+{
+	size_t size = 2;
+	while (size < capacity)
+	{
+		size <<= 1;
+	}
+
+	cells_ = std::make_unique<Cell[]>(size);
+	mask_ = size - 1;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		cells_[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+bool TickQueue::enqueue(tick_queue_fn fn, void* payload)
+{
+	if (fn == nullptr)
+	{
+		return false;
+	}
+
+	Cell* cell;
+	size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+
+	for (;;)
+	{
+		cell = &cells_[pos & mask_];
+		const size_t seq = cell->sequence.load(std::memory_order_acquire);
+		const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+		if (diff == 0)
+		{
+			if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			// the consumer has not yet released this cell; the queue is full
+			rejected_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		else
+		{
+			pos = enqueuePos_.load(std::memory_order_relaxed);
+		}
+	}
+
+	cell->fn = fn;
+	cell->payload = payload;
+	cell->enqueuedAt = now();
+	cell->sequence.store(pos + 1, std::memory_order_release);
+
+	return true;
+}
+
+size_t TickQueue::drain()
+{
+	const int64_t start = now();
+
+	// items enqueued by the callbacks themselves are deferred to the next tick
+	size_t end = enqueuePos_.load(std::memory_order_acquire);
+	if (maxPerTick_ != 0 && end - dequeuePos_ > maxPerTick_)
+	{
+		end = dequeuePos_ + maxPerTick_;
+	}
+
+	const uint64_t depth = end - dequeuePos_;
+	if (depth > peakDepth_)
+	{
+		peakDepth_ = depth;
+	}
+
+	size_t count = 0;
+	while (dequeuePos_ != end)
+	{
+		Cell& cell = cells_[dequeuePos_ & mask_];
+		const size_t seq = cell.sequence.load(std::memory_order_acquire);
+
+		if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeuePos_ + 1) < 0)
+		{
+			// a producer claimed this cell but has not yet published its item
+			break;
+		}
+
+		const tick_queue_fn fn = cell.fn;
+		void* const payload = cell.payload;
+		const uint64_t wait = static_cast<uint64_t>(now() - cell.enqueuedAt);
+
+		cell.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+		dequeuePos_++;
+
+		totalWait_ += wait;
+		if (wait > maxWait_)
+		{
+			maxWait_ = wait;
+		}
+
+		fn(payload);
+		count++;
+	}
+
+	drained_ += count;
+	lastDrain_ = static_cast<uint64_t>(now() - start);
+
+	return count;
+}
+
+size_t TickQueue::depth() const
+{
+	return enqueuePos_.load(std::memory_order_relaxed) - dequeuePos_;
+}
+
+size_t TickQueue::capacity() const
+{
+	return mask_ + 1;
+}
+
+void TickQueue::getStats(TickQueueStats& stats) const
+{
+	stats.enqueued = enqueuePos_.load(std::memory_order_relaxed);
+	stats.drained = drained_;
+	stats.rejected = rejected_.load(std::memory_order_relaxed);
+	stats.depth = depth();
+	stats.peakDepth = peakDepth_;
+	stats.totalWaitNanoseconds = totalWait_;
+	stats.maxWaitNanoseconds = maxWait_;
+	stats.lastDrainNanoseconds = lastDrain_;
+}
+
+void TickQueue::resetStats()
+{
+	rejected_.store(0, std::memory_order_relaxed);
+	peakDepth_ = 0;
+	totalWait_ = 0;
+	maxWait_ = 0;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <sdk.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "dotnet/coreclr_delegates.h"
+
+typedef void (CORECLR_DELEGATE_CALLTYPE *tick_queue_fn)(void*);
+
+/// statistics of the tick queue. layout is shared with the managed TickQueueStats struct
+struct TickQueueStats
+{
+	uint64_t enqueued;
+	uint64_t drained;
+	uint64_t rejected;
+	uint64_t depth;
+	uint64_t peakDepth;
+	uint64_t totalWaitNanoseconds;
+	uint64_t maxWaitNanoseconds;
+	uint64_t lastDrainNanoseconds;
+};
+
+/// bounded lock-free multi-producer single-consumer queue of (function, payload) items. any thread may enqueue an
+/// item, the items are invoked on the server thread when the queue is drained during the tick of the component.
+class TickQueue final
+{
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		tick_queue_fn fn;
+		void* payload;
+		int64_t enqueuedAt;
+	};
+
+	std::unique_ptr<Cell[]> cells_;
+	size_t mask_ = 0;
+	size_t maxPerTick_ = 0;
+
+	alignas(64) std::atomic<size_t> enqueuePos_ { 0 };
+	alignas(64) size_t dequeuePos_ = 0;
+
+	std::atomic<uint64_t> rejected_ { 0 };
+	uint64_t drained_ = 0;
+	uint64_t peakDepth_ = 0;
+	uint64_t totalWait_ = 0;
+	uint64_t maxWait_ = 0;
+	uint64_t lastDrain_ = 0;
+
+	static int64_t now();
+
+public:
+	/// capacity is rounded up to the next power of two. max_per_tick of 0 drains all items available at the start of the drain.
+	TickQueue(size_t capacity, size_t max_per_tick);
+
+	TickQueue(const TickQueue&) = delete;
+	TickQueue& operator=(const TickQueue&) = delete;
+
+	/// enqueues an item; safe to call from any thread. returns false if the queue is full
+	bool enqueue(tick_queue_fn fn, void* payload);
+
+	/// invokes the queued items on the calling thread. must only be called from the server thread
+	size_t drain();
+
+	size_t depth() const;
+
+	size_t capacity() const;
+
+	void getStats(TickQueueStats& stats) const;
+
+	void resetStats();
+};
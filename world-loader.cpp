@@ -0,0 +1,262 @@
+#include "world-loader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "mapped-file.hpp"
+
+static int64_t nanosecondsSince(TimePoint start)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// reads the strings of a world file; ranges outside the string block resolve to an empty string
+class WorldStrings
+{
+private:
+	const char* data_;
+	size_t size_;
+
+public:
+	WorldStrings(const uint8_t* data, size_t size)
+		: data_(reinterpret_cast<const char*>(data))
+		, size_(size)
+	{
+	}
+
+	bool valid(const WorldString& string) const
+	{
+		return string.offset <= size_ && string.length <= size_ - string.offset;
+	}
+
+	StringView get(const WorldString& string) const
+	{
+		return valid(string) ? StringView(data_ + string.offset, string.length) : StringView();
+	}
+};
+
+/// tracks the IDs of the created entities of a type
+static void addId(WorldIdRange& range, std::vector<int>& ids, int id)
+{
+	range.first = range.created == 0 ? id : std::min(range.first, id);
+	range.last = range.created == 0 ? id : std::max(range.last, id);
+	range.created++;
+	ids.push_back(id);
+}
+
+void WorldLoader::attach(IComponentList* components)
+{
+	objects_ = components->queryComponent<IObjectsComponent>();
+	vehicles_ = components->queryComponent<IVehiclesComponent>();
+	pickups_ = components->queryComponent<IPickupsComponent>();
+	labels_ = components->queryComponent<ITextLabelsComponent>();
+}
+
+void WorldLoader::onFree(IComponent* component)
+{
+	if (component == objects_)
+	{
+		objects_ = nullptr;
+	}
+	else if (component == vehicles_)
+	{
+		vehicles_ = nullptr;
+	}
+	else if (component == pickups_)
+	{
+		pickups_ = nullptr;
+	}
+	else if (component == labels_)
+	{
+		labels_ = nullptr;
+	}
+}
+
+void WorldLoader::detach()
+{
+	objects_ = nullptr;
+	vehicles_ = nullptr;
+	pickups_ = nullptr;
+	labels_ = nullptr;
+}
+
+bool WorldLoader::load(StringView path, WorldLoadResult& result)
+{
+	const TimePoint start = std::chrono::steady_clock::now();
+
+	result = WorldLoadResult {};
+	for (WorldIdRange& range : result.ranges)
+	{
+		range.first = -1;
+		range.last = -1;
+	}
+
+	for (std::vector<int>& ids : ids_)
+	{
+		ids.clear();
+	}
+
+	MappedFile file;
+	if (!file.open(path.to_string()))
+	{
+		result.status = WorldLoadStatus_OpenFailed;
+		return false;
+	}
+
+	WorldFileHeader header;
+	if (file.size() < sizeof(header))
+	{
+		result.status = WorldLoadStatus_InvalidHeader;
+		return false;
+	}
+
+	memcpy(&header, file.data(), sizeof(header));
+	if (header.magic != WORLD_FILE_MAGIC || header.version != WORLD_FILE_VERSION)
+	{
+		result.status = WorldLoadStatus_InvalidHeader;
+		return false;
+	}
+
+	// sections follow the header in a fixed order; all record sizes are multiples of 4 so the records are aligned
+	const uint64_t objectsOffset = sizeof(header);
+	const uint64_t materialsOffset = objectsOffset + uint64_t(header.objects) * sizeof(WorldObjectRecord);
+	const uint64_t vehiclesOffset = materialsOffset + uint64_t(header.materials) * sizeof(WorldMaterialRecord);
+	const uint64_t pickupsOffset = vehiclesOffset + uint64_t(header.vehicles) * sizeof(WorldVehicleRecord);
+	const uint64_t labelsOffset = pickupsOffset + uint64_t(header.pickups) * sizeof(WorldPickupRecord);
+	const uint64_t stringsOffset = labelsOffset + uint64_t(header.labels) * sizeof(WorldLabelRecord);
+
+	if (stringsOffset + header.strings > file.size())
+	{
+		result.status = WorldLoadStatus_Truncated;
+		return false;
+	}
+
+	const uint8_t* data = file.data();
+	const WorldStrings strings(data + stringsOffset, header.strings);
+	result.mapNanoseconds = nanosecondsSince(start);
+
+	// objects
+	TimePoint section = std::chrono::steady_clock::now();
+	WorldIdRange& objects = result.ranges[WorldEntityType_Object];
+	auto objectRecords = reinterpret_cast<const WorldObjectRecord*>(data + objectsOffset);
+	objectRecords_.assign(header.objects, nullptr);
+
+	for (uint32_t i = 0; i < header.objects; i++)
+	{
+		const WorldObjectRecord& record = objectRecords[i];
+		IObject* object = objects_ ? objects_->create(record.model, record.position, record.rotation, record.drawDistance) : nullptr;
+		if (object == nullptr)
+		{
+			objects.failed++;
+			continue;
+		}
+
+		objectRecords_[i] = object;
+		addId(objects, ids_[WorldEntityType_Object], object->getID());
+	}
+
+	auto materialRecords = reinterpret_cast<const WorldMaterialRecord*>(data + materialsOffset);
+	for (uint32_t i = 0; i < header.materials; i++)
+	{
+		const WorldMaterialRecord& record = materialRecords[i];
+		IObject* object = record.object < header.objects ? objectRecords_[record.object] : nullptr;
+		if (object != nullptr && strings.valid(record.textureLibrary) && strings.valid(record.textureName))
+		{
+			object->setMaterial(record.slot, record.model, strings.get(record.textureLibrary), strings.get(record.textureName), record.colour);
+			result.materials++;
+		}
+	}
+
+	objectRecords_.clear();
+	objects.nanoseconds = nanosecondsSince(section);
+
+	// vehicles
+	section = std::chrono::steady_clock::now();
+	WorldIdRange& vehicles = result.ranges[WorldEntityType_Vehicle];
+	auto vehicleRecords = reinterpret_cast<const WorldVehicleRecord*>(data + vehiclesOffset);
+
+	for (uint32_t i = 0; i < header.vehicles; i++)
+	{
+		const WorldVehicleRecord& record = vehicleRecords[i];
+		IVehicle* vehicle = vehicles_
+			? vehicles_->create(record.isStatic != 0, record.model, record.position, record.angle, record.colour1, record.colour2, Seconds(record.respawnDelay), record.siren != 0)
+			: nullptr;
+		if (vehicle == nullptr)
+		{
+			vehicles.failed++;
+			continue;
+		}
+
+		if (record.virtualWorld != 0)
+		{
+			vehicle->setVirtualWorld(record.virtualWorld);
+		}
+		if (record.interior != 0)
+		{
+			vehicle->setInterior(record.interior);
+		}
+		addId(vehicles, ids_[WorldEntityType_Vehicle], vehicle->getID());
+	}
+
+	vehicles.nanoseconds = nanosecondsSince(section);
+
+	// pickups
+	section = std::chrono::steady_clock::now();
+	WorldIdRange& pickups = result.ranges[WorldEntityType_Pickup];
+	auto pickupRecords = reinterpret_cast<const WorldPickupRecord*>(data + pickupsOffset);
+
+	for (uint32_t i = 0; i < header.pickups; i++)
+	{
+		const WorldPickupRecord& record = pickupRecords[i];
+		IPickup* pickup = pickups_ ? pickups_->create(record.model, record.type, record.position, record.virtualWorld, record.isStatic != 0) : nullptr;
+		if (pickup == nullptr)
+		{
+			pickups.failed++;
+			continue;
+		}
+
+		addId(pickups, ids_[WorldEntityType_Pickup], pickup->getID());
+	}
+
+	pickups.nanoseconds = nanosecondsSince(section);
+
+	// labels
+	section = std::chrono::steady_clock::now();
+	WorldIdRange& labels = result.ranges[WorldEntityType_Label];
+	auto labelRecords = reinterpret_cast<const WorldLabelRecord*>(data + labelsOffset);
+
+	for (uint32_t i = 0; i < header.labels; i++)
+	{
+		const WorldLabelRecord& record = labelRecords[i];
+		ITextLabel* label = labels_ && strings.valid(record.text)
+			? labels_->create(strings.get(record.text), record.colour, record.position, record.drawDistance, record.virtualWorld, record.testLOS != 0)
+			: nullptr;
+		if (label == nullptr)
+		{
+			labels.failed++;
+			continue;
+		}
+
+		addId(labels, ids_[WorldEntityType_Label], label->getID());
+	}
+
+	labels.nanoseconds = nanosecondsSince(section);
+
+	result.status = WorldLoadStatus_Ok;
+	result.totalNanoseconds = nanosecondsSince(start);
+	return true;
+}
+
+size_t WorldLoader::copyIds(WorldEntityType type, int* ids, size_t capacity) const
+{
+	if (type < 0 || type >= WorldEntityType_Count)
+	{
+		return 0;
+	}
+
+	const std::vector<int>& source = ids_[type];
+	const size_t count = std::min(capacity, source.size());
+	std::copy_n(source.data(), count, ids);
+	return count;
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/Objects/objects.hpp>
+#include <Server/Components/Pickups/pickups.hpp>
+#include <Server/Components/TextLabels/textlabels.hpp>
+#include <Server/Components/Vehicles/vehicles.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Impl;
+
+//
+// binary world file: a WorldFileHeader followed by the object, material, vehicle, pickup and label records and a block
+// of UTF-8 strings referenced by the records. all values are little-endian. the layouts are shared with the managed
+// WorldFileWriter.
+//
+
+constexpr uint32_t WORLD_FILE_MAGIC = 0x46575353; // "SSWF"
+constexpr uint16_t WORLD_FILE_VERSION = 1;
+
+struct WorldFileHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t reserved;
+	uint32_t objects;
+	uint32_t materials;
+	uint32_t vehicles;
+	uint32_t pickups;
+	uint32_t labels;
+	/// size of the string block in bytes
+	uint32_t strings;
+};
+
+/// range of the string block
+struct WorldString
+{
+	uint32_t offset;
+	uint32_t length;
+};
+
+struct WorldObjectRecord
+{
+	int32_t model;
+	Vector3 position;
+	Vector3 rotation;
+	float drawDistance;
+};
+
+struct WorldMaterialRecord
+{
+	/// index of the object record
+	uint32_t object;
+	uint32_t slot;
+	int32_t model;
+	WorldString textureLibrary;
+	WorldString textureName;
+	Colour colour;
+};
+
+struct WorldVehicleRecord
+{
+	int32_t model;
+	Vector3 position;
+	float angle;
+	int32_t colour1;
+	int32_t colour2;
+	int32_t respawnDelay;
+	int32_t virtualWorld;
+	int32_t interior;
+	uint8_t siren;
+	uint8_t isStatic;
+	uint8_t reserved[2];
+};
+
+struct WorldPickupRecord
+{
+	int32_t model;
+	Vector3 position;
+	uint32_t virtualWorld;
+	uint8_t type;
+	uint8_t isStatic;
+	uint8_t reserved[2];
+};
+
+struct WorldLabelRecord
+{
+	WorldString text;
+	Colour colour;
+	Vector3 position;
+	float drawDistance;
+	int32_t virtualWorld;
+	uint8_t testLOS;
+	uint8_t reserved[3];
+};
+
+enum WorldEntityType : int
+{
+	WorldEntityType_Object,
+	WorldEntityType_Vehicle,
+	WorldEntityType_Pickup,
+	WorldEntityType_Label,
+	WorldEntityType_Count
+};
+
+enum WorldLoadStatus : int
+{
+	WorldLoadStatus_Ok,
+	WorldLoadStatus_OpenFailed,
+	WorldLoadStatus_InvalidHeader,
+	WorldLoadStatus_Truncated,
+};
+
+/// entities of a type created by a load. layout is shared with the managed WorldIdRange struct
+struct WorldIdRange
+{
+	/// lowest and highest ID of the created entities or -1 if none were created
+	int32_t first;
+	int32_t last;
+	uint32_t created;
+	/// records of which the entity could not be created (e.g. pool full or component not loaded)
+	uint32_t failed;
+	uint64_t nanoseconds;
+};
+
+/// result of a load. layout is shared with the managed WorldLoadResult struct
+struct WorldLoadResult
+{
+	WorldLoadStatus status;
+	uint32_t materials;
+	WorldIdRange ranges[WorldEntityType_Count];
+	/// time spent mapping and validating the file
+	uint64_t mapNanoseconds;
+	uint64_t totalNanoseconds;
+};
+
+/// creates the entities of a binary world file in one native pass over the memory-mapped file. the IDs of the entities
+/// created by the last load are kept until the next load.
+class WorldLoader final
+{
+private:
+	IObjectsComponent* objects_ = nullptr;
+	IVehiclesComponent* vehicles_ = nullptr;
+	IPickupsComponent* pickups_ = nullptr;
+	ITextLabelsComponent* labels_ = nullptr;
+	std::vector<int> ids_[WorldEntityType_Count];
+	std::vector<IObject*> objectRecords_;
+
+public:
+	WorldLoader() = default;
+
+	WorldLoader(const WorldLoader&) = delete;
+	WorldLoader& operator=(const WorldLoader&) = delete;
+
+	void attach(IComponentList* components);
+
+	void onFree(IComponent* component);
+
+	void detach();
+
+	bool load(StringView path, WorldLoadResult& result);
+
+	/// copies the IDs of the entities of the type created by the last load. returns the number of IDs copied
+	size_t copyIds(WorldEntityType type, int* ids, size_t capacity) const;
+};
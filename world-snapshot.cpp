@@ -0,0 +1,632 @@
+#include "world-snapshot.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "mapped-file.hpp"
+
+#ifdef WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static int64_t nanosecondsSince(TimePoint start)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// replaces the file at path with the file at source. the rename is written to the disk before returning, so a crash
+/// leaves either the previous or the new file in place
+static bool replaceFile(const std::string& source, const std::string& path)
+{
+#ifdef WIN32
+	return MoveFileExA(source.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	if (std::rename(source.c_str(), path.c_str()) != 0)
+	{
+		return false;
+	}
+
+	// the rename is an entry of the directory, which is only durable once the directory is synced
+	const size_t separator = path.find_last_of('/');
+	const std::string directory = separator == std::string::npos ? "." : separator == 0 ? "/" : path.substr(0, separator);
+	const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	const bool synced = fsync(fd) == 0;
+	::close(fd);
+	return synced;
+#endif
+}
+
+static bool validString(const WorldString& string, size_t size)
+{
+	return string.offset <= size && string.length <= size - string.offset;
+}
+
+static StringView getString(const char* strings, size_t size, const WorldString& string)
+{
+	return validString(string, size) ? StringView(strings + string.offset, string.length) : StringView();
+}
+
+/// maps the ID at the time of the snapshot to the ID of the restored entity
+static void addRestoredId(WorldIdRange& range, std::vector<int>& ids, int oldId, int id)
+{
+	range.first = range.created == 0 ? id : std::min(range.first, id);
+	range.last = range.created == 0 ? id : std::max(range.last, id);
+	range.created++;
+
+	if (oldId >= 0)
+	{
+		if (static_cast<size_t>(oldId) >= ids.size())
+		{
+			ids.resize(oldId + 1, -1);
+		}
+		ids[oldId] = id;
+	}
+}
+
+WorldString WorldSnapshot::Snapshot::addString(StringView string)
+{
+	const WorldString result { static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(string.size()) };
+	strings.append(string.data(), string.size());
+	return result;
+}
+
+void WorldSnapshot::Snapshot::clear()
+{
+	vehicles.clear();
+	objects.clear();
+	materials.clear();
+	labels.clear();
+	strings.clear();
+}
+
+WorldSnapshot::~WorldSnapshot()
+{
+	stop();
+}
+
+void WorldSnapshot::attach(IComponentList* components)
+{
+	objects_ = components->queryComponent<IObjectsComponent>();
+	vehicles_ = components->queryComponent<IVehiclesComponent>();
+	labels_ = components->queryComponent<ITextLabelsComponent>();
+}
+
+void WorldSnapshot::onFree(IComponent* component)
+{
+	if (component == objects_)
+	{
+		objects_ = nullptr;
+	}
+	else if (component == vehicles_)
+	{
+		vehicles_ = nullptr;
+	}
+	else if (component == labels_)
+	{
+		labels_ = nullptr;
+	}
+}
+
+void WorldSnapshot::detach()
+{
+	stop();
+	objects_ = nullptr;
+	vehicles_ = nullptr;
+	labels_ = nullptr;
+}
+
+bool WorldSnapshot::start(StringView path, uint32_t interval)
+{
+	if (worker_.joinable() || path.empty())
+	{
+		return false;
+	}
+
+	path_ = path.to_string();
+	interval_ = Seconds(interval);
+	next_ = std::chrono::steady_clock::now() + interval_;
+	running_ = true;
+	worker_ = std::thread(&WorldSnapshot::run, this);
+	return true;
+}
+
+void WorldSnapshot::stop()
+{
+	if (!worker_.joinable())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		running_ = false;
+	}
+	wake_.notify_one();
+	worker_.join();
+}
+
+bool WorldSnapshot::isRunning() const
+{
+	return worker_.joinable();
+}
+
+void WorldSnapshot::capture()
+{
+	capture_.clear();
+	capture_.created = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+	if (vehicles_ != nullptr)
+	{
+		for (IVehicle* vehicle : *vehicles_)
+		{
+			const VehicleSpawnData& spawn = vehicle->getSpawnData();
+			const IntPair colour = vehicle->getColour();
+
+			WorldSnapshotVehicle record {};
+			record.id = vehicle->getID();
+			record.model = spawn.modelID;
+			record.spawnPosition = spawn.position;
+			record.spawnAngle = spawn.zRotation;
+			record.spawnColour1 = spawn.colour1;
+			record.spawnColour2 = spawn.colour2;
+			record.respawnDelay = static_cast<int32_t>(spawn.respawnDelay.count());
+			record.siren = spawn.siren;
+			record.position = vehicle->getPosition();
+			record.angle = vehicle->getZAngle();
+			record.health = vehicle->getHealth();
+			record.colour1 = colour.first;
+			record.colour2 = colour.second;
+			record.paintJob = vehicle->getPaintJob();
+			record.virtualWorld = vehicle->getVirtualWorld();
+			record.interior = vehicle->getInterior();
+			vehicle->getDamageStatus(record.panels, record.doors, record.lights, record.tyres);
+
+			for (size_t slot = 0; slot < WORLD_SNAPSHOT_COMPONENT_SLOTS; slot++)
+			{
+				record.components[slot] = vehicle->getComponentInSlot(static_cast<int>(slot));
+			}
+
+			record.plate = capture_.addString(vehicle->getPlate());
+			capture_.vehicles.push_back(record);
+		}
+	}
+
+	if (objects_ != nullptr)
+	{
+		for (IObject* object : *objects_)
+		{
+			WorldSnapshotObject record {};
+			record.id = object->getID();
+			record.model = object->getModel();
+			record.position = object->getPosition();
+			record.rotation = object->getRotation().ToEuler();
+			record.drawDistance = object->getDrawDistance();
+			record.virtualWorld = object->getVirtualWorld();
+
+			if (object->isMoving())
+			{
+				const ObjectMoveData& move = object->getMovingData();
+				record.moving = 1;
+				record.targetPosition = move.targetPos;
+				record.targetRotation = move.targetRot;
+				record.speed = move.speed;
+			}
+
+			const uint32_t index = static_cast<uint32_t>(capture_.objects.size());
+			capture_.objects.push_back(record);
+
+			for (uint32_t slot = 0; slot < WORLD_SNAPSHOT_MATERIAL_SLOTS; slot++)
+			{
+				const ObjectMaterialData* data = nullptr;
+				if (!object->getMaterialData(slot, data) || data == nullptr || !data->used)
+				{
+					continue;
+				}
+
+				WorldSnapshotMaterial material {};
+				material.object = index;
+				material.slot = slot;
+				material.type = static_cast<uint8_t>(data->type);
+				material.materialColour = data->materialColour;
+				material.backgroundColour = data->backgroundColour;
+				material.textOrTXD = capture_.addString(StringView(data->textOrTXD.data(), data->textOrTXD.length()));
+				material.fontOrTexture = capture_.addString(StringView(data->fontOrTexture.data(), data->fontOrTexture.length()));
+
+				if (data->type == ObjectMaterialData::Type::Text)
+				{
+					material.materialSize = data->materialSize;
+					material.fontSize = data->fontSize;
+					material.alignment = data->alignment;
+					material.bold = data->bold;
+				}
+				else
+				{
+					material.model = data->model;
+				}
+
+				capture_.materials.push_back(material);
+			}
+		}
+	}
+
+	if (labels_ != nullptr)
+	{
+		for (ITextLabel* label : *labels_)
+		{
+			WorldSnapshotLabel record {};
+			record.id = label->getID();
+			record.text = capture_.addString(label->getText());
+			record.colour = label->getColour();
+			record.position = label->getPosition();
+			record.drawDistance = label->getDrawDistance();
+			record.virtualWorld = label->getVirtualWorld();
+			record.testLOS = label->getTestLOS();
+			capture_.labels.push_back(record);
+		}
+	}
+}
+
+bool WorldSnapshot::save()
+{
+	if (!worker_.joinable())
+	{
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (busy_)
+		{
+			stats_.skipped++;
+			return false;
+		}
+	}
+
+	const TimePoint start = std::chrono::steady_clock::now();
+	capture();
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stats_.captureNanoseconds = nanosecondsSince(start);
+
+		// the buffers are swapped so both keep their capacity for the next snapshot
+		std::swap(capture_, job_);
+		pending_ = true;
+		busy_ = true;
+	}
+	wake_.notify_one();
+	return true;
+}
+
+void WorldSnapshot::run()
+{
+	std::unique_lock<std::mutex> lock(mutex_);
+
+	while (true)
+	{
+		wake_.wait(lock, [this] { return pending_ || !running_; });
+		if (!pending_)
+		{
+			break;
+		}
+
+		// the job is not touched by the server thread while it is busy
+		pending_ = false;
+		lock.unlock();
+
+		const TimePoint start = std::chrono::steady_clock::now();
+		size_t bytes = 0;
+		const bool written = write(job_, bytes);
+
+		lock.lock();
+		busy_ = false;
+		stats_.writeNanoseconds = nanosecondsSince(start);
+
+		if (!written)
+		{
+			stats_.failed++;
+			continue;
+		}
+
+		stats_.snapshots++;
+		stats_.bytes = bytes;
+		stats_.vehicles = static_cast<uint32_t>(job_.vehicles.size());
+		stats_.objects = static_cast<uint32_t>(job_.objects.size());
+		stats_.materials = static_cast<uint32_t>(job_.materials.size());
+		stats_.labels = static_cast<uint32_t>(job_.labels.size());
+	}
+}
+
+bool WorldSnapshot::write(const Snapshot& snapshot, size_t& bytes)
+{
+	WorldSnapshotHeader header {};
+	header.magic = WORLD_SNAPSHOT_MAGIC;
+	header.version = WORLD_SNAPSHOT_VERSION;
+	header.created = snapshot.created;
+	header.vehicles = static_cast<uint32_t>(snapshot.vehicles.size());
+	header.objects = static_cast<uint32_t>(snapshot.objects.size());
+	header.materials = static_cast<uint32_t>(snapshot.materials.size());
+	header.labels = static_cast<uint32_t>(snapshot.labels.size());
+	header.strings = static_cast<uint32_t>(snapshot.strings.size());
+
+	const size_t vehicles = snapshot.vehicles.size() * sizeof(WorldSnapshotVehicle);
+	const size_t objects = snapshot.objects.size() * sizeof(WorldSnapshotObject);
+	const size_t materials = snapshot.materials.size() * sizeof(WorldSnapshotMaterial);
+	const size_t labels = snapshot.labels.size() * sizeof(WorldSnapshotLabel);
+	bytes = sizeof(header) + vehicles + objects + materials + labels + snapshot.strings.size();
+
+	// the previous snapshot stays in place until the new one is complete
+	const std::string temporary = path_ + ".tmp";
+	MappedFile file;
+	if (!file.create(temporary, bytes))
+	{
+		return false;
+	}
+
+	uint8_t* data = file.data();
+	memcpy(data, &header, sizeof(header));
+	data += sizeof(header);
+	memcpy(data, snapshot.vehicles.data(), vehicles);
+	data += vehicles;
+	memcpy(data, snapshot.objects.data(), objects);
+	data += objects;
+	memcpy(data, snapshot.materials.data(), materials);
+	data += materials;
+	memcpy(data, snapshot.labels.data(), labels);
+	data += labels;
+	memcpy(data, snapshot.strings.data(), snapshot.strings.size());
+
+	// the contents must be on the disk before the rename, or a crash could replace the previous snapshot with an
+	// incomplete one
+	const bool flushed = file.flush();
+	if (!file.close() || !flushed)
+	{
+		std::remove(temporary.c_str());
+		return false;
+	}
+
+	return replaceFile(temporary, path_);
+}
+
+bool WorldSnapshot::restore(StringView path, WorldLoadResult& result)
+{
+	const TimePoint start = std::chrono::steady_clock::now();
+
+	result = WorldLoadResult {};
+	for (WorldIdRange& range : result.ranges)
+	{
+		range.first = -1;
+		range.last = -1;
+	}
+
+	for (std::vector<int>& ids : restoredIds_)
+	{
+		ids.clear();
+	}
+
+	MappedFile file;
+	if (!file.open(path.to_string()))
+	{
+		result.status = WorldLoadStatus_OpenFailed;
+		return false;
+	}
+
+	WorldSnapshotHeader header;
+	if (file.size() < sizeof(header))
+	{
+		result.status = WorldLoadStatus_InvalidHeader;
+		return false;
+	}
+
+	memcpy(&header, file.data(), sizeof(header));
+	if (header.magic != WORLD_SNAPSHOT_MAGIC || header.version != WORLD_SNAPSHOT_VERSION)
+	{
+		result.status = WorldLoadStatus_InvalidHeader;
+		return false;
+	}
+
+	// all record sizes are multiples of 4 so the records are aligned
+	const uint64_t vehiclesOffset = sizeof(header);
+	const uint64_t objectsOffset = vehiclesOffset + uint64_t(header.vehicles) * sizeof(WorldSnapshotVehicle);
+	const uint64_t materialsOffset = objectsOffset + uint64_t(header.objects) * sizeof(WorldSnapshotObject);
+	const uint64_t labelsOffset = materialsOffset + uint64_t(header.materials) * sizeof(WorldSnapshotMaterial);
+	const uint64_t stringsOffset = labelsOffset + uint64_t(header.labels) * sizeof(WorldSnapshotLabel);
+
+	if (stringsOffset + header.strings > file.size())
+	{
+		result.status = WorldLoadStatus_Truncated;
+		return false;
+	}
+
+	const uint8_t* data = file.data();
+	const char* strings = reinterpret_cast<const char*>(data + stringsOffset);
+	result.mapNanoseconds = nanosecondsSince(start);
+
+	// vehicles are created from their spawn data and then given the state at the time of the snapshot
+	TimePoint section = std::chrono::steady_clock::now();
+	WorldIdRange& vehicles = result.ranges[WorldEntityType_Vehicle];
+	auto vehicleRecords = reinterpret_cast<const WorldSnapshotVehicle*>(data + vehiclesOffset);
+
+	for (uint32_t i = 0; i < header.vehicles; i++)
+	{
+		const WorldSnapshotVehicle& record = vehicleRecords[i];
+		IVehicle* vehicle = vehicles_
+			? vehicles_->create(false, record.model, record.spawnPosition, record.spawnAngle, record.spawnColour1, record.spawnColour2, Seconds(record.respawnDelay), record.siren != 0)
+			: nullptr;
+		if (vehicle == nullptr)
+		{
+			vehicles.failed++;
+			continue;
+		}
+
+		if (record.interior != 0)
+		{
+			vehicle->setInterior(record.interior);
+		}
+		if (record.virtualWorld != 0)
+		{
+			vehicle->setVirtualWorld(record.virtualWorld);
+		}
+
+		vehicle->setPosition(record.position);
+		vehicle->setZAngle(record.angle);
+		vehicle->setHealth(record.health);
+
+		if (record.colour1 != record.spawnColour1 || record.colour2 != record.spawnColour2)
+		{
+			vehicle->setColour(record.colour1, record.colour2);
+		}
+
+		// only paint jobs 0 to 2 exist; other values mean the vehicle has none
+		if (record.paintJob >= 0 && record.paintJob <= 2)
+		{
+			vehicle->setPaintJob(record.paintJob);
+		}
+
+		for (int32_t component : record.components)
+		{
+			if (component > 0)
+			{
+				vehicle->addComponent(component);
+			}
+		}
+
+		if (record.panels != 0 || record.doors != 0 || record.lights != 0 || record.tyres != 0)
+		{
+			vehicle->setDamageStatus(record.panels, record.doors, static_cast<uint8_t>(record.lights), static_cast<uint8_t>(record.tyres), nullptr);
+		}
+
+		if (record.plate.length != 0 && validString(record.plate, header.strings))
+		{
+			vehicle->setPlate(getString(strings, header.strings, record.plate));
+		}
+
+		addRestoredId(vehicles, restoredIds_[WorldEntityType_Vehicle], record.id, vehicle->getID());
+	}
+
+	vehicles.nanoseconds = nanosecondsSince(section);
+
+	// objects
+	section = std::chrono::steady_clock::now();
+	WorldIdRange& objects = result.ranges[WorldEntityType_Object];
+	auto objectRecords = reinterpret_cast<const WorldSnapshotObject*>(data + objectsOffset);
+	std::vector<IObject*> created(header.objects, nullptr);
+
+	for (uint32_t i = 0; i < header.objects; i++)
+	{
+		const WorldSnapshotObject& record = objectRecords[i];
+		IObject* object = objects_ ? objects_->create(record.model, record.position, record.rotation, record.drawDistance) : nullptr;
+		if (object == nullptr)
+		{
+			objects.failed++;
+			continue;
+		}
+
+		if (record.virtualWorld != 0)
+		{
+			object->setVirtualWorld(record.virtualWorld);
+		}
+
+		if (record.moving != 0)
+		{
+			ObjectMoveData move;
+			move.targetPos = record.targetPosition;
+			move.targetRot = record.targetRotation;
+			move.speed = record.speed;
+			object->move(move);
+		}
+
+		created[i] = object;
+		addRestoredId(objects, restoredIds_[WorldEntityType_Object], record.id, object->getID());
+	}
+
+	auto materialRecords = reinterpret_cast<const WorldSnapshotMaterial*>(data + materialsOffset);
+	for (uint32_t i = 0; i < header.materials; i++)
+	{
+		const WorldSnapshotMaterial& record = materialRecords[i];
+		IObject* object = record.object < header.objects ? created[record.object] : nullptr;
+		if (object == nullptr || !validString(record.textOrTXD, header.strings) || !validString(record.fontOrTexture, header.strings))
+		{
+			continue;
+		}
+
+		const StringView textOrTXD = getString(strings, header.strings, record.textOrTXD);
+		const StringView fontOrTexture = getString(strings, header.strings, record.fontOrTexture);
+
+		if (record.type == static_cast<uint8_t>(ObjectMaterialData::Type::Text))
+		{
+			object->setMaterialText(record.slot, textOrTXD, static_cast<ObjectMaterialSize>(record.materialSize), fontOrTexture, record.fontSize, record.bold != 0,
+				record.materialColour, record.backgroundColour, static_cast<ObjectMaterialTextAlign>(record.alignment));
+		}
+		else
+		{
+			object->setMaterial(record.slot, record.model, textOrTXD, fontOrTexture, record.materialColour);
+		}
+		result.materials++;
+	}
+
+	objects.nanoseconds = nanosecondsSince(section);
+
+	// labels
+	section = std::chrono::steady_clock::now();
+	WorldIdRange& labels = result.ranges[WorldEntityType_Label];
+	auto labelRecords = reinterpret_cast<const WorldSnapshotLabel*>(data + labelsOffset);
+
+	for (uint32_t i = 0; i < header.labels; i++)
+	{
+		const WorldSnapshotLabel& record = labelRecords[i];
+		ITextLabel* label = labels_ && validString(record.text, header.strings)
+			? labels_->create(getString(strings, header.strings, record.text), record.colour, record.position, record.drawDistance, record.virtualWorld, record.testLOS != 0)
+			: nullptr;
+		if (label == nullptr)
+		{
+			labels.failed++;
+			continue;
+		}
+
+		addRestoredId(labels, restoredIds_[WorldEntityType_Label], record.id, label->getID());
+	}
+
+	labels.nanoseconds = nanosecondsSince(section);
+
+	result.status = WorldLoadStatus_Ok;
+	result.totalNanoseconds = nanosecondsSince(start);
+	return true;
+}
+
+int WorldSnapshot::getRestoredId(WorldEntityType type, int id) const
+{
+	if (type < 0 || type >= WorldEntityType_Count || id < 0)
+	{
+		return -1;
+	}
+
+	const std::vector<int>& ids = restoredIds_[type];
+	return static_cast<size_t>(id) < ids.size() ? ids[id] : -1;
+}
+
+void WorldSnapshot::getStats(WorldSnapshotStats& stats) const
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+	stats = stats_;
+}
+
+void WorldSnapshot::tick(TimePoint now)
+{
+	if (interval_.count() <= 0 || now < next_ || !worker_.joinable())
+	{
+		return;
+	}
+
+	next_ = now + interval_;
+	save();
+}
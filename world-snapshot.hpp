@@ -0,0 +1,233 @@
+#pragma once
+
+#include <sdk.hpp>
+#include <Server/Components/Objects/objects.hpp>
+#include <Server/Components/TextLabels/textlabels.hpp>
+#include <Server/Components/Vehicles/vehicles.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "world-loader.hpp"
+
+using namespace Impl;
+
+//
+// world snapshot file: a WorldSnapshotHeader followed by the vehicle, object, material and label records and a block
+// of UTF-8 strings referenced by the records. the file is written and read by the same build of the component, so the
+// records are stored in native byte order; the version is increased whenever a record changes.
+//
+
+constexpr uint32_t WORLD_SNAPSHOT_MAGIC = 0x53575353; // "SSWS"
+constexpr uint16_t WORLD_SNAPSHOT_VERSION = 1;
+constexpr size_t WORLD_SNAPSHOT_COMPONENT_SLOTS = 14;
+constexpr size_t WORLD_SNAPSHOT_MATERIAL_SLOTS = 16;
+
+struct WorldSnapshotHeader
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t reserved;
+	/// system time at which the snapshot was captured, in nanoseconds since the epoch
+	int64_t created;
+	uint32_t vehicles;
+	uint32_t objects;
+	uint32_t materials;
+	uint32_t labels;
+	/// size of the string block in bytes
+	uint32_t strings;
+	uint32_t reserved2;
+};
+
+struct WorldSnapshotVehicle
+{
+	/// ID at the time of the snapshot
+	int32_t id;
+	int32_t model;
+	Vector3 spawnPosition;
+	float spawnAngle;
+	int32_t spawnColour1;
+	int32_t spawnColour2;
+	int32_t respawnDelay;
+	Vector3 position;
+	float angle;
+	float health;
+	int32_t colour1;
+	int32_t colour2;
+	int32_t paintJob;
+	int32_t virtualWorld;
+	int32_t interior;
+	int32_t panels;
+	int32_t doors;
+	int32_t lights;
+	int32_t tyres;
+	int32_t components[WORLD_SNAPSHOT_COMPONENT_SLOTS];
+	WorldString plate;
+	uint8_t siren;
+	uint8_t reserved[3];
+};
+
+struct WorldSnapshotObject
+{
+	/// ID at the time of the snapshot
+	int32_t id;
+	int32_t model;
+	Vector3 position;
+	Vector3 rotation;
+	float drawDistance;
+	int32_t virtualWorld;
+	/// movement which was in progress; the object continues to the target from its position at the snapshot
+	Vector3 targetPosition;
+	Vector3 targetRotation;
+	float speed;
+	uint8_t moving;
+	uint8_t reserved[3];
+};
+
+struct WorldSnapshotMaterial
+{
+	/// index of the object record
+	uint32_t object;
+	uint32_t slot;
+	/// ObjectMaterialData::Type
+	uint8_t type;
+	uint8_t materialSize;
+	uint8_t fontSize;
+	uint8_t alignment;
+	uint8_t bold;
+	uint8_t reserved[3];
+	int32_t model;
+	Colour materialColour;
+	Colour backgroundColour;
+	/// texture library and name of a material, or text and font face of a material text
+	WorldString textOrTXD;
+	WorldString fontOrTexture;
+};
+
+struct WorldSnapshotLabel
+{
+	/// ID at the time of the snapshot
+	int32_t id;
+	WorldString text;
+	Colour colour;
+	Vector3 position;
+	float drawDistance;
+	int32_t virtualWorld;
+	uint8_t testLOS;
+	uint8_t reserved[3];
+};
+
+/// statistics of the world snapshot. layout is shared with the managed WorldSnapshotStats struct
+struct WorldSnapshotStats
+{
+	uint64_t snapshots;
+	/// snapshots which could not be written
+	uint64_t failed;
+	/// snapshots which were not taken because the previous snapshot was still being written
+	uint64_t skipped;
+	/// size of the last written snapshot in bytes
+	uint64_t bytes;
+	/// time spent copying the state on the server thread for the last snapshot
+	uint64_t captureNanoseconds;
+	/// time spent writing the last snapshot on the background thread
+	uint64_t writeNanoseconds;
+	uint32_t vehicles;
+	uint32_t objects;
+	uint32_t materials;
+	uint32_t labels;
+};
+
+/// periodic binary snapshot of the dynamic world (vehicles with their mods, paint and damage, objects with their
+/// movement and materials, and text labels) for crash recovery and quick restarts. the state is copied into buffers on
+/// the server thread and written by a background thread into a memory-mapped file, which replaces the previous snapshot
+/// once it is complete. a snapshot is restored in one native pass; the IDs of the restored entities are mapped from the
+/// IDs at the time of the snapshot. attachments of objects and labels are not part of the snapshot.
+class WorldSnapshot final
+{
+private:
+	struct Snapshot
+	{
+		int64_t created = 0;
+		std::vector<WorldSnapshotVehicle> vehicles;
+		std::vector<WorldSnapshotObject> objects;
+		std::vector<WorldSnapshotMaterial> materials;
+		std::vector<WorldSnapshotLabel> labels;
+		std::string strings;
+
+		WorldString addString(StringView string);
+
+		void clear();
+	};
+
+	IObjectsComponent* objects_ = nullptr;
+	IVehiclesComponent* vehicles_ = nullptr;
+	ITextLabelsComponent* labels_ = nullptr;
+
+	std::string path_;
+	Seconds interval_ { 0 };
+	TimePoint next_ {};
+
+	/// state copied on the server thread
+	Snapshot capture_;
+	/// state being written by the background thread
+	Snapshot job_;
+	bool pending_ = false;
+	bool busy_ = false;
+	bool running_ = false;
+	std::thread worker_;
+	mutable std::mutex mutex_;
+	std::condition_variable wake_;
+	WorldSnapshotStats stats_ {};
+
+	/// new IDs of the entities of the last restore indexed by the ID at the time of the snapshot
+	std::vector<int> restoredIds_[WorldEntityType_Count];
+
+	void capture();
+
+	void run();
+
+	bool write(const Snapshot& snapshot, size_t& bytes);
+
+public:
+	WorldSnapshot() = default;
+
+	WorldSnapshot(const WorldSnapshot&) = delete;
+	WorldSnapshot& operator=(const WorldSnapshot&) = delete;
+
+	~WorldSnapshot();
+
+	void attach(IComponentList* components);
+
+	void onFree(IComponent* component);
+
+	void detach();
+
+	/// starts the background thread which writes snapshots to the file at path. if the interval is not zero a snapshot
+	/// is taken every interval seconds. returns false if the snapshot is running or the path is empty
+	bool start(StringView path, uint32_t interval);
+
+	/// stops the background thread after writing the pending snapshot
+	void stop();
+
+	bool isRunning() const;
+
+	/// copies the state and queues it for writing. returns false if the snapshot is not running or the previous
+	/// snapshot is still being written
+	bool save();
+
+	/// creates the entities of the snapshot at path. the status and ranges of the result are those of the world loader;
+	/// the pickup range is not used
+	bool restore(StringView path, WorldLoadResult& result);
+
+	/// ID of the entity restored from the entity with the ID at the time of the snapshot, or -1
+	int getRestoredId(WorldEntityType type, int id) const;
+
+	void getStats(WorldSnapshotStats& stats) const;
+
+	/// takes a snapshot when the interval elapsed. must be called from the tick of the component
+	void tick(TimePoint now);
+};